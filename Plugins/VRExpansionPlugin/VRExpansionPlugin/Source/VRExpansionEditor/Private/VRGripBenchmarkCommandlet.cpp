@@ -0,0 +1,577 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "VRGripBenchmarkCommandlet.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRGripBenchmarkCommandlet)
+
+#include "GripMotionControllerComponent.h"
+#include "Grippables/GrippableStaticMeshActor.h"
+#include "GripScripts/VRGripScriptBase.h"
+#include "Misc/VRGripUpdateSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY(LogVRGripBenchmark);
+
+namespace VRGripBenchmark
+{
+	// Counts every allocation made through GMalloc while it is installed, the counts include all threads
+	class FCountingMalloc : public FMalloc
+	{
+	public:
+		FCountingMalloc(FMalloc* InMalloc) :
+			UsedMalloc(InMalloc),
+			NumAllocations(0)
+		{}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			return UsedMalloc->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			return UsedMalloc->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { UsedMalloc->Free(Original); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return UsedMalloc->GetAllocationSize(Original, SizeOut); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return UsedMalloc->QuantizeSize(Count, Alignment); }
+		virtual void Trim(bool bTrimThreadCaches) override { UsedMalloc->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { UsedMalloc->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { UsedMalloc->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { UsedMalloc->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { UsedMalloc->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { UsedMalloc->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return UsedMalloc->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return UsedMalloc->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return UsedMalloc->GetDescriptiveName(); }
+
+		uint64 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+
+		FMalloc* UsedMalloc;
+
+	private:
+		std::atomic<uint64> NumAllocations;
+	};
+
+	// Never deleted, other threads can still be inside of it after GMalloc is restored
+	static FCountingMalloc* CountingMalloc = nullptr;
+
+	static uint64 GetNumAllocations()
+	{
+		return CountingMalloc ? CountingMalloc->GetNumAllocations() : 0;
+	}
+
+	static double GetPercentile(const TArray<double>& SortedSamples, double Percentile)
+	{
+		if (!SortedSamples.Num())
+			return 0.0;
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+		return SortedSamples[Index];
+	}
+
+	enum EPhase
+	{
+		Phase_Poses,
+		Phase_Controllers,
+		Phase_World,
+		Phase_Frame,
+		Phase_Count
+	};
+
+	static const TCHAR* PhaseNames[Phase_Count] = { TEXT("Poses"), TEXT("Controllers"), TEXT("World"), TEXT("Frame") };
+}
+
+UVRGripBenchmarkCommandlet::UVRGripBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+bool UVRGripBenchmarkCommandlet::ParseSettings(const FString& Params, FBenchmarkSettings& OutSettings) const
+{
+	OutSettings.NumPawns = 8;
+	OutSettings.GripsPerHand = 2;
+	OutSettings.NumFrames = 900;
+	OutSettings.NumWarmupFrames = 90;
+	OutSettings.MaxRegression = 0.1f;
+
+	float FPS = 90.0f;
+
+	FParse::Value(*Params, TEXT("Pawns="), OutSettings.NumPawns);
+	FParse::Value(*Params, TEXT("GripsPerHand="), OutSettings.GripsPerHand);
+	FParse::Value(*Params, TEXT("Frames="), OutSettings.NumFrames);
+	FParse::Value(*Params, TEXT("WarmupFrames="), OutSettings.NumWarmupFrames);
+	FParse::Value(*Params, TEXT("FPS="), FPS);
+	FParse::Value(*Params, TEXT("MaxRegression="), OutSettings.MaxRegression);
+	FParse::Value(*Params, TEXT("Baseline="), OutSettings.BaselinePath);
+	OutSettings.bBatched = FParse::Param(*Params, TEXT("Batched"));
+
+	OutSettings.NumPawns = FMath::Max(OutSettings.NumPawns, 1);
+	OutSettings.GripsPerHand = FMath::Max(OutSettings.GripsPerHand, 0);
+	OutSettings.NumFrames = FMath::Max(OutSettings.NumFrames, 1);
+	OutSettings.NumWarmupFrames = FMath::Max(OutSettings.NumWarmupFrames, 0);
+	OutSettings.DeltaTime = 1.0f / FMath::Max(FPS, 1.0f);
+
+	if (!FParse::Value(*Params, TEXT("Output="), OutSettings.OutputPath))
+	{
+		OutSettings.OutputPath = FPaths::ProjectSavedDir() / TEXT("VRGripBenchmark") / TEXT("VRGripBenchmark.json");
+	}
+
+	FString GripTypesString = TEXT("InteractiveCollisionWithPhysics,InteractiveCollisionWithSweep,SweepWithPhysics,AttachmentGrip,ManipulationGrip");
+	FParse::Value(*Params, TEXT("GripTypes="), GripTypesString, false);
+
+	TArray<FString> GripTypeNames;
+	GripTypesString.ParseIntoArray(GripTypeNames, TEXT(","));
+
+	const UEnum* GripTypeEnum = StaticEnum<EGripCollisionType>();
+	for (const FString& GripTypeName : GripTypeNames)
+	{
+		const int64 Value = GripTypeEnum->GetValueByNameString(GripTypeName.TrimStartAndEnd());
+		if (Value == INDEX_NONE)
+		{
+			UE_LOGF(LogVRGripBenchmark, Error, "Unknown grip type %ls", *GripTypeName);
+			return false;
+		}
+
+		OutSettings.GripTypes.Add((EGripCollisionType)Value);
+	}
+
+	if (!OutSettings.GripTypes.Num())
+	{
+		UE_LOGF(LogVRGripBenchmark, Error, "No grip types to benchmark");
+		return false;
+	}
+
+	FString ScriptsString;
+	if (FParse::Value(*Params, TEXT("Scripts="), ScriptsString, false))
+	{
+		TArray<FString> ScriptNames;
+		ScriptsString.ParseIntoArray(ScriptNames, TEXT(","));
+
+		for (const FString& ScriptName : ScriptNames)
+		{
+			UClass* ScriptClass = FindFirstObject<UClass>(*ScriptName.TrimStartAndEnd(), EFindFirstObjectOptions::NativeFirst);
+			if (!ScriptClass || !ScriptClass->IsChildOf(UVRGripScriptBase::StaticClass()) || ScriptClass->HasAnyClassFlags(CLASS_Abstract))
+			{
+				UE_LOGF(LogVRGripBenchmark, Error, "Unknown grip script class %ls", *ScriptName);
+				return false;
+			}
+
+			OutSettings.ScriptClasses.Add(ScriptClass);
+		}
+	}
+
+	return true;
+}
+
+UWorld* UVRGripBenchmarkCommandlet::CreateBenchmarkWorld() const
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, FName(TEXT("VRGripBenchmark")));
+	if (!World)
+		return nullptr;
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// There is no game mode to start play for us
+	if (!World->GetBegunPlay())
+	{
+		World->GetWorldSettings()->NotifyBeginPlay();
+	}
+
+	return World;
+}
+
+void UVRGripBenchmarkCommandlet::DestroyBenchmarkWorld(UWorld* World) const
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void UVRGripBenchmarkCommandlet::SpawnScene(UWorld* World, const FBenchmarkSettings& Settings, TArray<FBenchmarkHand>& OutHands, int32& OutNumGrips) const
+{
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+	for (int32 PawnIndex = 0; PawnIndex < Settings.NumPawns; ++PawnIndex)
+	{
+		// Spaced out so that the pawns held objects never touch each other
+		const FVector PawnLocation(PawnIndex * 400.0f, 0.0f, 100.0f);
+
+		AActor* Pawn = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(PawnLocation));
+		USceneComponent* PawnRoot = NewObject<USceneComponent>(Pawn, TEXT("PawnRoot"));
+		PawnRoot->SetMobility(EComponentMobility::Movable);
+		Pawn->SetRootComponent(PawnRoot);
+		PawnRoot->RegisterComponent();
+		PawnRoot->SetWorldLocation(PawnLocation);
+
+		for (int32 HandIndex = 0; HandIndex < 2; ++HandIndex)
+		{
+			UGripMotionControllerComponent* Controller = NewObject<UGripMotionControllerComponent>(Pawn, HandIndex ? TEXT("RightController") : TEXT("LeftController"));
+			Controller->bUseWithoutTracking = true;
+			Controller->bDisableLowLatencyUpdate = true;
+			Controller->bOffsetByControllerProfile = false;
+			Controller->SetupAttachment(PawnRoot);
+			Controller->RegisterComponent();
+
+			// Ticked by hand so that the controller phase can be timed on its own
+			Controller->SetComponentTickEnabled(false);
+
+			FBenchmarkHand& Hand = OutHands.AddDefaulted_GetRef();
+			Hand.Controller = Controller;
+			Hand.Center = FVector(40.0f, HandIndex ? 25.0f : -25.0f, 0.0f);
+			Hand.Phase = PawnIndex * 0.7f + HandIndex * PI;
+		}
+	}
+
+	// One tick to pick up authority and place the controllers before gripping
+	ApplyScriptedPoses(OutHands, 0.0f);
+	for (FBenchmarkHand& Hand : OutHands)
+	{
+		Hand.Controller->TickComponent(Settings.DeltaTime, LEVELTICK_All, &Hand.Controller->PrimaryComponentTick);
+	}
+
+	OutNumGrips = 0;
+	for (FBenchmarkHand& Hand : OutHands)
+	{
+		for (int32 GripIndex = 0; GripIndex < Settings.GripsPerHand; ++GripIndex)
+		{
+			const EGripCollisionType GripType = Settings.GripTypes[OutNumGrips % Settings.GripTypes.Num()];
+			const FTransform SpawnTransform(
+				FQuat::Identity,
+				Hand.Controller->GetComponentLocation() + Hand.Controller->GetForwardVector() * (10.0f + GripIndex * 15.0f),
+				FVector(0.1f));
+
+			AGrippableStaticMeshActor* Grippable = World->SpawnActorDeferred<AGrippableStaticMeshActor>(AGrippableStaticMeshActor::StaticClass(), SpawnTransform);
+			UStaticMeshComponent* MeshComponent = Grippable->GetStaticMeshComponent();
+			MeshComponent->SetMobility(EComponentMobility::Movable);
+			MeshComponent->SetStaticMesh(CubeMesh);
+			MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+			FBPInterfaceProperties& GripSettings = Grippable->GetVRGripInterfaceSettings(true);
+			GripSettings.FreeDefaultGripType = GripType;
+			GripSettings.SlotDefaultGripType = GripType;
+			GripSettings.bSimulateOnDrop = false;
+
+			for (const TSubclassOf<UVRGripScriptBase>& ScriptClass : Settings.ScriptClasses)
+			{
+				Grippable->GetGripLogicScripts().Add(NewObject<UVRGripScriptBase>(Grippable, ScriptClass));
+			}
+
+			Grippable->FinishSpawning(SpawnTransform);
+
+			if (Hand.Controller->GripObjectByInterface(Grippable, Grippable->GetActorTransform()))
+			{
+				++OutNumGrips;
+			}
+			else
+			{
+				UE_LOGF(LogVRGripBenchmark, Warning, "Failed to grip %ls with grip type %ls", *Grippable->GetName(), *StaticEnum<EGripCollisionType>()->GetNameStringByValue((int64)GripType));
+			}
+		}
+	}
+}
+
+void UVRGripBenchmarkCommandlet::ApplyScriptedPoses(TArray<FBenchmarkHand>& Hands, float Time) const
+{
+	// Hands sweep around in front of the pawn, fast enough to keep sweeps and physics handles busy
+	for (FBenchmarkHand& Hand : Hands)
+	{
+		const float Angle = Time * 3.0f + Hand.Phase;
+		const FVector Offset(FMath::Cos(Angle) * 20.0f, FMath::Sin(Angle) * 20.0f, FMath::Sin(Angle * 2.0f) * 10.0f);
+		const FRotator Rotation(FMath::Sin(Angle) * 30.0f, FMath::RadiansToDegrees(Angle) * 0.5f, FMath::Cos(Angle) * 20.0f);
+
+		Hand.Controller->SetRelativeTransform(FTransform(Rotation, Hand.Center + Offset));
+	}
+}
+
+int32 UVRGripBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace VRGripBenchmark;
+
+	FBenchmarkSettings Settings;
+	if (!ParseSettings(Params, Settings))
+		return 1;
+
+	IConsoleVariable* BatchedCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("vr.BatchedGripUpdates"));
+	const int32 OriginalBatched = BatchedCVar ? BatchedCVar->GetInt() : 0;
+	if (BatchedCVar)
+	{
+		BatchedCVar->Set(Settings.bBatched ? 1 : 0, ECVF_SetByCommandline);
+	}
+
+	UWorld* World = CreateBenchmarkWorld();
+	if (!World)
+	{
+		UE_LOGF(LogVRGripBenchmark, Error, "Failed to create the benchmark world");
+		return 1;
+	}
+
+	FApp::SetFixedDeltaTime(Settings.DeltaTime);
+	FApp::SetUseFixedTimeStep(true);
+
+	TArray<FBenchmarkHand> Hands;
+	int32 NumGrips = 0;
+	SpawnScene(World, Settings, Hands, NumGrips);
+
+	UVRGripUpdateSubsystem* GripUpdateSubsystem = World->GetSubsystem<UVRGripUpdateSubsystem>();
+
+	UE_LOGF(LogVRGripBenchmark, Display, "Running %d frames (%d warmup) with %d controllers and %d grips%ls",
+		Settings.NumFrames, Settings.NumWarmupFrames, Hands.Num(), NumGrips, Settings.bBatched ? TEXT(" (batched)") : TEXT(""));
+
+	TArray<FBenchmarkPhase> Phases;
+	for (int32 PhaseIndex = 0; PhaseIndex < Phase_Count; ++PhaseIndex)
+	{
+		FBenchmarkPhase& Phase = Phases.AddDefaulted_GetRef();
+		Phase.Name = PhaseNames[PhaseIndex];
+		Phase.Samples.Reserve(Settings.NumFrames);
+		Phase.Allocations.Reserve(Settings.NumFrames);
+	}
+
+	if (!FParse::Param(*Params, TEXT("NoAllocationCounting")))
+	{
+		if (!CountingMalloc)
+		{
+			CountingMalloc = new FCountingMalloc(GMalloc);
+		}
+
+		CountingMalloc->UsedMalloc = GMalloc;
+		GMalloc = CountingMalloc;
+	}
+
+	int64 MemoryAtStart = 0;
+	float Time = 0.0f;
+
+	for (int32 Frame = 0; Frame < Settings.NumWarmupFrames + Settings.NumFrames; ++Frame)
+	{
+		const bool bRecord = Frame >= Settings.NumWarmupFrames;
+		if (Frame == Settings.NumWarmupFrames)
+		{
+			MemoryAtStart = (int64)FPlatformMemory::GetStats().UsedPhysical;
+		}
+
+		double PhaseTimes[Phase_Count];
+		uint64 PhaseAllocations[Phase_Count];
+
+		const uint64 FrameStartCycles = FPlatformTime::Cycles64();
+		const uint64 FrameStartAllocations = GetNumAllocations();
+		uint64 PhaseStartCycles = FrameStartCycles;
+		uint64 PhaseStartAllocations = FrameStartAllocations;
+
+		auto EndPhase = [&](int32 PhaseIndex)
+		{
+			const uint64 Cycles = FPlatformTime::Cycles64();
+			const uint64 Allocations = GetNumAllocations();
+			PhaseTimes[PhaseIndex] = FPlatformTime::ToMilliseconds64(Cycles - PhaseStartCycles);
+			PhaseAllocations[PhaseIndex] = Allocations - PhaseStartAllocations;
+			PhaseStartCycles = Cycles;
+			PhaseStartAllocations = Allocations;
+		};
+
+		Time += Settings.DeltaTime;
+		ApplyScriptedPoses(Hands, Time);
+		EndPhase(Phase_Poses);
+
+		for (FBenchmarkHand& Hand : Hands)
+		{
+			Hand.Controller->TickComponent(Settings.DeltaTime, LEVELTICK_All, &Hand.Controller->PrimaryComponentTick);
+		}
+
+		// The controllers queued themselves if batching is on, flush it here so that it counts towards the controllers
+		if (GripUpdateSubsystem)
+		{
+			GripUpdateSubsystem->UpdateQueuedGrips();
+		}
+		EndPhase(Phase_Controllers);
+
+		World->Tick(LEVELTICK_All, Settings.DeltaTime);
+		++GFrameCounter;
+		EndPhase(Phase_World);
+
+		PhaseTimes[Phase_Frame] = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - FrameStartCycles);
+		PhaseAllocations[Phase_Frame] = GetNumAllocations() - FrameStartAllocations;
+
+		if (bRecord)
+		{
+			for (int32 PhaseIndex = 0; PhaseIndex < Phase_Count; ++PhaseIndex)
+			{
+				Phases[PhaseIndex].Samples.Add(PhaseTimes[PhaseIndex]);
+				Phases[PhaseIndex].Allocations.Add(PhaseAllocations[PhaseIndex]);
+			}
+		}
+	}
+
+	const int64 MemoryDelta = (int64)FPlatformMemory::GetStats().UsedPhysical - MemoryAtStart;
+
+	if (CountingMalloc && GMalloc == CountingMalloc)
+	{
+		GMalloc = CountingMalloc->UsedMalloc;
+	}
+
+	FApp::SetUseFixedTimeStep(false);
+	DestroyBenchmarkWorld(World);
+
+	if (BatchedCVar)
+	{
+		BatchedCVar->Set(OriginalBatched, ECVF_SetByCommandline);
+	}
+
+	const FString Report = BuildReport(Settings, Phases, NumGrips, MemoryDelta);
+	if (!FFileHelper::SaveStringToFile(Report, *Settings.OutputPath))
+	{
+		UE_LOGF(LogVRGripBenchmark, Error, "Failed to write the benchmark report to %ls", *Settings.OutputPath);
+		return 1;
+	}
+
+	UE_LOGF(LogVRGripBenchmark, Display, "Wrote the benchmark report to %ls", *Settings.OutputPath);
+
+	return CheckBaseline(Settings, Phases) ? 0 : 1;
+}
+
+FString UVRGripBenchmarkCommandlet::BuildReport(const FBenchmarkSettings& Settings, const TArray<FBenchmarkPhase>& Phases, int32 NumGrips, int64 MemoryDelta) const
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("Benchmark"), TEXT("VRGripBenchmark"));
+	Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+
+	TSharedRef<FJsonObject> SettingsObject = MakeShared<FJsonObject>();
+	SettingsObject->SetNumberField(TEXT("Pawns"), Settings.NumPawns);
+	SettingsObject->SetNumberField(TEXT("GripsPerHand"), Settings.GripsPerHand);
+	SettingsObject->SetNumberField(TEXT("Frames"), Settings.NumFrames);
+	SettingsObject->SetNumberField(TEXT("WarmupFrames"), Settings.NumWarmupFrames);
+	SettingsObject->SetNumberField(TEXT("DeltaTime"), Settings.DeltaTime);
+	SettingsObject->SetBoolField(TEXT("Batched"), Settings.bBatched);
+
+	TArray<TSharedPtr<FJsonValue>> GripTypeValues;
+	for (EGripCollisionType GripType : Settings.GripTypes)
+	{
+		GripTypeValues.Add(MakeShared<FJsonValueString>(StaticEnum<EGripCollisionType>()->GetNameStringByValue((int64)GripType)));
+	}
+	SettingsObject->SetArrayField(TEXT("GripTypes"), GripTypeValues);
+
+	TArray<TSharedPtr<FJsonValue>> ScriptValues;
+	for (const TSubclassOf<UVRGripScriptBase>& ScriptClass : Settings.ScriptClasses)
+	{
+		ScriptValues.Add(MakeShared<FJsonValueString>(ScriptClass->GetName()));
+	}
+	SettingsObject->SetArrayField(TEXT("Scripts"), ScriptValues);
+
+	Root->SetObjectField(TEXT("Settings"), SettingsObject);
+	Root->SetNumberField(TEXT("Grips"), NumGrips);
+	Root->SetNumberField(TEXT("MemoryDeltaBytes"), (double)MemoryDelta);
+
+	TArray<TSharedPtr<FJsonValue>> PhaseValues;
+	for (const FBenchmarkPhase& Phase : Phases)
+	{
+		TArray<double> Sorted = Phase.Samples;
+		Sorted.Sort();
+
+		double Total = 0.0;
+		for (double Sample : Sorted)
+		{
+			Total += Sample;
+		}
+
+		uint64 TotalAllocations = 0;
+		for (uint64 Allocations : Phase.Allocations)
+		{
+			TotalAllocations += Allocations;
+		}
+
+		const int32 NumSamples = FMath::Max(Sorted.Num(), 1);
+
+		TSharedRef<FJsonObject> PhaseObject = MakeShared<FJsonObject>();
+		PhaseObject->SetStringField(TEXT("Name"), Phase.Name);
+		PhaseObject->SetNumberField(TEXT("MeanMs"), Total / NumSamples);
+		PhaseObject->SetNumberField(TEXT("MinMs"), Sorted.Num() ? Sorted[0] : 0.0);
+		PhaseObject->SetNumberField(TEXT("MaxMs"), Sorted.Num() ? Sorted.Last() : 0.0);
+		PhaseObject->SetNumberField(TEXT("P50Ms"), VRGripBenchmark::GetPercentile(Sorted, 0.5));
+		PhaseObject->SetNumberField(TEXT("P95Ms"), VRGripBenchmark::GetPercentile(Sorted, 0.95));
+		PhaseObject->SetNumberField(TEXT("P99Ms"), VRGripBenchmark::GetPercentile(Sorted, 0.99));
+		PhaseObject->SetNumberField(TEXT("AllocationsPerFrame"), (double)TotalAllocations / NumSamples);
+		PhaseValues.Add(MakeShared<FJsonValueObject>(PhaseObject));
+
+		UE_LOGF(LogVRGripBenchmark, Display, "%-12ls mean %.4fms p95 %.4fms p99 %.4fms allocs/frame %.1f",
+			*Phase.Name, Total / NumSamples, VRGripBenchmark::GetPercentile(Sorted, 0.95), VRGripBenchmark::GetPercentile(Sorted, 0.99), (double)TotalAllocations / NumSamples);
+	}
+	Root->SetArrayField(TEXT("Phases"), PhaseValues);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+	return Output;
+}
+
+bool UVRGripBenchmarkCommandlet::CheckBaseline(const FBenchmarkSettings& Settings, const TArray<FBenchmarkPhase>& Phases) const
+{
+	if (Settings.BaselinePath.IsEmpty())
+		return true;
+
+	FString BaselineString;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FFileHelper::LoadFileToString(BaselineString, *Settings.BaselinePath) ||
+		!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineString), Baseline) || !Baseline.IsValid())
+	{
+		UE_LOGF(LogVRGripBenchmark, Error, "Failed to read the baseline report %ls", *Settings.BaselinePath);
+		return false;
+	}
+
+	bool bPassed = true;
+	const TArray<TSharedPtr<FJsonValue>>* BaselinePhases = nullptr;
+	if (Baseline->TryGetArrayField(TEXT("Phases"), BaselinePhases))
+	{
+		for (const TSharedPtr<FJsonValue>& BaselinePhaseValue : *BaselinePhases)
+		{
+			const TSharedPtr<FJsonObject>* BaselinePhase = nullptr;
+			FString Name;
+			double BaselineMean = 0.0;
+			if (!BaselinePhaseValue->TryGetObject(BaselinePhase) || !(*BaselinePhase)->TryGetStringField(TEXT("Name"), Name) || !(*BaselinePhase)->TryGetNumberField(TEXT("MeanMs"), BaselineMean))
+				continue;
+
+			const FBenchmarkPhase* Phase = Phases.FindByPredicate([&Name](const FBenchmarkPhase& Other) { return Other.Name == Name; });
+			if (!Phase || !Phase->Samples.Num())
+				continue;
+
+			double Total = 0.0;
+			for (double Sample : Phase->Samples)
+			{
+				Total += Sample;
+			}
+
+			const double Mean = Total / Phase->Samples.Num();
+			if (BaselineMean > 0.0 && Mean > BaselineMean * (1.0 + Settings.MaxRegression))
+			{
+				UE_LOGF(LogVRGripBenchmark, Error, "Phase %ls regressed, mean %.4fms against a baseline of %.4fms", *Name, Mean, BaselineMean);
+				bPassed = false;
+			}
+		}
+	}
+
+	return bPassed;
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "VRBPDatatypes.h"
+
+#include "VRGripBenchmarkCommandlet.generated.h"
+
+class UWorld;
+class UGripMotionControllerComponent;
+class UVRGripScriptBase;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogVRGripBenchmark, Log, All);
+
+/**
+* Headless benchmark of the grip pipeline, runs without a GPU (-nullrhi) so that it can gate plugin upgrades on a build box.
+* Spawns synthetic pawns with two scripted grip motion controllers each, grips a mix of grippable static mesh actors with them
+* and steps a game world at a fixed delta time, then writes the per phase timings and allocation counts out as JSON.
+*
+* UnrealEditor-Cmd <Project> -run=VRGripBenchmark -nullrhi -unattended
+*	-Pawns=8 -GripsPerHand=2 -Frames=900 -WarmupFrames=90 -FPS=90
+*	-GripTypes=InteractiveCollisionWithPhysics,AttachmentGrip,ManipulationGrip (EGripCollisionType names, assigned round robin)
+*	-Scripts=GS_LerpToHand (extra grip script classes added to every gripped object)
+*	-Batched (runs with vr.BatchedGripUpdates on) -NoAllocationCounting (skips swapping GMalloc for a counting proxy)
+*	-Output=<json path> (defaults to Saved/VRGripBenchmark/VRGripBenchmark.json)
+*	-Baseline=<json path> -MaxRegression=0.1 (returns an error if a phase mean is more than 10% slower than the baseline)
+*/
+UCLASS()
+class UVRGripBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UVRGripBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	struct FBenchmarkSettings
+	{
+		int32 NumPawns;
+		int32 GripsPerHand;
+		int32 NumFrames;
+		int32 NumWarmupFrames;
+		float DeltaTime;
+		bool bBatched;
+		TArray<EGripCollisionType> GripTypes;
+		TArray<TSubclassOf<UVRGripScriptBase>> ScriptClasses;
+		FString OutputPath;
+		FString BaselinePath;
+		float MaxRegression;
+	};
+
+	struct FBenchmarkPhase
+	{
+		FString Name;
+		TArray<double> Samples;
+		TArray<uint64> Allocations;
+	};
+
+	struct FBenchmarkHand
+	{
+		UGripMotionControllerComponent* Controller;
+		FVector Center;
+		float Phase;
+	};
+
+	bool ParseSettings(const FString& Params, FBenchmarkSettings& OutSettings) const;
+	UWorld* CreateBenchmarkWorld() const;
+	void DestroyBenchmarkWorld(UWorld* World) const;
+	void SpawnScene(UWorld* World, const FBenchmarkSettings& Settings, TArray<FBenchmarkHand>& OutHands, int32& OutNumGrips) const;
+	void ApplyScriptedPoses(TArray<FBenchmarkHand>& Hands, float Time) const;
+	FString BuildReport(const FBenchmarkSettings& Settings, const TArray<FBenchmarkPhase>& Phases, int32 NumGrips, int64 MemoryDelta) const;
+	bool CheckBaseline(const FBenchmarkSettings& Settings, const TArray<FBenchmarkPhase>& Phases) const;
+};
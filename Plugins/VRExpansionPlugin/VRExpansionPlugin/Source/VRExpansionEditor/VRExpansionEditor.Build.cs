@@ -47,7 +47,8 @@ namespace UnrealBuildTool.Rules
                     "Engine",
                     "UnrealEd",
                     "EditorStyle",
-					"AssetRegistry"
+					"AssetRegistry",
+					"Json"
 				}
 				);
 
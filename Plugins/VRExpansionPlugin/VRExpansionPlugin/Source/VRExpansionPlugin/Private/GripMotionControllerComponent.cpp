@@ -55,6 +55,7 @@
 #include "Chaos/PhysicsObjectInterface.h"
 
 #include "Misc/CollisionIgnoreSubsystem.h"
+#include "Misc/VRGripUpdateSubsystem.h"
 
 #include "Features/IModularFeatures.h"
 
@@ -63,9 +64,35 @@
 #endif
 
 DEFINE_LOG_CATEGORY(LogVRMotionController);
+UE_TRACE_CHANNEL_DEFINE(VRGripChannel);
 //For UE4 Profiler ~ Stat
 DECLARE_CYCLE_STAT(TEXT("TickGrip ~ TickingGrip"), STAT_TickGrip, STATGROUP_TickGrip);
 DECLARE_CYCLE_STAT(TEXT("GetGripWorldTransform ~ GettingTransform"), STAT_GetGripTransform, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("TickGrip ~ HandleGripArray"), STAT_HandleGripArray, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Physics / Locked Constraint"), STAT_GripType_Physics, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Interactive Sweep"), STAT_GripType_Sweep, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Hybrid Physics"), STAT_GripType_HybridPhysics, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Hybrid Sweep"), STAT_GripType_HybridSweep, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Sweep With Physics"), STAT_GripType_SweepWithPhysics, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Physics Only"), STAT_GripType_PhysicsOnly, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Attachment"), STAT_GripType_Attachment, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Manipulation"), STAT_GripType_Manipulation, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("GripType ~ Custom"), STAT_GripType_Custom, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("PhysicsHandle ~ SetUp"), STAT_SetUpPhysicsHandle, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("PhysicsHandle ~ Update"), STAT_UpdatePhysicsHandle, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("PhysicsHandle ~ Update Transform"), STAT_UpdatePhysicsHandleTransform, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("PhysicsHandle ~ Destroy"), STAT_DestroyPhysicsHandle, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("Sweep ~ CheckComponentWithSweep"), STAT_CheckComponentWithSweep, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("Teleport ~ TeleportMoveGrips"), STAT_TeleportMoveGrips, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("Teleport ~ TeleportMoveGrip"), STAT_TeleportMoveGrip, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("LateUpdate ~ Gather Primitives"), STAT_LateUpdateGather, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TickGrip ~ Grips Processed"), STAT_GripsProcessed, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TickGrip ~ Grip Script Transform Calls"), STAT_GripScriptsInvoked, STATGROUP_TickGrip);
+DEFINE_STAT(STAT_GripArrayReplication);
+DEFINE_STAT(STAT_GripsReplicated);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GripLookup ~ Table Rebuilds"), STAT_GripLookupRebuilds, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GripScriptCache ~ Refreshes"), STAT_GripScriptCacheRefreshes, STATGROUP_TickGrip);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LateUpdate ~ Hierarchy Gathers"), STAT_LateUpdateGathers, STATGROUP_TickGrip);
 
 // MAGIC NUMBERS
 // Constraint multipliers for angular, to avoid having to have two sets of stiffness/damping variables
@@ -142,6 +169,14 @@ namespace GripMotionControllerCvars
 		TEXT("When on, will draw debug speheres for physics grips COM.\n")
 		TEXT("0: Disable, 1: Enable"),
 		ECVF_Default);
+
+	static int32 LateUpdateRegatherInterval = 60;
+	FAutoConsoleVariableRef CVarLateUpdateRegatherInterval(
+		TEXT("vr.LateUpdateRegatherInterval"),
+		LateUpdateRegatherInterval,
+		TEXT("Late update primitive lists are only re-gathered when the attach children change under a gripped object.\n")
+		TEXT("This forces a full re-gather after this many frames anyway as a safety net, 0 re-gathers every frame."),
+		ECVF_Default);
 }
 
   //=============================================================================
@@ -198,8 +233,12 @@ UGripMotionControllerComponent::UGripMotionControllerComponent(const FObjectInit
 	EuroSmoothingParams.CutoffSlope = 10.f;
 
 	bIsPostTeleport = false;
+	BatchedGripDeltaTime = 0.0f;
+	BatchedGripParentTransform = FTransform::Identity;
 
 	GripIDIncrementer = INVALID_VRGRIP_ID;
+	GrippedObjects.Owner = this;
+	LocallyGrippedObjects.Owner = this;
 
 	// Pivot Variables
 	CustomPivotComponentSocketName = NAME_None;
@@ -441,6 +480,16 @@ void UGripMotionControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 	// Cancel end physics tick
 	RegisterEndPhysicsTick(false);
 
+	if (UWorld* World = GetWorld())
+	{
+		if (UVRGripUpdateSubsystem* GripUpdateSubsystem = World->GetSubsystem<UVRGripUpdateSubsystem>())
+		{
+			GripUpdateSubsystem->UnregisterController(this);
+		}
+	}
+
+	BatchedGripJobs.Empty();
+
 	if (NewControllerProfileEvent_Handle.IsValid())
 	{
 		UVRGlobalSettings* VRSettings = GetMutableDefault<UVRGlobalSettings>();
@@ -474,6 +523,7 @@ void UGripMotionControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 		}
 	}
 	GrippedObjects.Empty();
+	GrippedObjectsLookup.MarkDirty();
 
 	for (int i = 0; i < LocallyGrippedObjects.Num(); i++)
 	{
@@ -498,12 +548,15 @@ void UGripMotionControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 		}
 	}
 	LocallyGrippedObjects.Empty();
+	LocallyGrippedObjectsLookup.MarkDirty();
 
 	for (int i = 0; i < PhysicsGrips.Num(); i++)
 	{
 		DestroyPhysicsHandle(&PhysicsGrips[i]);
 	}
 	PhysicsGrips.Empty();
+	PhysicsGripsLookup.MarkDirty();
+	GripScriptCaches.Empty();
 
 	// Clear any timers that we are managing
 	if (UWorld * myWorld = GetWorld())
@@ -539,6 +592,15 @@ void UGripMotionControllerComponent::BeginDestroy()
 void UGripMotionControllerComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Always register so that the batched grip update can be toggled at runtime
+	if (UWorld* World = GetWorld())
+	{
+		if (UVRGripUpdateSubsystem* GripUpdateSubsystem = World->GetSubsystem<UVRGripUpdateSubsystem>())
+		{
+			GripUpdateSubsystem->RegisterController(this);
+		}
+	}
 }
 
 void UGripMotionControllerComponent::CreateRenderState_Concurrent(FRegisterComponentContext* Context)
@@ -625,25 +687,175 @@ void UGripMotionControllerComponent::SendRenderTransform_Concurrent()
 	Super::Super::SendRenderTransform_Concurrent();
 }
 
+template<typename GripType>
+int32 FVRGripLookupTable::FindIndexByID(const TArray<GripType>& Grips, uint8 GripID)
+{
+	if (GripID == INVALID_VRGRIP_ID)
+		return INDEX_NONE;
+
+	if (CachedNum != Grips.Num())
+		Rebuild(Grips);
+
+	const int32* Index = IDToIndex.Find(GripID);
+	if (Index && (!Grips.IsValidIndex(*Index) || Grips[*Index].GripID != GripID))
+	{
+		// Array was re-ordered without us being told, rebuild and try again
+		Rebuild(Grips);
+		Index = IDToIndex.Find(GripID);
+	}
+
+	if (!Index && Grips.Num() > 0)
+	{
+		// A miss can't be trusted if an element was changed in place without marking us dirty, confirm it before returning nothing
+		const int32 ScanIndex = Grips.IndexOfByPredicate([GripID](const GripType& Grip) { return Grip.GripID == GripID; });
+		if (ScanIndex != INDEX_NONE)
+		{
+			Rebuild(Grips);
+		}
+
+		return ScanIndex;
+	}
+
+	return Index ? *Index : INDEX_NONE;
+}
+
+void FVRGripLookupTable::Rebuild(const TArray<FBPActorGripInformation>& Grips)
+{
+	INC_DWORD_STAT(STAT_GripLookupRebuilds);
+
+	IDToIndex.Reset();
+	ObjectToIndex.Reset();
+
+	// Walk backwards so that the first matching grip wins, same as FindByKey did
+	for (int32 i = Grips.Num() - 1; i >= 0; --i)
+	{
+		if (Grips[i].GripID != INVALID_VRGRIP_ID)
+		{
+			IDToIndex.Add(Grips[i].GripID, i);
+		}
+
+		if (Grips[i].GrippedObject)
+		{
+			ObjectToIndex.Add(Grips[i].GrippedObject.Get(), i);
+		}
+	}
+
+	CachedNum = Grips.Num();
+}
+
+void FVRGripLookupTable::Rebuild(const TArray<FBPActorPhysicsHandleInformation>& PhysicsGrips)
+{
+	INC_DWORD_STAT(STAT_GripLookupRebuilds);
+
+	IDToIndex.Reset();
+	ObjectToIndex.Reset();
+
+	for (int32 i = PhysicsGrips.Num() - 1; i >= 0; --i)
+	{
+		if (PhysicsGrips[i].GripID != INVALID_VRGRIP_ID)
+		{
+			IDToIndex.Add(PhysicsGrips[i].GripID, i);
+		}
+	}
+
+	CachedNum = PhysicsGrips.Num();
+}
+
+FBPActorGripInformation* FVRGripLookupTable::FindByKey(TArray<FBPActorGripInformation>& Grips, uint8 GripID)
+{
+	const int32 Index = FindIndexByID(Grips, GripID);
+	return Index != INDEX_NONE ? &Grips[Index] : nullptr;
+}
+
+FBPActorGripInformation* FVRGripLookupTable::FindByKey(TArray<FBPActorGripInformation>& Grips, const UObject* Object)
+{
+	if (!Object)
+		return nullptr;
+
+	if (CachedNum != Grips.Num())
+		Rebuild(Grips);
+
+	const int32* Index = ObjectToIndex.Find(Object);
+	if (Index && (!Grips.IsValidIndex(*Index) || Grips[*Index].GrippedObject != Object))
+	{
+		Rebuild(Grips);
+		Index = ObjectToIndex.Find(Object);
+	}
+
+	if (!Index && Grips.Num() > 0)
+	{
+		// Same as FindIndexByID, confirm the miss before returning nothing
+		const int32 ScanIndex = Grips.IndexOfByPredicate([Object](const FBPActorGripInformation& Grip) { return Grip.GrippedObject == Object; });
+		if (ScanIndex != INDEX_NONE)
+		{
+			Rebuild(Grips);
+		}
+
+		return ScanIndex != INDEX_NONE ? &Grips[ScanIndex] : nullptr;
+	}
+
+	return Index ? &Grips[*Index] : nullptr;
+}
+
+FBPActorPhysicsHandleInformation* FVRGripLookupTable::FindByKey(TArray<FBPActorPhysicsHandleInformation>& PhysicsGrips, uint8 GripID)
+{
+	const int32 Index = FindIndexByID(PhysicsGrips, GripID);
+	return Index != INDEX_NONE ? &PhysicsGrips[Index] : nullptr;
+}
+
+int32 FVRGripLookupTable::IndexOfByKey(const TArray<FBPActorPhysicsHandleInformation>& PhysicsGrips, uint8 GripID)
+{
+	return FindIndexByID(PhysicsGrips, GripID);
+}
+
+TSharedPtr<FVRGripScriptCache> UGripMotionControllerComponent::GetGripScriptCache(const FBPActorGripInformation& Grip, UObject* ScriptOwner)
+{
+	if (!ScriptOwner || Grip.GripID == INVALID_VRGRIP_ID)
+		return nullptr;
+
+	TSharedPtr<FVRGripScriptCache>& ScriptCache = GripScriptCaches.FindOrAdd(Grip.GripID);
+
+	// Scripts can be added to or removed from the owner at any time, so check its current list against the cached one
+	GripScriptScratch.Reset();
+	const bool bHasScripts = IVRGripInterface::Execute_GetGripScripts(ScriptOwner, GripScriptScratch);
+	GripScriptScratch.Remove(nullptr);
+
+	if (!ScriptCache.IsValid() || ScriptCache->ScriptOwner != ScriptOwner || ScriptCache->bHasScripts != bHasScripts || ScriptCache->Scripts != GripScriptScratch)
+	{
+		INC_DWORD_STAT(STAT_GripScriptCacheRefreshes);
+
+		// Always make a new one, someone up the stack may still be iterating the old lists
+		TSharedPtr<FVRGripScriptCache> NewCache = MakeShared<FVRGripScriptCache>();
+
+		NewCache->bHasScripts = bHasScripts;
+		NewCache->Scripts = GripScriptScratch;
+		NewCache->ScriptOwner = ScriptOwner;
+
+		ScriptCache = NewCache;
+	}
+
+	return ScriptCache;
+}
+
 FBPActorPhysicsHandleInformation * UGripMotionControllerComponent::GetPhysicsGrip(const FBPActorGripInformation & GripInfo)
 {
-	return PhysicsGrips.FindByKey(GripInfo);
+	return PhysicsGripsLookup.FindByKey(PhysicsGrips, GripInfo.GripID);
 }
 
 FBPActorPhysicsHandleInformation* UGripMotionControllerComponent::GetPhysicsGrip(const uint8 GripID)
 {
-	return PhysicsGrips.FindByKey(GripID);
+	return PhysicsGripsLookup.FindByKey(PhysicsGrips, GripID);
 }
 
 bool UGripMotionControllerComponent::GetPhysicsGripIndex(const FBPActorGripInformation & GripInfo, int & index)
 {
-	index = PhysicsGrips.IndexOfByKey(GripInfo);
+	index = PhysicsGripsLookup.IndexOfByKey(PhysicsGrips, GripInfo.GripID);
 	return index != INDEX_NONE;
 }
 
 FBPActorPhysicsHandleInformation * UGripMotionControllerComponent::CreatePhysicsGrip(const FBPActorGripInformation & GripInfo)
 {
-	FBPActorPhysicsHandleInformation * HandleInfo = PhysicsGrips.FindByKey(GripInfo);
+	FBPActorPhysicsHandleInformation * HandleInfo = GetPhysicsGrip(GripInfo);
 
 	if (HandleInfo)
 	{
@@ -656,6 +868,7 @@ FBPActorPhysicsHandleInformation * UGripMotionControllerComponent::CreatePhysics
 	NewInfo.GripID = GripInfo.GripID;
 
 	int index = PhysicsGrips.Add(NewInfo);
+	PhysicsGripsLookup.MarkDirty();
 
 	return &PhysicsGrips[index];
 }
@@ -703,6 +916,41 @@ void UGripMotionControllerComponent::GetLifetimeReplicatedProps(TArray< class FL
 	DOREPLIFETIME_ACTIVE_OVERRIDE(USceneComponent, RelativeScale3D, false);
 }*/
 
+void UGripMotionControllerComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Only send the grips that actually changed, this also catches direct edits to the arrays
+	if (GrippedObjects.MarkChangedGripsDirty())
+	{
+#if WITH_PUSH_MODEL
+		MARK_PROPERTY_DIRTY_FROM_NAME(UGripMotionControllerComponent, GrippedObjects, this);
+#endif
+	}
+
+	if (LocallyGrippedObjects.MarkChangedGripsDirty())
+	{
+#if WITH_PUSH_MODEL
+		MARK_PROPERTY_DIRTY_FROM_NAME(UGripMotionControllerComponent, LocallyGrippedObjects, this);
+#endif
+	}
+
+	// The owning character can throttle the pose out to the other players based on how far / visible we are to them
+	if (AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner()))
+	{
+		const bool bReplicatePose = OwningChar->ShouldReplicateTrackedPoses();
+		DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UGripMotionControllerComponent, ReplicatedControllerTransform, bReplicatePose);
+
+#if WITH_PUSH_MODEL
+		// Changes made while we were throttled had their dirty state consumed, make sure the latest gets compared
+		if (bReplicatePose && OwningChar->bThrottleTrackedPoseReplication)
+		{
+			MARK_PROPERTY_DIRTY_FROM_NAME(UGripMotionControllerComponent, ReplicatedControllerTransform, this);
+		}
+#endif
+	}
+}
+
 void UGripMotionControllerComponent::Server_SendControllerTransform_Implementation(FBPVRComponentPosRep NewTransform)
 {
 	// Store new transform and trigger OnRep_Function
@@ -826,9 +1074,9 @@ void UGripMotionControllerComponent::GetGripByActor(FBPActorGripInformation &Gri
 		return;
 	}
 
-	FBPActorGripInformation * GripInfo = GrippedObjects.FindByKey(ActorToLookForGrip);
+	FBPActorGripInformation * GripInfo = FindGrippedObjectByKey(ActorToLookForGrip);
 	if(!GripInfo)
-		GripInfo = LocallyGrippedObjects.FindByKey(ActorToLookForGrip);
+		GripInfo = FindLocallyGrippedObjectByKey(ActorToLookForGrip);
 	
 	if (GripInfo)
 	{
@@ -848,9 +1096,9 @@ void UGripMotionControllerComponent::GetGripByComponent(FBPActorGripInformation
 		return;
 	}
 
-	FBPActorGripInformation * GripInfo = GrippedObjects.FindByKey(ComponentToLookForGrip);
+	FBPActorGripInformation * GripInfo = FindGrippedObjectByKey(ComponentToLookForGrip);
 	if(!GripInfo)
-		GripInfo = LocallyGrippedObjects.FindByKey(ComponentToLookForGrip);
+		GripInfo = FindLocallyGrippedObjectByKey(ComponentToLookForGrip);
 
 	if (GripInfo)
 	{
@@ -870,9 +1118,9 @@ void UGripMotionControllerComponent::GetGripByObject(FBPActorGripInformation &Gr
 		return;
 	}
 
-	FBPActorGripInformation * GripInfo = GrippedObjects.FindByKey(ObjectToLookForGrip);
+	FBPActorGripInformation * GripInfo = FindGrippedObjectByKey(ObjectToLookForGrip);
 	if(!GripInfo)
-		GripInfo = LocallyGrippedObjects.FindByKey(ObjectToLookForGrip);
+		GripInfo = FindLocallyGrippedObjectByKey(ObjectToLookForGrip);
 
 	if (GripInfo)
 	{
@@ -891,9 +1139,9 @@ FBPActorGripInformation * UGripMotionControllerComponent::GetGripPtrByID(uint8 I
 		return nullptr;
 	}
 
-	FBPActorGripInformation* GripInfo = GrippedObjects.FindByKey(IDToLookForGrip);
+	FBPActorGripInformation* GripInfo = FindGrippedObjectByKey(IDToLookForGrip);
 	if (!GripInfo)
-		GripInfo = LocallyGrippedObjects.FindByKey(IDToLookForGrip);
+		GripInfo = FindLocallyGrippedObjectByKey(IDToLookForGrip);
 
 	return GripInfo;
 }
@@ -906,9 +1154,9 @@ void UGripMotionControllerComponent::GetGripByID(FBPActorGripInformation &Grip,
 		return;
 	}
 
-	FBPActorGripInformation * GripInfo = GrippedObjects.FindByKey(IDToLookForGrip);
+	FBPActorGripInformation * GripInfo = FindGrippedObjectByKey(IDToLookForGrip);
 	if (!GripInfo)
-		GripInfo = LocallyGrippedObjects.FindByKey(IDToLookForGrip);
+		GripInfo = FindLocallyGrippedObjectByKey(IDToLookForGrip);
 
 	if (GripInfo)
 	{
@@ -1354,9 +1602,9 @@ bool UGripMotionControllerComponent::DropObject(
 {
 	if (IsValid(ObjectToDrop))
 	{
-		FBPActorGripInformation * GripInfo = GrippedObjects.FindByKey(ObjectToDrop);
+		FBPActorGripInformation * GripInfo = FindGrippedObjectByKey(ObjectToDrop);
 		if (!GripInfo)
-			GripInfo = LocallyGrippedObjects.FindByKey(ObjectToDrop);
+			GripInfo = FindLocallyGrippedObjectByKey(ObjectToDrop);
 
 		if (GripInfo != nullptr && IsValid(GripInfo->GrippedObject))
 		{
@@ -1365,9 +1613,9 @@ bool UGripMotionControllerComponent::DropObject(
 	}
 	else if (GripIDToDrop != INVALID_VRGRIP_ID)
 	{
-		FBPActorGripInformation * GripInfo = GrippedObjects.FindByKey(GripIDToDrop);
+		FBPActorGripInformation * GripInfo = FindGrippedObjectByKey(GripIDToDrop);
 		if (!GripInfo)
-			GripInfo = LocallyGrippedObjects.FindByKey(GripIDToDrop);
+			GripInfo = FindLocallyGrippedObjectByKey(GripIDToDrop);
 
 		if (GripInfo != nullptr && IsValid(GripInfo->GrippedObject))
 		{
@@ -1522,15 +1770,15 @@ bool UGripMotionControllerComponent::DropObjectByInterface_Implementation(UObjec
 	FBPActorGripInformation * GripInfo = nullptr;
 	if (IsValid(ObjectToDrop))
 	{
-		GripInfo = GrippedObjects.FindByKey(ObjectToDrop);
+		GripInfo = FindGrippedObjectByKey(ObjectToDrop);
 		if (!GripInfo)
-			GripInfo = LocallyGrippedObjects.FindByKey(ObjectToDrop);
+			GripInfo = FindLocallyGrippedObjectByKey(ObjectToDrop);
 	}
 	else if (GripIDToDrop != INVALID_VRGRIP_ID)
 	{
-		GripInfo = GrippedObjects.FindByKey(GripIDToDrop);
+		GripInfo = FindGrippedObjectByKey(GripIDToDrop);
 		if (!GripInfo)
-			GripInfo = LocallyGrippedObjects.FindByKey(GripIDToDrop);
+			GripInfo = FindLocallyGrippedObjectByKey(GripIDToDrop);
 	}
 
 	if (GripInfo == nullptr || !IsValid(GripInfo->GrippedObject))
@@ -1857,7 +2105,7 @@ bool UGripMotionControllerComponent::DropActor(AActor* ActorToDrop, bool bSimula
 		return false;
 	}
 
-	FBPActorGripInformation * GripToDrop = LocallyGrippedObjects.FindByKey(ActorToDrop);
+	FBPActorGripInformation * GripToDrop = FindLocallyGrippedObjectByKey(ActorToDrop);
 
 	if(GripToDrop)
 		return DropGrip_Implementation(*GripToDrop, bSimulate, OptionalAngularVelocity, OptionalLinearVelocity);
@@ -1868,7 +2116,7 @@ bool UGripMotionControllerComponent::DropActor(AActor* ActorToDrop, bool bSimula
 		return false;
 	}
 
-	GripToDrop = GrippedObjects.FindByKey(ActorToDrop);
+	GripToDrop = FindGrippedObjectByKey(ActorToDrop);
 	if (GripToDrop)
 		return DropGrip_Implementation(*GripToDrop, bSimulate, OptionalAngularVelocity, OptionalLinearVelocity);
 
@@ -2116,7 +2364,7 @@ bool UGripMotionControllerComponent::DropComponent(UPrimitiveComponent * Compone
 	FBPActorGripInformation *GripInfo;
 	
 	// First check for it in the local grips	
-	GripInfo = LocallyGrippedObjects.FindByKey(ComponentToDrop);
+	GripInfo = FindLocallyGrippedObjectByKey(ComponentToDrop);
 
 	if (GripInfo != nullptr)
 	{
@@ -2131,7 +2379,7 @@ bool UGripMotionControllerComponent::DropComponent(UPrimitiveComponent * Compone
 	}
 
 	// Now check in the server auth gripsop)
-	GripInfo = GrippedObjects.FindByKey(ComponentToDrop);
+	GripInfo = FindGrippedObjectByKey(ComponentToDrop);
 
 	if (GripInfo != nullptr)
 	{
@@ -2305,9 +2553,9 @@ bool UGripMotionControllerComponent::DropAndSocketObject(const FTransform_NetQua
 	FBPActorGripInformation * GripInfo = nullptr;
 
 	if (ObjectToDrop)
-		GripInfo = LocallyGrippedObjects.FindByKey(ObjectToDrop);
+		GripInfo = FindLocallyGrippedObjectByKey(ObjectToDrop);
 	else if (GripIDToDrop != INVALID_VRGRIP_ID)
-		GripInfo = LocallyGrippedObjects.FindByKey(GripIDToDrop);
+		GripInfo = FindLocallyGrippedObjectByKey(GripIDToDrop);
 
 	if(GripInfo) // This auto checks if Actor and Component are valid in the == operator
 	{
@@ -2322,9 +2570,9 @@ bool UGripMotionControllerComponent::DropAndSocketObject(const FTransform_NetQua
 		}
 
 		if(ObjectToDrop)
-			GripInfo = GrippedObjects.FindByKey(ObjectToDrop);
+			GripInfo = FindGrippedObjectByKey(ObjectToDrop);
 		else if(GripIDToDrop != INVALID_VRGRIP_ID)
-			GripInfo = GrippedObjects.FindByKey(GripIDToDrop);
+			GripInfo = FindGrippedObjectByKey(GripIDToDrop);
 
 		if(GripInfo) // This auto checks if Actor and Component are valid in the == operator
 		{
@@ -2359,7 +2607,7 @@ bool UGripMotionControllerComponent::DropAndSocketGrip_Implementation(const FBPA
 	bool bWasLocalGrip = false;
 	FBPActorGripInformation * GripInfo = nullptr;
 
-	GripInfo = LocallyGrippedObjects.FindByKey(GripToDrop);
+	GripInfo = FindLocallyGrippedObjectByKey(GripToDrop);
 	if (GripInfo) // This auto checks if Actor and Component are valid in the == operator
 	{
 		bWasLocalGrip = true;
@@ -2372,7 +2620,7 @@ bool UGripMotionControllerComponent::DropAndSocketGrip_Implementation(const FBPA
 			return false;
 		}
 
-		GripInfo = GrippedObjects.FindByKey(GripToDrop);
+		GripInfo = FindGrippedObjectByKey(GripToDrop);
 
 		if (GripInfo) // This auto checks if Actor and Component are valid in the == operator
 		{
@@ -2795,6 +3043,9 @@ void UGripMotionControllerComponent::DropAndSocket_Implementation(const FBPActor
 	}break;
 	}
 
+	// The GripID is free to be re-used now, don't keep the scripts of the dropped object around
+	GripScriptCaches.Remove(NewDrop.GripID);
+
 	// Copy over the information instead of working with a reference for the OnDroppedBroadcast
 	FBPActorGripInformation DropBroadcastData = NewDrop;
 
@@ -2848,6 +3099,9 @@ bool UGripMotionControllerComponent::NotifyGrip(FBPActorGripInformation &NewGrip
 	if (!NewGrip.GrippedObject || !NewGrip.GrippedObject->IsValidLowLevelFast())
 		return false;
 
+	// GripIDs get re-used, make sure that we pull a fresh set of scripts for this grip
+	GripScriptCaches.Remove(NewGrip.GripID);
+
 	if (!NewGrip.AdvancedGripSettings.bDisallowLerping && !bIsReInit && NewGrip.GripCollisionType != EGripCollisionType::EventsOnly && NewGrip.GripCollisionType != EGripCollisionType::CustomGrip)
 	{
 		// Init lerping
@@ -3451,10 +3705,10 @@ void UGripMotionControllerComponent::CancelGlobalLerpToHand(uint8 GripID)
 	FBPActorGripInformation* GripToUse = nullptr;
 	if (GripID != INVALID_VRGRIP_ID)
 	{
-		GripToUse = GrippedObjects.FindByKey(GripID);
+		GripToUse = FindGrippedObjectByKey(GripID);
 		if (!GripToUse)
 		{
-			GripToUse = LocallyGrippedObjects.FindByKey(GripID);
+			GripToUse = FindLocallyGrippedObjectByKey(GripID);
 		}
 
 		if (GripToUse)
@@ -3836,6 +4090,9 @@ void UGripMotionControllerComponent::Drop_Implementation(const FBPActorGripInfor
 
 	};
 
+	// The GripID is free to be re-used now, don't keep the scripts of the dropped object around
+	GripScriptCaches.Remove(NewDrop.GripID);
+
 	// Copy over the information instead of working with a reference for the OnDroppedBroadcast
 	FBPActorGripInformation DropBroadcastData = NewDrop;
 
@@ -3961,7 +4218,7 @@ bool UGripMotionControllerComponent::AddSecondaryAttachmentPoint(UObject * Gripp
 
 	FBPActorGripInformation * GripToUse = nullptr;
 
-	GripToUse = LocallyGrippedObjects.FindByKey(GrippedObjectToAddAttachment);
+	GripToUse = FindLocallyGrippedObjectByKey(GrippedObjectToAddAttachment);
 
 	// Search replicated grips if not found in local
 	if (!GripToUse)
@@ -3973,7 +4230,7 @@ bool UGripMotionControllerComponent::AddSecondaryAttachmentPoint(UObject * Gripp
 			return false;
 		}
 
-		GripToUse = GrippedObjects.FindByKey(GrippedObjectToAddAttachment);
+		GripToUse = FindGrippedObjectByKey(GrippedObjectToAddAttachment);
 	}
 
 	if (GripToUse)
@@ -3989,10 +4246,10 @@ bool UGripMotionControllerComponent::AddSecondaryAttachmentToGripByID(const uint
 	FBPActorGripInformation* GripToUse = nullptr;
 	if (GripID != INVALID_VRGRIP_ID)
 	{
-		GripToUse = GrippedObjects.FindByKey(GripID);
+		GripToUse = FindGrippedObjectByKey(GripID);
 		if (!GripToUse)
 		{
-			GripToUse = LocallyGrippedObjects.FindByKey(GripID);
+			GripToUse = FindLocallyGrippedObjectByKey(GripID);
 		}
 
 		if (GripToUse)
@@ -4016,10 +4273,10 @@ bool UGripMotionControllerComponent::AddSecondaryAttachmentToGrip(const FBPActor
 	bool bWasLocal = false;
 	if (GripToAddAttachment.GrippedObject && GripToAddAttachment.GripID != INVALID_VRGRIP_ID)
 	{
-		GripToUse = GrippedObjects.FindByKey(GripToAddAttachment.GripID);
+		GripToUse = FindGrippedObjectByKey(GripToAddAttachment.GripID);
 		if (!GripToUse)
 		{
-			GripToUse = LocallyGrippedObjects.FindByKey(GripToAddAttachment.GripID);
+			GripToUse = FindLocallyGrippedObjectByKey(GripToAddAttachment.GripID);
 			bWasLocal = true;
 		}
 	}
@@ -4159,7 +4416,7 @@ bool UGripMotionControllerComponent::RemoveSecondaryAttachmentPoint(UObject * Gr
 	FBPActorGripInformation * GripToUse = nullptr;
 
 	// Duplicating the logic for each array for now
-	GripToUse = LocallyGrippedObjects.FindByKey(GrippedObjectToRemoveAttachment);
+	GripToUse = FindLocallyGrippedObjectByKey(GrippedObjectToRemoveAttachment);
 
 	// Check replicated grips if it wasn't found in local
 	if (!GripToUse)
@@ -4170,7 +4427,7 @@ bool UGripMotionControllerComponent::RemoveSecondaryAttachmentPoint(UObject * Gr
 			return false;
 		}
 
-		GripToUse = GrippedObjects.FindByKey(GrippedObjectToRemoveAttachment);
+		GripToUse = FindGrippedObjectByKey(GrippedObjectToRemoveAttachment);
 	}
 
 	// Handle the grip if it was found
@@ -4186,10 +4443,10 @@ bool UGripMotionControllerComponent::RemoveSecondaryAttachmentFromGripByID(const
 	FBPActorGripInformation* GripToUse = nullptr;
 	if (GripID != INVALID_VRGRIP_ID)
 	{
-		GripToUse = GrippedObjects.FindByKey(GripID);
+		GripToUse = FindGrippedObjectByKey(GripID);
 		if (!GripToUse)
 		{
-			GripToUse = LocallyGrippedObjects.FindByKey(GripID);
+			GripToUse = FindLocallyGrippedObjectByKey(GripID);
 		}
 
 		if (GripToUse)
@@ -4207,10 +4464,10 @@ bool UGripMotionControllerComponent::RemoveSecondaryAttachmentFromGrip(const FBP
 	bool bWasLocal = false;
 	if (GripToRemoveAttachment.GrippedObject && GripToRemoveAttachment.GripID != INVALID_VRGRIP_ID)
 	{
-		GripToUse = GrippedObjects.FindByKey(GripToRemoveAttachment.GripID);
+		GripToUse = FindGrippedObjectByKey(GripToRemoveAttachment.GripID);
 		if (!GripToUse)
 		{
-			GripToUse = LocallyGrippedObjects.FindByKey(GripToRemoveAttachment.GripID);
+			GripToUse = FindLocallyGrippedObjectByKey(GripToRemoveAttachment.GripID);
 			bWasLocal = true;
 		}
 	}
@@ -4358,9 +4615,9 @@ bool UGripMotionControllerComponent::TeleportMoveGrippedActor(AActor * GrippedAc
 	if (!GrippedActorToMove || (!GrippedObjects.Num() && !LocallyGrippedObjects.Num()))
 		return false;
 
-	FBPActorGripInformation * GripInfo = LocallyGrippedObjects.FindByKey(GrippedActorToMove);
+	FBPActorGripInformation * GripInfo = FindLocallyGrippedObjectByKey(GrippedActorToMove);
 	if (!GripInfo)
-		GripInfo = GrippedObjects.FindByKey(GrippedActorToMove);
+		GripInfo = FindGrippedObjectByKey(GrippedActorToMove);
 
 	if (GripInfo)
 	{
@@ -4375,9 +4632,9 @@ bool UGripMotionControllerComponent::TeleportMoveGrippedComponent(UPrimitiveComp
 	if (!ComponentToMove || (!GrippedObjects.Num() && !LocallyGrippedObjects.Num()))
 		return false;
 
-	FBPActorGripInformation * GripInfo = LocallyGrippedObjects.FindByKey(ComponentToMove);
+	FBPActorGripInformation * GripInfo = FindLocallyGrippedObjectByKey(ComponentToMove);
 	if (!GripInfo)
-		GripInfo = GrippedObjects.FindByKey(ComponentToMove);
+		GripInfo = FindGrippedObjectByKey(ComponentToMove);
 
 	if (GripInfo)
 	{
@@ -4389,6 +4646,8 @@ bool UGripMotionControllerComponent::TeleportMoveGrippedComponent(UPrimitiveComp
 
 void UGripMotionControllerComponent::TeleportMoveGrips(bool bTeleportPhysicsGrips, bool bIsForPostTeleport)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_TeleportMoveGrips);
+
 	FTransform EmptyTransform = FTransform::Identity;
 	for (FBPActorGripInformation& GripInfo : LocallyGrippedObjects)
 	{
@@ -4409,6 +4668,8 @@ bool UGripMotionControllerComponent::TeleportMoveGrip(FBPActorGripInformation &G
 
 bool UGripMotionControllerComponent::TeleportMoveGrip_Impl(FBPActorGripInformation &Grip, bool bTeleportPhysicsGrips, bool bIsForPostTeleport, FTransform & OptionalTransform)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_TeleportMoveGrip);
+
 	bool bHasMovementAuthority = HasGripMovementAuthority(Grip);
 
 	if (!bHasMovementAuthority)
@@ -4721,7 +4982,23 @@ void UGripMotionControllerComponent::OnRep_ReplicatedControllerTransform()
 
 	if (bSmoothReplicatedMotion)
 	{
-		if (bReppedOnce)
+		if (bUseSnapshotInterpolation)
+		{
+			const bool bTooFar = !PoseSnapshotBuffer.IsEmpty() &&
+				FVector::DistSquared(ReplicatedControllerTransform.Position, GetRelativeLocation()) >= FMath::Square(NetworkNoSmoothUpdateDistance);
+
+			// Start over on the first update or if we teleported
+			if (!bReppedOnce || bTooFar)
+			{
+				PoseSnapshotBuffer.Reset();
+				SetRelativeLocationAndRotation(ReplicatedControllerTransform.Position, ReplicatedControllerTransform.Rotation);
+				bReppedOnce = true;
+			}
+
+			PoseSnapshotBuffer.AddSnapshot(GetWorld()->GetTimeSeconds(), 1.0f / FMath::Max(ControllerNetUpdateRate, 1.0f), ReplicatedControllerTransform.Position, ReplicatedControllerTransform.Rotation);
+			bLerpingPosition = true;
+		}
+		else if (bReppedOnce)
 		{
 			bLerpingPosition = true;
 			ControllerNetUpdateCount = 0.0f;
@@ -4853,7 +5130,9 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 			if (!RelLoc.Equals(ReplicatedControllerTransform.Position) || !RelRot.Equals(ReplicatedControllerTransform.Rotation))
 			{
 				ControllerNetUpdateCount += DeltaTime;
-				if (ControllerNetUpdateCount >= (1.0f / ControllerNetUpdateRate))
+
+				const float SendRate = AdaptiveNetUpdateSettings.GetNetUpdateRate(ControllerNetUpdateRate, RelLoc - ReplicatedControllerTransform.Position, RelRot - ReplicatedControllerTransform.Rotation, ControllerNetUpdateCount);
+				if (ControllerNetUpdateCount >= (1.0f / SendRate))
 				{
 					ControllerNetUpdateCount = 0.0f;
 
@@ -4906,7 +5185,22 @@ void UGripMotionControllerComponent::RunNetworkedSmoothing(float DeltaTime)
 {
 	if (bLerpingPosition)
 	{
-		if (!bUseExponentialSmoothing)
+		if (bUseSnapshotInterpolation)
+		{
+			const double RenderTime = GetWorld()->GetTimeSeconds() - SnapshotInterpolationDelay;
+
+			FVector NewPosition = GetRelativeLocation();
+			FQuat NewRotation = GetRelativeRotation().Quaternion();
+			PoseSnapshotBuffer.Sample(RenderTime, SnapshotMaxExtrapolationTime, NewPosition, NewRotation);
+			SetRelativeLocationAndRotation(NewPosition, NewRotation);
+
+			// Nothing new for long enough that we are just holding, stop until the next update
+			if (PoseSnapshotBuffer.IsEmpty() || RenderTime > PoseSnapshotBuffer.GetNewestTime() + SnapshotMaxExtrapolationTime)
+			{
+				bLerpingPosition = false;
+			}
+		}
+		else if (!bUseExponentialSmoothing)
 		{
 			ControllerNetUpdateCount += DeltaTime;
 			float LerpVal = FMath::Clamp(ControllerNetUpdateCount / (1.0f / ControllerNetUpdateRate), 0.0f, 1.0f);
@@ -5001,24 +5295,203 @@ void UGripMotionControllerComponent::TickComponent(float DeltaTime, enum ELevelT
 		}
 	}*/
 
-	// Process the gripped actors
-	TickGrip(DeltaTime);
+	// Process the gripped actors, the batched grip update will call TickGrip for us if it is enabled
+	if (!QueueBatchedGripUpdate(DeltaTime))
+	{
+		TickGrip(DeltaTime);
+	}
+}
+
+bool UGripMotionControllerComponent::QueueBatchedGripUpdate(float DeltaTime)
+{
+	if (!UVRGripUpdateSubsystem::IsBatchingEnabled())
+		return false;
+
+	UWorld* World = GetWorld();
+	UVRGripUpdateSubsystem* GripUpdateSubsystem = World ? World->GetSubsystem<UVRGripUpdateSubsystem>() : nullptr;
+	return GripUpdateSubsystem && GripUpdateSubsystem->QueueGripUpdate(this, DeltaTime);
+}
+
+void UGripMotionControllerComponent::GatherBatchedGripJobs(float DeltaTime)
+{
+	BatchedGripJobs.Reset();
+	BatchedGripDeltaTime = DeltaTime;
+	BatchedGripParentTransform = GetPivotTransform();
+
+	UWorld* World = GetWorld();
+	if (!World || World->IsInSeamlessTravel())
+		return;
+
+	auto IsParallelSafe = [](const UVRGripScriptBase* Script)
+	{
+		return Script->bCanRunWorldTransformInParallel && !Script->IsA<UVRGripScriptBaseBP>();
+	};
+
+	// Mirrors the checks in HandleGripArray, anything that could run interface events, traces, or modify the grip arrays stays serial
+	auto GatherGripArray = [&](TArray<FBPActorGripInformation>& GripArray)
+	{
+		for (FBPActorGripInformation& Grip : GripArray)
+		{
+			if (!HasGripMovementAuthority(Grip) || (!Grip.ValueCache.bWasInitiallyRepped && !HasGripAuthority(Grip)))
+				continue;
+
+			if (!Grip.IsValid() || Grip.bIsPaused || Grip.GripCollisionType == EGripCollisionType::EventsOnly || Grip.GripCollisionType == EGripCollisionType::CustomGrip)
+				continue;
+
+			// Secondary grips and their lerps query the grip interface
+			if (Grip.SecondaryGripInfo.bHasSecondaryAttachment || Grip.SecondaryGripInfo.GripLerpState != EGripLerpState::NotLerping)
+				continue;
+
+			UPrimitiveComponent* root = nullptr;
+			AActor* actor = nullptr;
+
+			switch (Grip.GripTargetType)
+			{
+			case EGripTargetType::ActorGrip:
+			{
+				actor = Grip.GetGrippedActor();
+				if (actor)
+					root = Cast<UPrimitiveComponent>(actor->GetRootComponent());
+			}break;
+
+			case EGripTargetType::ComponentGrip:
+			{
+				root = Grip.GetGrippedComponent();
+				if (root)
+					actor = root->GetOwner();
+			}break;
+
+			default:break;
+			}
+
+			if (!root || !actor || !IsValid(root) || !IsValid(actor))
+				continue;
+
+			FVRBatchedGripJob Job;
+			Job.Grip = &Grip;
+			Job.GripID = Grip.GripID;
+			Job.GrippedObject = Grip.GrippedObject;
+			Job.Actor = actor;
+			Job.Root = root;
+
+			if (root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+			{
+				Job.bRootHasInterface = true;
+				Job.ScriptCache = GetGripScriptCache(Grip, root);
+			}
+			else if (actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+			{
+				Job.bActorHasInterface = true;
+				Job.ScriptCache = GetGripScriptCache(Grip, actor);
+			}
+
+			bool bCanRunInParallel = true;
+			bool bGetDefaultTransform = true;
+
+			if (Job.ScriptCache.IsValid() && Job.ScriptCache->Scripts.Num())
+			{
+				for (UVRGripScriptBase* Script : Job.ScriptCache->Scripts)
+				{
+					if (Script->IsScriptActive() && Script->GetWorldTransformOverrideType() == EGSTransformOverrideType::OverridesWorldTransform)
+					{
+						bGetDefaultTransform = false;
+						break;
+					}
+				}
+
+				for (UVRGripScriptBase* Script : Job.ScriptCache->Scripts)
+				{
+					if (Script->IsScriptActive() && Script->GetWorldTransformOverrideType() != EGSTransformOverrideType::None)
+					{
+						if (!IsParallelSafe(Script))
+						{
+							bCanRunInParallel = false;
+							break;
+						}
+
+						Job.ActiveTransformScripts.Add(Script);
+					}
+				}
+			}
+
+			Job.bUseDefaultScript = bGetDefaultTransform && DefaultGripScript;
+			if (!bCanRunInParallel || (Job.bUseDefaultScript && !IsParallelSafe(DefaultGripScript)))
+				continue;
+
+			BatchedGripJobs.Add(MoveTemp(Job));
+		}
+	};
+
+	GatherGripArray(GrippedObjects.Grips);
+	GatherGripArray(LocallyGrippedObjects.Grips);
+}
+
+void UGripMotionControllerComponent::RunBatchedGripJobs()
+{
+	// Same logic as GetGripWorldTransform, with the script active states that were captured when gathering
+	for (FVRBatchedGripJob& Job : BatchedGripJobs)
+	{
+		Job.bHasValidTransform = true;
+		Job.bForceADrop = false;
+
+		if (Job.bUseDefaultScript)
+		{
+			Job.bHasValidTransform = DefaultGripScript->CallCorrect_GetWorldTransform(this, BatchedGripDeltaTime, Job.WorldTransform, BatchedGripParentTransform, *Job.Grip, Job.Actor, Job.Root, Job.bRootHasInterface, Job.bActorHasInterface, false);
+			INC_DWORD_STAT(STAT_GripScriptsInvoked);
+			Job.bForceADrop = DefaultGripScript->Wants_ToForceDrop();
+		}
+
+		for (UVRGripScriptBase* Script : Job.ActiveTransformScripts)
+		{
+			Job.bHasValidTransform = Script->CallCorrect_GetWorldTransform(this, BatchedGripDeltaTime, Job.WorldTransform, BatchedGripParentTransform, *Job.Grip, Job.Actor, Job.Root, Job.bRootHasInterface, Job.bActorHasInterface, false);
+			INC_DWORD_STAT(STAT_GripScriptsInvoked);
+			Job.bForceADrop = Script->Wants_ToForceDrop();
+
+			if (!Job.bHasValidTransform || Job.bForceADrop)
+				break;
+		}
+
+		Job.bIsComplete = true;
+	}
+}
+
+const FVRBatchedGripJob* UGripMotionControllerComponent::FindBatchedGripJob(const FBPActorGripInformation& Grip) const
+{
+	for (const FVRBatchedGripJob& Job : BatchedGripJobs)
+	{
+		// Matching on the object as well, the grip could have been dropped and the ID re-used by an earlier callback this frame
+		if (Job.bIsComplete && Job.GripID == Grip.GripID && Job.GrippedObject == Grip.GrippedObject)
+		{
+			return &Job;
+		}
+	}
+
+	return nullptr;
 }
 
 bool UGripMotionControllerComponent::GetGripWorldTransform(TArray<UVRGripScriptBase*>& GripScripts, float DeltaTime, FTransform & WorldTransform, const FTransform &ParentTransform, FBPActorGripInformation &Grip, AActor * actor, UPrimitiveComponent * root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool &bForceADrop)
 {
-	SCOPE_CYCLE_COUNTER(STAT_GetGripTransform);
+	FVRGripScriptCache ScriptCache;
+	ScriptCache.Scripts = GripScripts;
+	ScriptCache.Scripts.Remove(nullptr);
+
+	return GetGripWorldTransform(ScriptCache, DeltaTime, WorldTransform, ParentTransform, Grip, actor, root, bRootHasInterface, bActorHasInterface, bIsForTeleport, bForceADrop);
+}
+
+bool UGripMotionControllerComponent::GetGripWorldTransform(const FVRGripScriptCache& GripScripts, float DeltaTime, FTransform& WorldTransform, const FTransform& ParentTransform, FBPActorGripInformation& Grip, AActor* actor, UPrimitiveComponent* root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool& bForceADrop)
+{
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GetGripTransform);
 
 	bool bHasValidTransform = true;
 
-	if (GripScripts.Num())
+	if (GripScripts.Scripts.Num())
 	{
 		bool bGetDefaultTransform = true;
 
 		// Get grip script world transform overrides (if there are any)
-		for (UVRGripScriptBase* Script: GripScripts)
+		for (UVRGripScriptBase* Script : GripScripts.Scripts)
 		{
-			if (Script && Script->IsScriptActive() && Script->GetWorldTransformOverrideType() == EGSTransformOverrideType::OverridesWorldTransform)
+			if (Script->IsScriptActive() && Script->GetWorldTransformOverrideType() == EGSTransformOverrideType::OverridesWorldTransform)
 			{
 				// One of the grip scripts overrides the default transform
 				bGetDefaultTransform = false;
@@ -5030,15 +5503,17 @@ bool UGripMotionControllerComponent::GetGripWorldTransform(TArray<UVRGripScriptB
 		if (bGetDefaultTransform && DefaultGripScript)
 		{		
 			bHasValidTransform = DefaultGripScript->CallCorrect_GetWorldTransform(this, DeltaTime, WorldTransform, ParentTransform, Grip, actor, root, bRootHasInterface, bActorHasInterface, bIsForTeleport);
+			INC_DWORD_STAT(STAT_GripScriptsInvoked);
 			bForceADrop = DefaultGripScript->Wants_ToForceDrop();
 		}
 
 		// Get grip script world transform modifiers (if there are any)
-		for (UVRGripScriptBase* Script : GripScripts)
+		for (UVRGripScriptBase* Script : GripScripts.Scripts)
 		{
-			if (Script && Script->IsScriptActive() && Script->GetWorldTransformOverrideType() != EGSTransformOverrideType::None)
+			if (Script->IsScriptActive() && Script->GetWorldTransformOverrideType() != EGSTransformOverrideType::None)
 			{
 				bHasValidTransform = Script->CallCorrect_GetWorldTransform(this, DeltaTime, WorldTransform, ParentTransform, Grip, actor, root, bRootHasInterface, bActorHasInterface, bIsForTeleport);
+				INC_DWORD_STAT(STAT_GripScriptsInvoked);
 				bForceADrop = Script->Wants_ToForceDrop();
 
 				// Early out, one of the scripts is telling us that the transform isn't valid, something went wrong or the grip is flagged for drop
@@ -5052,10 +5527,16 @@ bool UGripMotionControllerComponent::GetGripWorldTransform(TArray<UVRGripScriptB
 		if (DefaultGripScript)
 		{
 			bHasValidTransform = DefaultGripScript->CallCorrect_GetWorldTransform(this, DeltaTime, WorldTransform, ParentTransform, Grip, actor, root, bRootHasInterface, bActorHasInterface, bIsForTeleport);
+			INC_DWORD_STAT(STAT_GripScriptsInvoked);
 			bForceADrop = DefaultGripScript->Wants_ToForceDrop();
 		}
 	}
 
+	return FinalizeGripWorldTransform(DeltaTime, WorldTransform, Grip, bHasValidTransform);
+}
+
+bool UGripMotionControllerComponent::FinalizeGripWorldTransform(float DeltaTime, FTransform& WorldTransform, FBPActorGripInformation& Grip, bool bHasValidTransform)
+{
 	HandleGlobalLerpToHand(Grip, WorldTransform, DeltaTime);
 
 	if (bHasValidTransform && !WorldTransform.IsValid())
@@ -5069,7 +5550,7 @@ bool UGripMotionControllerComponent::GetGripWorldTransform(TArray<UVRGripScriptB
 
 void UGripMotionControllerComponent::TickGrip(float DeltaTime)
 {
-	SCOPE_CYCLE_COUNTER(STAT_TickGrip);
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_TickGrip);
 
 	// Debug test that we aren't floating physics handles
 	if (PhysicsGrips.Num() > (GrippedObjects.Num() + LocallyGrippedObjects.Num()))
@@ -5088,8 +5569,8 @@ void UGripMotionControllerComponent::TickGrip(float DeltaTime)
 	bool bOriginalPostTeleport = bIsPostTeleport;
 
 	// Split into separate functions so that I didn't have to combine arrays since I have some removal going on
-	HandleGripArray(GrippedObjects, ParentTransform, DeltaTime, true);
-	HandleGripArray(LocallyGrippedObjects, ParentTransform, DeltaTime);
+	HandleGripArray(GrippedObjects.Grips, ParentTransform, DeltaTime, true);
+	HandleGripArray(LocallyGrippedObjects.Grips, ParentTransform, DeltaTime);
 
 	// Empty out the teleport flag, checking original state just in case the player changed it while processing bps
 	if (bOriginalPostTeleport)
@@ -5159,10 +5640,15 @@ void UGripMotionControllerComponent::CalculateGripVelocity(FBPActorGripInformati
 
 void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformation> &GrippedObjectsArray, const FTransform & ParentTransform, float DeltaTime, bool bReplicatedArray)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_HandleGripArray);
+
 	if (GrippedObjectsArray.Num())
 	{
 		FTransform WorldTransform;
 
+		// Used for grips on objects without the grip interface
+		FVRGripScriptCache EmptyScriptCache;
+
 		for (int i = GrippedObjectsArray.Num() - 1; i >= 0; --i)
 		{
 			if (!HasGripMovementAuthority(GrippedObjectsArray[i]))
@@ -5222,6 +5708,8 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 					continue;
 				}
 
+				INC_DWORD_STAT(STAT_GripsProcessed);
+
 				// Check if either implements the interface
 				bool bRootHasInterface = false;
 				bool bActorHasInterface = false;
@@ -5238,6 +5726,8 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 				if (Grip->GripCollisionType == EGripCollisionType::CustomGrip)
 				{
+					VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_Custom);
+
 					// Don't perform logic on the movement for this object, just pass in the GripTick() event with the controller difference instead
 					if(bRootHasInterface)
 						IVRGripInterface::Execute_TickGrip(root, this, *Grip, DeltaTime);
@@ -5251,22 +5741,36 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 				bool bRescalePhysicsGrips = false;
 				
-				TArray<UVRGripScriptBase*> GripScripts;
+				TSharedPtr<FVRGripScriptCache> ScriptCache;
 
 				if (bRootHasInterface)
 				{
-					IVRGripInterface::Execute_GetGripScripts(root, GripScripts);
+					ScriptCache = GetGripScriptCache(*Grip, root);
 				}
 				else if (bActorHasInterface)
 				{
-					IVRGripInterface::Execute_GetGripScripts(actor, GripScripts);
+					ScriptCache = GetGripScriptCache(*Grip, actor);
 				}
 
+				FVRGripScriptCache& GripScripts = ScriptCache.IsValid() ? *ScriptCache : EmptyScriptCache;
+
 
 				bool bForceADrop = false;
+				bool bHasValidWorldTransform = false;
 
-				// Get the world transform for this grip after handling secondary grips and interaction differences
-				bool bHasValidWorldTransform = GetGripWorldTransform(GripScripts, DeltaTime, WorldTransform, ParentTransform, *Grip, actor, root, bRootHasInterface, bActorHasInterface, false, bForceADrop);
+				// The batched grip update may have already ran the scripts for this grip, only use it if our inputs still match
+				const FVRBatchedGripJob* BatchedJob = BatchedGripJobs.Num() ? FindBatchedGripJob(*Grip) : nullptr;
+				if (BatchedJob && BatchedGripDeltaTime == DeltaTime && ParentTransform.Equals(BatchedGripParentTransform, 0.0f))
+				{
+					WorldTransform = BatchedJob->WorldTransform;
+					bForceADrop = BatchedJob->bForceADrop;
+					bHasValidWorldTransform = FinalizeGripWorldTransform(DeltaTime, WorldTransform, *Grip, BatchedJob->bHasValidTransform);
+				}
+				else
+				{
+					// Get the world transform for this grip after handling secondary grips and interaction differences
+					bHasValidWorldTransform = GetGripWorldTransform(GripScripts, DeltaTime, WorldTransform, ParentTransform, *Grip, actor, root, bRootHasInterface, bActorHasInterface, false, bForceADrop);
+				}
 
 				// If a script or behavior is telling us to skip this and continue on (IE: it dropped the grip)
 				if (bForceADrop)
@@ -5296,7 +5800,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 				{
 
 					bool bSkipTeleport = false;
-					for (UVRGripScriptBase* Script : GripScripts)
+					for (UVRGripScriptBase* Script : GripScripts.Scripts)
 					{
 						if (Script && Script->IsScriptActive() && Script->Wants_DenyTeleport(this))
 						{
@@ -5363,9 +5867,9 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 							if (Grip->GripDistance >= BreakDistance)
 							{
 								bool bIgnoreDrop = false;
-								for (UVRGripScriptBase* Script : GripScripts)
+								for (UVRGripScriptBase* Script : GripScripts.Scripts)
 								{
-									if (Script && Script->IsScriptActive() && Script->Wants_DenyAutoDrop())
+									if (Script->IsScriptActive() && Script->Wants_DenyAutoDrop())
 									{
 										bIgnoreDrop = true;
 										break;
@@ -5412,6 +5916,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 					case EGripCollisionType::InteractiveCollisionWithPhysics:
 					case EGripCollisionType::LockedConstraint:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_Physics);
 						UpdatePhysicsHandleTransform(*Grip, WorldTransform);
 						
 						if (bRescalePhysicsGrips)
@@ -5480,6 +5985,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 					case EGripCollisionType::InteractiveCollisionWithSweep:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_Sweep);
 						FVector OriginalPosition(root->GetComponentLocation());
 						FVector NewPosition(WorldTransform.GetTranslation());
 
@@ -5524,6 +6030,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 					case EGripCollisionType::InteractiveHybridCollisionWithPhysics:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_HybridPhysics);
 						UpdatePhysicsHandleTransform(*Grip, WorldTransform);
 
 						if (bRescalePhysicsGrips)
@@ -5615,6 +6122,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 					case EGripCollisionType::InteractiveHybridCollisionWithSweep:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_HybridSweep);
 
 						// Make sure that there is no collision on course before turning off collision and snapping to controller
 						FBPActorPhysicsHandleInformation * GripHandle = GetPhysicsGrip(*Grip);
@@ -5843,7 +6351,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 						{
 							if (!GripHandle)
 							{
-								SetUpPhysicsHandle(*Grip, &GripScripts);
+								SetUpPhysicsHandle(*Grip, &GripScripts.Scripts);
 							}
 							else if (GripHandle->bIsPaused)
 							{
@@ -5872,6 +6380,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 					case EGripCollisionType::SweepWithPhysics:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_SweepWithPhysics);
 						// Ensure physics simulation is off in case something sneaked it on
 						if (root->IsSimulatingPhysics())
 						{
@@ -5935,6 +6444,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 					case EGripCollisionType::PhysicsOnly:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_PhysicsOnly);
 						// Ensure physics simulation is off in case something sneaked it on
 						if (root->IsSimulatingPhysics())
 						{
@@ -5958,6 +6468,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 					case EGripCollisionType::AttachmentGrip:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_Attachment);
 						FTransform RelativeTrans = WorldTransform.GetRelativeTransform(ParentTransform);
 
 						if (!root->GetAttachParent() || root->IsSimulatingPhysics())
@@ -5990,6 +6501,7 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 					case EGripCollisionType::ManipulationGrip:
 					case EGripCollisionType::ManipulationGripWithWristTwist:
 					{
+						VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripType_Manipulation);
 						UpdatePhysicsHandleTransform(*Grip, WorldTransform);
 						if (bRescalePhysicsGrips)
 							root->SetWorldScale3D(WorldTransform.GetScale3D());
@@ -6044,6 +6556,7 @@ void UGripMotionControllerComponent::CleanUpBadGrip(TArray<FBPActorGripInformati
 				// Need to delete it from the physics thread
 				DestroyPhysicsHandle(&PhysicsGrips[g]);
 				PhysicsGrips.RemoveAt(g);
+				PhysicsGripsLookup.MarkDirty();
 			}
 		}
 	}
@@ -6065,24 +6578,25 @@ void UGripMotionControllerComponent::CleanUpBadPhysicsHandles()
 	// Clean up tailing physics handles with null objects
 	for (int g = PhysicsGrips.Num() - 1; g >= 0; --g)
 	{
-		FBPActorGripInformation * GripInfo = LocallyGrippedObjects.FindByKey(PhysicsGrips[g].GripID);
+		FBPActorGripInformation * GripInfo = FindLocallyGrippedObjectByKey(PhysicsGrips[g].GripID);
 		if(!GripInfo)
-			GripInfo = GrippedObjects.FindByKey(PhysicsGrips[g].GripID);
+			GripInfo = FindGrippedObjectByKey(PhysicsGrips[g].GripID);
 
 		if (!GripInfo)
 		{
 			// Need to delete it from the physics thread
 			DestroyPhysicsHandle(&PhysicsGrips[g]);
 			PhysicsGrips.RemoveAt(g);
+			PhysicsGripsLookup.MarkDirty();
 		}
 	}
 }
 
 bool UGripMotionControllerComponent::UpdatePhysicsHandle(uint8 GripID, bool bFullyRecreate)
 {
-	FBPActorGripInformation* GripInfo = GrippedObjects.FindByKey(GripID);
+	FBPActorGripInformation* GripInfo = FindGrippedObjectByKey(GripID);
 	if (!GripInfo)
-		GripInfo = LocallyGrippedObjects.FindByKey(GripID);
+		GripInfo = FindLocallyGrippedObjectByKey(GripID);
 
 	if (!GripInfo)
 		return false;
@@ -6092,6 +6606,8 @@ bool UGripMotionControllerComponent::UpdatePhysicsHandle(uint8 GripID, bool bFul
 
 bool UGripMotionControllerComponent::UpdatePhysicsHandle(const FBPActorGripInformation& GripInfo, bool bFullyRecreate)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_UpdatePhysicsHandle);
+
 	int HandleIndex = 0;
 	FBPActorPhysicsHandleInformation* HandleInfo = GetPhysicsGrip(GripInfo);
 
@@ -6199,6 +6715,8 @@ bool UGripMotionControllerComponent::DestroyPhysicsHandle(FBPActorPhysicsHandleI
 
 bool UGripMotionControllerComponent::DestroyPhysicsHandle(const FBPActorGripInformation &Grip, bool bSkipUnregistering)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_DestroyPhysicsHandle);
+
 	FBPActorPhysicsHandleInformation * HandleInfo = GetPhysicsGrip(Grip);
 
 	if (!HandleInfo)
@@ -6257,7 +6775,10 @@ bool UGripMotionControllerComponent::DestroyPhysicsHandle(const FBPActorGripInfo
 
 	int index;
 	if (GetPhysicsGripIndex(Grip, index))
+	{
 		PhysicsGrips.RemoveAt(index);
+		PhysicsGripsLookup.MarkDirty();
+	}
 
 	return true;
 }
@@ -6296,6 +6817,8 @@ void UGripMotionControllerComponent::OnGripMassUpdated(FBodyInstance* GripBodyIn
 
 bool UGripMotionControllerComponent::SetUpPhysicsHandle(const FBPActorGripInformation &NewGrip, TArray<UVRGripScriptBase*> * GripScripts)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_SetUpPhysicsHandle);
+
 	UPrimitiveComponent *root = NewGrip.GetGrippedComponent();
 	AActor * pActor = NewGrip.GetGrippedActor();
 
@@ -6321,22 +6844,21 @@ bool UGripMotionControllerComponent::SetUpPhysicsHandle(const FBPActorGripInform
 	HandleInfo->bSkipDeletingKinematicActor = (bConstrainToPivot && !NewGrip.bIsLerping);
 
 	// Check for grip scripts if we weren't passed in any
-	TArray<UVRGripScriptBase*> LocalGripScripts;
+	TSharedPtr<FVRGripScriptCache> ScriptCache;
 	if (GripScripts == nullptr)
 	{
 		if (root && root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
 		{
-			if (IVRGripInterface::Execute_GetGripScripts(root, LocalGripScripts))
-			{
-				GripScripts = &LocalGripScripts;
-			}
+			ScriptCache = GetGripScriptCache(NewGrip, root);
 		}
 		else if (pActor && pActor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
 		{
-			if (IVRGripInterface::Execute_GetGripScripts(pActor, LocalGripScripts))
-			{
-				GripScripts = &LocalGripScripts;
-			}
+			ScriptCache = GetGripScriptCache(NewGrip, pActor);
+		}
+
+		if (ScriptCache.IsValid() && ScriptCache->bHasScripts)
+		{
+			GripScripts = &ScriptCache->Scripts;
 		}
 	}
 
@@ -7063,6 +7585,8 @@ bool UGripMotionControllerComponent::GetPhysicsJointLength(const FBPActorGripInf
 
 void UGripMotionControllerComponent::UpdatePhysicsHandleTransform(const FBPActorGripInformation &GrippedActor, const FTransform& NewTransform)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_UpdatePhysicsHandleTransform);
+
 	if (!GrippedActor.GrippedObject || (bConstrainToPivot && !GrippedActor.bIsLerping) || IsTravelingOrNullWorld())
 		return;
 
@@ -7115,6 +7639,8 @@ static void PullBackHitComp(FHitResult& Hit, const FVector& Start, const FVector
 
 bool UGripMotionControllerComponent::CheckComponentWithSweep(UPrimitiveComponent * ComponentToCheck, FVector Move, FRotator newOrientation, bool bSkipSimulatingComponents/*,  bool &bHadBlockingHitOut*/)
 {
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_CheckComponentWithSweep);
+
 	TArray<FHitResult> Hits;
 	// WARNING: HitResult is only partially initialized in some paths. All data is valid only if bFilledHitResult is true.
 	FHitResult BlockingHit(NoInit);
@@ -7712,8 +8238,8 @@ FBPActorGripInformation* UGripMotionControllerComponent::GetFirstActiveGrip()
 
 void UGripMotionControllerComponent::GetAllGrips(TArray<FBPActorGripInformation> &GripArray)
 {
-	GripArray.Append(GrippedObjects);
-	GripArray.Append(LocallyGrippedObjects);
+	GripArray.Append(GrippedObjects.Grips);
+	GripArray.Append(LocallyGrippedObjects.Grips);
 }
 
 void UGripMotionControllerComponent::GetGrippedObjects(TArray<UObject*> &GrippedObjectsArray)
@@ -8066,7 +8592,7 @@ void UGripMotionControllerComponent::Server_NotifySecondaryAttachmentChanged_Imp
 {
 	DIRTY_LOCALLY_GRIPPED_OBJECTS();
 
-	FBPActorGripInformation * GripInfo = LocallyGrippedObjects.FindByKey(GripID);
+	FBPActorGripInformation * GripInfo = FindLocallyGrippedObjectByKey(GripID);
 	if (GripInfo != nullptr)
 	{
 		FBPActorGripInformation OriginalGrip = *GripInfo;
@@ -8093,7 +8619,7 @@ void UGripMotionControllerComponent::Server_NotifySecondaryAttachmentChanged_Ret
 {
 	DIRTY_LOCALLY_GRIPPED_OBJECTS();
 
-	FBPActorGripInformation * GripInfo = LocallyGrippedObjects.FindByKey(GripID);
+	FBPActorGripInformation * GripInfo = FindLocallyGrippedObjectByKey(GripID);
 	if (GripInfo != nullptr)
 	{
 		FBPActorGripInformation OriginalGrip = *GripInfo;
@@ -8147,6 +8673,7 @@ void UGripMotionControllerComponent::GetControllerDeviceID(FXRDeviceId & DeviceI
 FExpandedLateUpdateManager::FExpandedLateUpdateManager()
 	: LateUpdateGameWriteIndex(0)
 	, LateUpdateRenderReadIndex(0)
+	, SetupCount(0)
 {
 }
 
@@ -8157,6 +8684,7 @@ void FExpandedLateUpdateManager::Setup(const FTransform& ParentToWorld, UGripMot
 
 	check(IsInGameThread());
 
+	++SetupCount;
 
 	UpdateStates[LateUpdateGameWriteIndex].Primitives.Reset();
 	UpdateStates[LateUpdateGameWriteIndex].ParentToWorld = ParentToWorld;
@@ -8169,12 +8697,21 @@ void FExpandedLateUpdateManager::Setup(const FTransform& ParentToWorld, UGripMot
 			GatherLateUpdatePrimitives(primComp);
 	}
 
-	ProcessGripArrayLateUpdatePrimitives(Component, Component->LocallyGrippedObjects);
-	ProcessGripArrayLateUpdatePrimitives(Component, Component->GrippedObjects);
+	ProcessGripArrayLateUpdatePrimitives(Component, Component->LocallyGrippedObjects.Grips);
+	ProcessGripArrayLateUpdatePrimitives(Component, Component->GrippedObjects.Grips);
 
 	GatherLateUpdatePrimitives(Component);
 	//GatherLateUpdatePrimitives(Component);
 
+	// Drop the hierarchies of anything that is no longer gripped / late updated
+	for (auto CacheIt = GatherCaches.CreateIterator(); CacheIt; ++CacheIt)
+	{
+		if (CacheIt->Value.LastUsedSetup != SetupCount)
+		{
+			CacheIt.RemoveCurrent();
+		}
+	}
+
 	UpdateStates[LateUpdateGameWriteIndex].bSkip = bSkipLateUpdate;
 	++UpdateStates[LateUpdateGameWriteIndex].TrackingNumber;
 
@@ -8277,25 +8814,77 @@ void FExpandedLateUpdateManager::CacheSceneInfo(USceneComponent* Component)
 	}
 }
 
+bool FExpandedLateUpdateManager::IsGatherCacheValid(const FLateUpdateGatherCache& GatherCache) const
+{
+	if (!GatherCache.Components.Num() || (SetupCount - GatherCache.LastGatherSetup) >= (uint64)FMath::Max(GripMotionControllerCvars::LateUpdateRegatherInterval, 1))
+		return false;
+
+	for (int32 i = 0; i < GatherCache.Components.Num(); ++i)
+	{
+		const USceneComponent* Component = GatherCache.Components[i].Get();
+		if (!Component || GetAttachChildrenHash(Component) != GatherCache.AttachChildHashes[i])
+			return false;
+	}
+
+	return true;
+}
+
+uint32 FExpandedLateUpdateManager::GetAttachChildrenHash(const USceneComponent* Component)
+{
+	const TArray<TObjectPtr<USceneComponent>>& AttachChildren = Component->GetAttachChildren();
+
+	uint32 Hash = GetTypeHash(AttachChildren.Num());
+	for (const TObjectPtr<USceneComponent>& Child : AttachChildren)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(Child.Get()));
+	}
+
+	return Hash;
+}
+
 void FExpandedLateUpdateManager::GatherLateUpdatePrimitives(USceneComponent* ParentComponent)
 {
-	CacheSceneInfo(ParentComponent);
-	TArray<USceneComponent*> DirectComponents;
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_LateUpdateGather);
 
-	// Std late updates
-	ParentComponent->GetChildrenComponents(true, DirectComponents);
-	for (USceneComponent* Component : DirectComponents)
+	FLateUpdateGatherCache& GatherCache = GatherCaches.FindOrAdd(ParentComponent);
+	GatherCache.LastUsedSetup = SetupCount;
+
+	// Scene proxies are looked up fresh each frame in CacheSceneInfo, so we only need to re-walk the hierarchy if it changed
+	if (!IsGatherCacheValid(GatherCache))
 	{
-		if (Component != nullptr)
+		INC_DWORD_STAT(STAT_LateUpdateGathers);
+
+		TArray<USceneComponent*> DirectComponents;
+
+		// Std late updates
+		ParentComponent->GetChildrenComponents(true, DirectComponents);
+
+		GatherCache.Components.Reset(DirectComponents.Num() + 1);
+		GatherCache.AttachChildHashes.Reset(DirectComponents.Num() + 1);
+		GatherCache.Components.Add(ParentComponent);
+		GatherCache.AttachChildHashes.Add(GetAttachChildrenHash(ParentComponent));
+
+		for (USceneComponent* Component : DirectComponents)
 		{
-			CacheSceneInfo(Component);
+			if (Component != nullptr)
+			{
+				GatherCache.Components.Add(Component);
+				GatherCache.AttachChildHashes.Add(GetAttachChildrenHash(Component));
+			}
 		}
+
+		GatherCache.LastGatherSetup = SetupCount;
+	}
+
+	for (const TWeakObjectPtr<USceneComponent>& Component : GatherCache.Components)
+	{
+		CacheSceneInfo(Component.Get());
 	}
 }
 
-void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent * MotionControllerComponent, TArray<FBPActorGripInformation> & GripArray)
+void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent * MotionControllerComponent, const TArray<FBPActorGripInformation> & GripArray)
 {
-	for (FBPActorGripInformation actor : GripArray)
+	for (const FBPActorGripInformation& actor : GripArray)
 	{
 		// Skip actors that are colliding if turning off late updates during collision.
 		// Also skip turning off late updates for SweepWithPhysics, as it should always be locked to the hand
@@ -8351,13 +8940,13 @@ void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotio
 		// Don't run late updates if we have a grip script that denies it
 		if (actor.GrippedObject->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
 		{
-			TArray<UVRGripScriptBase*> GripScripts;
-			if (IVRGripInterface::Execute_GetGripScripts(actor.GrippedObject, GripScripts))
+			TSharedPtr<FVRGripScriptCache> GripScripts = MotionControllerComponent->GetGripScriptCache(actor, actor.GrippedObject);
+			if (GripScripts.IsValid() && GripScripts->bHasScripts)
 			{
 				bool bContinueOn = false;
-				for (UVRGripScriptBase* Script : GripScripts)
+				for (UVRGripScriptBase* Script : GripScripts->Scripts)
 				{
-					if (Script && Script->IsScriptActive() && Script->Wants_DenyLateUpdates())
+					if (Script->IsScriptActive() && Script->Wants_DenyLateUpdates())
 					{
 						bContinueOn = true;
 						break;
@@ -8452,7 +9041,7 @@ bool UGripMotionControllerComponent::GetIsObjectHeld(const UObject * ObjectToChe
 	if (!ObjectToCheck)
 		return false;
 
-	return (GrippedObjects.FindByKey(ObjectToCheck) || LocallyGrippedObjects.FindByKey(ObjectToCheck));
+	return (FindGrippedObjectByKey(ObjectToCheck) || FindLocallyGrippedObjectByKey(ObjectToCheck));
 }
 
 bool UGripMotionControllerComponent::GetIsHeld(const AActor * ActorToCheck)
@@ -8460,7 +9049,7 @@ bool UGripMotionControllerComponent::GetIsHeld(const AActor * ActorToCheck)
 	if (!ActorToCheck)
 		return false;
 
-	return (GrippedObjects.FindByKey(ActorToCheck) || LocallyGrippedObjects.FindByKey(ActorToCheck));
+	return (FindGrippedObjectByKey(ActorToCheck) || FindLocallyGrippedObjectByKey(ActorToCheck));
 }
 
 bool UGripMotionControllerComponent::GetIsComponentHeld(const UPrimitiveComponent * ComponentToCheck)
@@ -8468,7 +9057,7 @@ bool UGripMotionControllerComponent::GetIsComponentHeld(const UPrimitiveComponen
 	if (!ComponentToCheck)
 		return false;
 
-	return (GrippedObjects.FindByKey(ComponentToCheck) || LocallyGrippedObjects.FindByKey(ComponentToCheck));
+	return (FindGrippedObjectByKey(ComponentToCheck) || FindLocallyGrippedObjectByKey(ComponentToCheck));
 
 	//return false;
 }
@@ -8584,6 +9173,65 @@ bool UGripMotionControllerComponent::HasAuthority() const
 	return bHasAuthority;
 }
 
+void FBPActorGripInformation::PreReplicatedRemove(const FBPGripArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnReplicatedGripRemoved(InArraySerializer, *this);
+	}
+}
+
+void FBPActorGripInformation::PostReplicatedAdd(const FBPGripArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnReplicatedGripAdded(InArraySerializer, *this);
+	}
+}
+
+void FBPActorGripInformation::PostReplicatedChange(const FBPGripArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnReplicatedGripChanged(InArraySerializer, *this);
+	}
+}
+
+void UGripMotionControllerComponent::OnReplicatedGripAdded(const FBPGripArray& InGripArray, FBPActorGripInformation& Grip)
+{
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripArrayReplication);
+
+	const bool bIsGrippedObjects = &InGripArray == &GrippedObjects;
+	FBPGripArray& GripArray = bIsGrippedObjects ? GrippedObjects : LocallyGrippedObjects;
+	(bIsGrippedObjects ? GrippedObjectsLookup : LocallyGrippedObjectsLookup).MarkDirty();
+
+	HandleGripReplication(Grip, nullptr);
+	GripArray.GripSnapshots.Add(Grip.GripID, Grip);
+}
+
+void UGripMotionControllerComponent::OnReplicatedGripChanged(const FBPGripArray& InGripArray, FBPActorGripInformation& Grip)
+{
+	VRGRIP_SCOPE_CYCLE_COUNTER(STAT_GripArrayReplication);
+
+	const bool bIsGrippedObjects = &InGripArray == &GrippedObjects;
+	FBPGripArray& GripArray = bIsGrippedObjects ? GrippedObjects : LocallyGrippedObjects;
+	(bIsGrippedObjects ? GrippedObjectsLookup : LocallyGrippedObjectsLookup).MarkDirty();
+
+	// The snapshot is the last state we received for this grip, lets us diff secondary grip changes properly
+	HandleGripReplication(Grip, GripArray.GripSnapshots.Find(Grip.GripID));
+	GripArray.GripSnapshots.Add(Grip.GripID, Grip);
+}
+
+void UGripMotionControllerComponent::OnReplicatedGripRemoved(const FBPGripArray& InGripArray, FBPActorGripInformation& Grip)
+{
+	const bool bIsGrippedObjects = &InGripArray == &GrippedObjects;
+	FBPGripArray& GripArray = bIsGrippedObjects ? GrippedObjects : LocallyGrippedObjects;
+	(bIsGrippedObjects ? GrippedObjectsLookup : LocallyGrippedObjectsLookup).MarkDirty();
+
+	// The drop itself was already handled by the drop RPC
+	GripArray.GripSnapshots.Remove(Grip.GripID);
+}
+
 void UGripMotionControllerComponent::CheckTransactionBuffer()
 {
 	if (LocalTransactionBuffer.Num())
@@ -8647,6 +9295,8 @@ void UGripMotionControllerComponent::SetControllerNetUpdateRate(float NewControl
 
 void UGripMotionControllerComponent::DIRTY_GRIPPED_OBJECTS()
 {
+	GrippedObjectsLookup.MarkDirty();
+
 #if WITH_PUSH_MODEL
 	MARK_PROPERTY_DIRTY_FROM_NAME(UGripMotionControllerComponent, GrippedObjects, this);
 #endif
@@ -8654,6 +9304,8 @@ void UGripMotionControllerComponent::DIRTY_GRIPPED_OBJECTS()
 
 void UGripMotionControllerComponent::DIRTY_LOCALLY_GRIPPED_OBJECTS()
 {
+	LocallyGrippedObjectsLookup.MarkDirty();
+
 #if WITH_PUSH_MODEL
 	MARK_PROPERTY_DIRTY_FROM_NAME(UGripMotionControllerComponent, LocallyGrippedObjects, this);
 #endif
@@ -14,6 +14,9 @@ UGS_Default::UGS_Default(const FObjectInitializer& ObjectInitializer) :
 {
 	bIsActive = true;
 	WorldTransformOverrideType = EGSTransformOverrideType::OverridesWorldTransform;
+
+	// Only used by the batched grip update when there is no secondary grip, which is pure math
+	bCanRunWorldTransformInParallel = true;
 }
 
 void UGS_Default::GetAnyScaling(FVector& Scaler, FBPActorGripInformation& Grip, FVector& frontLoc, FVector& frontLocOrig, ESecondaryGripType SecondaryType, FTransform& SecondaryTransform)
@@ -22,6 +22,7 @@ UGS_GunTools::UGS_GunTools(const FObjectInitializer& ObjectInitializer) :
 {
 	bIsActive = true;
 	WorldTransformOverrideType = EGSTransformOverrideType::OverridesWorldTransform;
+	bCanRunWorldTransformInParallel = false; // Recoil and virtual stock logic touch other components
 	PivotOffset = FVector::ZeroVector;
 	VirtualStockComponent = nullptr;
 	MountWorldTransform = FTransform::Identity;
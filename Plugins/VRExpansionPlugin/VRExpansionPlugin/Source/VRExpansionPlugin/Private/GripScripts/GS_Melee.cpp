@@ -22,6 +22,7 @@ UGS_Melee::UGS_Melee(const FObjectInitializer& ObjectInitializer) :
 	bIsActive = true;
 	WorldTransformOverrideType = EGSTransformOverrideType::ModifiesWorldTransform;
 	bDenyLateUpdates = true;
+	bCanRunWorldTransformInParallel = false; // Lodge and hand selection logic touch other components
 
 
 	bInjectPrePhysicsHandle = true;
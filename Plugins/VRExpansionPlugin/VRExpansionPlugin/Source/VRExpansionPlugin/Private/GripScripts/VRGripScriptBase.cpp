@@ -27,6 +27,7 @@ UVRGripScriptBase::UVRGripScriptBase(const FObjectInitializer& ObjectInitializer
 	bDenyAutoDrop = false;
 	bDenyLateUpdates = false;
 	bForceDrop = false;
+	bCanRunWorldTransformInParallel = false;
 	bIsActive = false;
 
 	bCanEverTick = false;
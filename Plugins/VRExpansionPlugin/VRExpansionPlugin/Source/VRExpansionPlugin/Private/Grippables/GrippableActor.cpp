@@ -11,6 +11,7 @@
 #include "GripMotionControllerComponent.h"
 #include "VRExpansionFunctionLibrary.h"
 #include "Misc/BucketUpdateSubsystem.h"
+#include "VRPlayerController.h"
 #include "GripScripts/VRGripScriptBase.h"
 #include "DrawDebugHelpers.h"
 
@@ -393,8 +394,10 @@ bool AGrippableActor::AddToClientReplicationBucket()
 {
 	if (ShouldWeSkipAttachmentReplication(false))
 	{
-		// The subsystem automatically removes entries with the same function signature so its safe to just always add here
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->AddObjectToBucket(ClientAuthReplicationData.UpdateRate, this, FName(TEXT("PollReplicationEvent")));
+		// Replace any existing entry, the native path skips the reflection call every poll
+		UBucketUpdateSubsystem* BucketSubsystem = GetWorld()->GetSubsystem<UBucketUpdateSubsystem>();
+		BucketSubsystem->RemoveFromBucket(ClientAuthReplicationData.BucketUpdateHandle);
+		ClientAuthReplicationData.BucketUpdateHandle = BucketSubsystem->AddUObjectToBucket(ClientAuthReplicationData.UpdateRate, this, &AGrippableActor::PollReplicationEvent);
 		ClientAuthReplicationData.bIsCurrentlyClientAuth = true;
 
 		if (UWorld * World = GetWorld())
@@ -410,7 +413,7 @@ bool AGrippableActor::RemoveFromClientReplicationBucket()
 {
 	if (ClientAuthReplicationData.bIsCurrentlyClientAuth)
 	{
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveObjectFromBucketByFunctionName(this, FName(TEXT("PollReplicationEvent")));
+		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveFromBucket(ClientAuthReplicationData.BucketUpdateHandle);
 		CeaseReplicationBlocking();
 		return true;
 	}
@@ -509,7 +512,11 @@ bool AGrippableActor::PollReplicationEvent()
 					FRepMovementVR ClientAuthMovementRep;
 					if (ClientAuthMovementRep.GatherActorsMovement(this))
 					{
-						Server_GetClientAuthReplication(ClientAuthMovementRep);
+						// Batched with the rest of our connections client auth movements if possible
+						if (!AVRBasePlayerController::QueueClientAuthMovement(this, ClientAuthMovementRep, ++ClientAuthReplicationData.MovementSequence))
+						{
+							Server_GetClientAuthReplication(ClientAuthMovementRep);
+						}
 
 						if (PrimComp->RigidBodyIsAwake())
 						{
@@ -567,6 +574,14 @@ bool AGrippableActor::PollReplicationEvent()
 		CeaseReplicationBlocking();
 	}
 
+	// A movement still waiting in the controllers batch would be applied after the end call and re-add the replication target
+	// send it on our own channel ahead of it instead
+	FRepMovementVR PendingMovementRep;
+	if (AVRBasePlayerController::RemoveQueuedClientAuthMovement(this, PendingMovementRep))
+	{
+		Server_GetClientAuthReplication(PendingMovementRep);
+	}
+
 	// Tell server to kill us
 	Server_EndClientAuthReplication();
 	return false; // Tell the bucket subsystem to remove us from consideration
@@ -645,6 +660,14 @@ void AGrippableActor::Server_GetClientAuthReplication_Implementation(const FRepM
 	}
 }
 
+void AGrippableActor::ApplyBatchedClientAuthMovement(const FRepMovementVR& newMovement, uint16 Sequence, const AActor* Sender)
+{
+	if (ClientAuthReplicationData.ConsumeMovementSequence(Sequence, Sender))
+	{
+		Server_GetClientAuthReplication_Implementation(newMovement);
+	}
+}
+
 void AGrippableActor::OnRep_ReplicateMovement()
 {
 	if (bAllowIgnoringAttachOnOwner && (ClientAuthReplicationData.bIsCurrentlyClientAuth || ShouldWeSkipAttachmentReplication()))
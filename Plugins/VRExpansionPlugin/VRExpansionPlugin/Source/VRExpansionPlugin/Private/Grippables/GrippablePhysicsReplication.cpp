@@ -37,6 +37,59 @@
 #include "Engine/Player.h"
 //#include "PhysicsInterfaceTypesCore.h"
 
+DECLARE_CYCLE_STAT(TEXT("VRPhysicsReplication ~ Prioritize Targets"), STAT_VRPhysicsReplicationPrioritize, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRPhysicsReplication ~ Full Updates"), STAT_VRPhysicsReplicationFullUpdates, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRPhysicsReplication ~ Deferred Updates"), STAT_VRPhysicsReplicationDeferredUpdates, STATGROUP_Game);
+
+  // CVars
+namespace VRPhysicsReplicationCvars
+{
+	static bool bUseOwnerPing = true;
+	FAutoConsoleVariableRef CVarUseOwnerPing(
+		TEXT("vr.PhysicsReplication.UseOwnerPing"),
+		bUseOwnerPing,
+		TEXT("If true the server extrapolates client owned replicated targets by half of the owning connections ping.\n")
+		TEXT("The result is still clamped by p.NetPingLimit."),
+		ECVF_Default);
+
+	static int32 MaxFullUpdatesPerFrame = 0;
+	FAutoConsoleVariableRef CVarMaxFullUpdatesPerFrame(
+		TEXT("vr.PhysicsReplication.MaxFullUpdatesPerFrame"),
+		MaxFullUpdatesPerFrame,
+		TEXT("Max number of bodies that get a full replication correction per frame on the server, 0 is unlimited.\n")
+		TEXT("The rest keep simulating with their current velocity and are corrected on a later frame, highest priority first."),
+		ECVF_Default);
+
+	static float MaxDeferSeconds = 0.25f;
+	FAutoConsoleVariableRef CVarMaxDeferSeconds(
+		TEXT("vr.PhysicsReplication.MaxDeferSeconds"),
+		MaxDeferSeconds,
+		TEXT("Bodies that have not had a full update in this many seconds are moved to the front of the budget.\n")
+		TEXT("Keeps low priority bodies from starving when the budget is saturated."),
+		ECVF_Default);
+
+	static float PriorityReferenceDistance = 1000.0f;
+	FAutoConsoleVariableRef CVarPriorityReferenceDistance(
+		TEXT("vr.PhysicsReplication.PriorityReferenceDistance"),
+		PriorityReferenceDistance,
+		TEXT("Distance from the nearest player view at which a body loses half of its distance priority."),
+		ECVF_Default);
+
+	static float PriorityReferenceVelocity = 500.0f;
+	FAutoConsoleVariableRef CVarPriorityReferenceVelocity(
+		TEXT("vr.PhysicsReplication.PriorityReferenceVelocity"),
+		PriorityReferenceVelocity,
+		TEXT("Linear velocity at which a body gets the full velocity priority."),
+		ECVF_Default);
+
+	static float RecentInteractionSeconds = 1.0f;
+	FAutoConsoleVariableRef CVarRecentInteractionSeconds(
+		TEXT("vr.PhysicsReplication.RecentInteractionSeconds"),
+		RecentInteractionSeconds,
+		TEXT("Bodies that received a new target within this many seconds (held or just thrown) are boosted in priority."),
+		ECVF_Default);
+}
+
 // I cannot dynamic cast without RTTI so I am using a static var as a declarative in case the user removed our custom replicator
 // We don't want our casts to cause issues.
 namespace VRPhysicsReplicationStatics
@@ -386,7 +439,7 @@ void FPhysicsReplicationVR::SetReplicatedTarget(UPrimitiveComponent* Component,
 		if (bIsSimulated || bIsReplicatedAutonomous)
 		{
 			Chaos::FConstPhysicsObjectHandle PhysicsObject = Component->GetPhysicsObjectByName(BoneName);
-			SetReplicatedTargetVR(PhysicsObject, ReplicatedTarget, ServerFrame, Owner->GetPhysicsReplicationMode());
+			SetReplicatedTargetVR(PhysicsObject, ReplicatedTarget, ServerFrame, Owner->GetPhysicsReplicationMode(), GetOwnerPingVR(Owner));
 			return;
 		}
 	}
@@ -419,7 +472,7 @@ void FPhysicsReplicationVR::SetReplicatedTarget(UPrimitiveComponent* Component,
 	}
 }
 
-void FPhysicsReplicationVR::SetReplicatedTargetVR(Chaos::FConstPhysicsObjectHandle PhysicsObject, const FRigidBodyState& ReplicatedTarget, int32 ServerFrame, EPhysicsReplicationMode ReplicationMode)
+void FPhysicsReplicationVR::SetReplicatedTargetVR(Chaos::FConstPhysicsObjectHandle PhysicsObject, const FRigidBodyState& ReplicatedTarget, int32 ServerFrame, EPhysicsReplicationMode ReplicationMode, float OwnerPing)
 {
 
 	// Skip all of the custom logic if we aren't the server
@@ -454,6 +507,7 @@ void FPhysicsReplicationVR::SetReplicatedTargetVR(Chaos::FConstPhysicsObjectHand
 	ensure(!Target.TargetState.Position.ContainsNaN());
 
 	ReplicatedTargetsQueueVR.Add(Target);
+	ReplicatedTargetsQueueOwnerPingVR.Add(OwnerPing);
 }
 
 void FPhysicsReplicationVR::RemoveReplicatedTarget(UPrimitiveComponent* Component)
@@ -478,6 +532,7 @@ void FPhysicsReplicationVR::RemoveReplicatedTarget(UPrimitiveComponent* Componen
 
 	// Remove from legacy flow
 	ComponentToTargetsVR_DEPRECATED.Remove(Component);
+	LastFullUpdateTimeVR.Remove(Component);
 
 	// Remove from FPhysicsObject flow
 	Chaos::FConstPhysicsObjectHandle PhysicsObject = Component->GetPhysicsObjectByName(NAME_None);
@@ -505,6 +560,101 @@ void FPhysicsReplicationVR::RemoveReplicatedTargetVR(Chaos::FConstPhysicsObjectH
 
 	FReplicatedPhysicsTarget Target(PhysicsObject); // This creates a new but empty target and when it tries to update the current target in the async flow it will remove it from replication since it's empty.
 	ReplicatedTargetsQueueVR.Add(Target);
+	ReplicatedTargetsQueueOwnerPingVR.Add(0.0f);
+}
+
+float FPhysicsReplicationVR::GetOwnerPingVR(AActor* OwningActor)
+{
+	// Get the ping of this thing's owner. If nobody owns it,
+	// then it's server authoritative.
+	if (!VRPhysicsReplicationCvars::bUseOwnerPing || !OwningActor)
+	{
+		return 0.0f;
+	}
+
+	if (UPlayer* OwningPlayer = OwningActor->GetNetOwningPlayer())
+	{
+		if (APlayerController* PlayerController = OwningPlayer->GetPlayerController(nullptr))
+		{
+			// The listen server host has no latency to itself
+			if (PlayerController->IsLocalController())
+			{
+				return 0.0f;
+			}
+
+			if (APlayerState* PlayerState = PlayerController->PlayerState)
+			{
+				return PlayerState->ExactPing;
+			}
+		}
+	}
+
+	return 0.0f;
+}
+
+void FPhysicsReplicationVR::PrioritizeUpdateCandidates(UWorld* World, double CurrentTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VRPhysicsReplicationPrioritize);
+
+	// On the server we don't have a single local view, use the closest of all of the players views
+	ViewLocationsVR.Reset();
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocationsVR.Add(ViewLocation);
+		}
+	}
+
+	const float ReferenceDistance = FMath::Max(VRPhysicsReplicationCvars::PriorityReferenceDistance, 1.0f);
+	const float ReferenceVelocity = FMath::Max(VRPhysicsReplicationCvars::PriorityReferenceVelocity, 1.0f);
+	const float RecentInteractionSeconds = FMath::Max(VRPhysicsReplicationCvars::RecentInteractionSeconds, KINDA_SMALL_NUMBER);
+	const float MaxDeferSeconds = FMath::Max(VRPhysicsReplicationCvars::MaxDeferSeconds, KINDA_SMALL_NUMBER);
+
+	for (FVRPhysicsReplicationCandidate& Candidate : UpdateCandidatesVR)
+	{
+		const FRigidBodyState& TargetState = Candidate.PhysicsTarget->TargetState;
+		float Priority = 0.0f;
+
+		// Distance to the nearest view, 1 when on top of it falling off to 0.5 at the reference distance
+		if (ViewLocationsVR.Num() > 0)
+		{
+			double ClosestDistSq = TNumericLimits<double>::Max();
+			for (const FVector& ViewLocation : ViewLocationsVR)
+			{
+				ClosestDistSq = FMath::Min(ClosestDistSq, FVector::DistSquared(ViewLocation, TargetState.Position));
+			}
+
+			Priority += 1.0f / (1.0f + (float)FMath::Sqrt(ClosestDistSq) / ReferenceDistance);
+		}
+
+		// Fast bodies drift the furthest when they are not corrected
+		Priority += FMath::Min((float)TargetState.LinVel.Size() / ReferenceVelocity, 1.0f);
+
+		// Bodies with fresh targets are being held or were just thrown
+		const float TimeSinceArrived = (float)(CurrentTime - Candidate.PhysicsTarget->ArrivedTimeSeconds);
+		Priority += 2.0f * FMath::Clamp(1.0f - (TimeSinceArrived / RecentInteractionSeconds), 0.0f, 1.0f);
+
+		// Age in the time since the last full update so that nothing starves
+		const double* LastFullUpdateTime = LastFullUpdateTimeVR.Find(Candidate.PrimComp);
+		const float TimeSinceUpdate = LastFullUpdateTime ? (float)(CurrentTime - *LastFullUpdateTime) : MaxDeferSeconds;
+		Priority += TimeSinceUpdate / MaxDeferSeconds;
+
+		if (TimeSinceUpdate >= MaxDeferSeconds)
+		{
+			Priority += 100.0f;
+		}
+
+		Candidate.Priority = Priority;
+	}
+
+	UpdateCandidatesVR.Sort([](const FVRPhysicsReplicationCandidate& A, const FVRPhysicsReplicationCandidate& B)
+	{
+		return A.Priority > B.Priority;
+	});
 }
 
 bool FPhysicsReplicationVR::ApplyRigidBodyState(float DeltaSeconds, FBodyInstance* BI, FReplicatedPhysicsTarget& PhysicsTarget, const FRigidBodyErrorCorrection& ErrorCorrection, const float PingSecondsOneWay, bool* bDidHardSnap)
@@ -955,19 +1105,21 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 	// Get the ping between this PC & the server
 	const float LocalPing = 0.0f;//GetLocalPing();
 
+	UWorld* OwningWorld = GetOwningWorld();
+	const double CurrentTime = OwningWorld ? OwningWorld->GetTimeSeconds() : 0.0;
+
+	// Gather the targets that need updating first so that they can be budgeted
+	UpdateCandidatesVR.Reset();
 	for (auto Itr = ComponentsToTargets.CreateIterator(); Itr; ++Itr)
 	{
-		bool bRemoveItr = false;
 		if (UPrimitiveComponent* PrimComp = Itr.Key().Get())
 		{		
 			if (PrimComp->GetAttachParent() == nullptr)
 			{
-				if (FBodyInstance* BI = PrimComp->GetBodyInstance(Itr.Value().BoneName))
+				FReplicatedPhysicsTarget& PhysicsTarget = Itr.Value();
+				if (PhysicsTarget.TargetState.Flags & ERigidBodyFlags::NeedsUpdate)
 				{
-					FReplicatedPhysicsTarget& PhysicsTarget = Itr.Value();
-					FRigidBodyState& UpdatedState = PhysicsTarget.TargetState;
-					bool bUpdated = false;
-					if (AActor* OwningActor = PrimComp->GetOwner())
+					if (FBodyInstance* BI = PrimComp->GetBodyInstance(PhysicsTarget.BoneName))
 					{
 						// Removed as this is server sided
 						/*
@@ -980,69 +1132,88 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 						if (bIsSimulated || bIsReplicatedAutonomous)*/
 
 						// Deleted everything here, we will always be the server, I already filtered out clients to default logic
+						if (AActor* OwningActor = PrimComp->GetOwner())
 						{
-							// Get the ping of this thing's owner. If nobody owns it,
-							// then it's server authoritative.
-							/*const*/ float OwnerPing = 0.0f;// GetOwnerPing(OwningActor, PhysicsTarget);
-
-							/*if (UPlayer* OwningPlayer = OwningActor->GetNetOwningPlayer())
-							{
-								if (APlayerController* PlayerController = OwningPlayer->GetPlayerController(nullptr))
-								{
-									if (APlayerState* PlayerState = PlayerController->PlayerState)
-									{
-										OwnerPing = PlayerState->ExactPing;
-									}
-								}
-							}*/
-
-							// Get the total ping - this approximates the time since the update was
-							// actually generated on the machine that is doing the authoritative sim.
-							// NOTE: We divide by 2 to approximate 1-way ping from 2-way ping.
-							const float PingSecondsOneWay = 0.0f;// (LocalPing + OwnerPing) * 0.5f * 0.001f;
-
-							if (UpdatedState.Flags & ERigidBodyFlags::NeedsUpdate)
-							{
-								const int32 LocalFrame = PhysicsTarget.ServerFrame - NetworkPhysicsTickOffsetVR;
-								const bool bRestoredState = ApplyRigidBodyState(DeltaSeconds, BI, PhysicsTarget, PhysicErrorCorrection, PingSecondsOneWay, LocalFrame, 0);
-
-								// Need to update the component to match new position.
-								static const auto CVarSkipSkeletalRepOptimization = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipSkeletalRepOptimization"));
-								if (/*PhysicsReplicationCVars::SkipSkeletalRepOptimization*/CVarSkipSkeletalRepOptimization->GetInt() == 0 || Cast<USkeletalMeshComponent>(PrimComp) == nullptr)	//simulated skeletal mesh does its own polling of physics results so we don't need to call this as it'll happen at the end of the physics sim
-								{
-									PrimComp->SyncComponentToRBPhysics();
-								}
-								if (bRestoredState)
-								{
-									bRemoveItr = true;
-								}
-							}
+							UpdateCandidatesVR.Emplace(PrimComp, BI, &PhysicsTarget, GetOwnerPingVR(OwningActor));
 						}
 					}
 				}
 			}
 		}
+	}
 
-		if (bRemoveItr)
+	// With hundreds of simulating props only the most important ones get a full correction each frame, the rest
+	// keep simulating on their current velocity until their turn comes around
+	int32 NumFullUpdates = UpdateCandidatesVR.Num();
+	const int32 MaxFullUpdates = VRPhysicsReplicationCvars::MaxFullUpdatesPerFrame;
+	if (MaxFullUpdates > 0 && NumFullUpdates > MaxFullUpdates && OwningWorld)
+	{
+		PrioritizeUpdateCandidates(OwningWorld, CurrentTime);
+		NumFullUpdates = MaxFullUpdates;
+	}
+
+	INC_DWORD_STAT_BY(STAT_VRPhysicsReplicationFullUpdates, NumFullUpdates);
+	INC_DWORD_STAT_BY(STAT_VRPhysicsReplicationDeferredUpdates, UpdateCandidatesVR.Num() - NumFullUpdates);
+
+	static const auto CVarSkipSkeletalRepOptimization = IConsoleManager::Get().FindConsoleVariable(TEXT("p.SkipSkeletalRepOptimization"));
+	for (int32 CandidateIndex = 0; CandidateIndex < NumFullUpdates; ++CandidateIndex)
+	{
+		FVRPhysicsReplicationCandidate& Candidate = UpdateCandidatesVR[CandidateIndex];
+		FReplicatedPhysicsTarget& PhysicsTarget = *Candidate.PhysicsTarget;
+
+		// Get the total ping - this approximates the time since the update was
+		// actually generated on the machine that is doing the authoritative sim.
+		// NOTE: We divide by 2 to approximate 1-way ping from 2-way ping.
+		const float PingSecondsOneWay = (LocalPing + Candidate.OwnerPing) * 0.5f * 0.001f;
+
+		const int32 LocalFrame = PhysicsTarget.ServerFrame - NetworkPhysicsTickOffsetVR;
+		const bool bRestoredState = ApplyRigidBodyState(DeltaSeconds, Candidate.BI, PhysicsTarget, PhysicErrorCorrection, PingSecondsOneWay, LocalFrame, 0);
+
+		// Need to update the component to match new position.
+		if (/*PhysicsReplicationCVars::SkipSkeletalRepOptimization*/CVarSkipSkeletalRepOptimization->GetInt() == 0 || Cast<USkeletalMeshComponent>(Candidate.PrimComp) == nullptr)	//simulated skeletal mesh does its own polling of physics results so we don't need to call this as it'll happen at the end of the physics sim
+		{
+			Candidate.PrimComp->SyncComponentToRBPhysics();
+		}
+
+		if (bRestoredState)
 		{
-			OnTargetRestored(Itr.Key().Get(), Itr.Value());
-			PendingDeleteFromComponentsToTargetsVR.Add(Itr.Key());
-			//Itr.RemoveCurrent();
+			OnTargetRestored(Candidate.PrimComp, PhysicsTarget);
+			PendingDeleteFromComponentsToTargetsVR.Add(Candidate.PrimComp);
+		}
+		else if (MaxFullUpdates > 0)
+		{
+			LastFullUpdateTimeVR.Add(Candidate.PrimComp, CurrentTime);
 		}
 	}
+	UpdateCandidatesVR.Reset();
 
 	for (TWeakObjectPtr<UPrimitiveComponent>& PrimitiveComponent : PendingDeleteFromComponentsToTargetsVR)
 	{
 		ComponentsToTargets.Remove(PrimitiveComponent);
+		LastFullUpdateTimeVR.Remove(PrimitiveComponent);
 	}
 	PendingDeleteFromComponentsToTargetsVR.Reset();
 
+	// Drop timestamps of targets that were removed out from under us
+	if (LastFullUpdateTimeVR.Num() > ComponentsToTargets.Num())
+	{
+		for (auto Itr = LastFullUpdateTimeVR.CreateIterator(); Itr; ++Itr)
+		{
+			if (!ComponentsToTargets.Contains(Itr.Key()))
+			{
+				Itr.RemoveCurrent();
+			}
+		}
+	}
+
 	if (AsyncInputVR)
 	{
 		// PhysicsObject replication flow
-		for (FReplicatedPhysicsTarget& PhysicsTarget : ReplicatedTargetsQueueVR)
+		check(ReplicatedTargetsQueueOwnerPingVR.Num() == ReplicatedTargetsQueueVR.Num());
+		for (int32 TargetIndex = 0; TargetIndex < ReplicatedTargetsQueueVR.Num(); ++TargetIndex)
 		{
-			const float PingSecondsOneWay = LocalPing * 0.5f * 0.001f;
+			FReplicatedPhysicsTarget& PhysicsTarget = ReplicatedTargetsQueueVR[TargetIndex];
+			const float PingSecondsOneWay = (LocalPing + ReplicatedTargetsQueueOwnerPingVR[TargetIndex]) * 0.5f * 0.001f;
 
 
 			// Queue up the target state for async replication
@@ -1057,6 +1228,7 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 		}
 	}
 	ReplicatedTargetsQueueVR.Reset();
+	ReplicatedTargetsQueueOwnerPingVR.Reset();
 
 	AsyncInputVR = nullptr;
 }
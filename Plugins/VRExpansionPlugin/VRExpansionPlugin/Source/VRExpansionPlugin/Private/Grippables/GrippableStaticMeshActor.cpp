@@ -9,6 +9,7 @@
 #include "GripMotionControllerComponent.h"
 #include "VRExpansionFunctionLibrary.h"
 #include "Misc/BucketUpdateSubsystem.h"
+#include "VRPlayerController.h"
 #include "Net/UnrealNetwork.h"
 #include "PhysicsReplication.h"
 #include "GripScripts/VRGripScriptBase.h"
@@ -372,8 +373,10 @@ bool AGrippableStaticMeshActor::AddToClientReplicationBucket()
 {
 	if (ShouldWeSkipAttachmentReplication(false))
 	{
-		// The subsystem automatically removes entries with the same function signature so its safe to just always add here
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->AddObjectToBucket(ClientAuthReplicationData.UpdateRate, this, FName(TEXT("PollReplicationEvent")));
+		// Replace any existing entry, the native path skips the reflection call every poll
+		UBucketUpdateSubsystem* BucketSubsystem = GetWorld()->GetSubsystem<UBucketUpdateSubsystem>();
+		BucketSubsystem->RemoveFromBucket(ClientAuthReplicationData.BucketUpdateHandle);
+		ClientAuthReplicationData.BucketUpdateHandle = BucketSubsystem->AddUObjectToBucket(ClientAuthReplicationData.UpdateRate, this, &AGrippableStaticMeshActor::PollReplicationEvent);
 		ClientAuthReplicationData.bIsCurrentlyClientAuth = true;
 
 		if (UWorld * World = GetWorld())
@@ -389,7 +392,7 @@ bool AGrippableStaticMeshActor::RemoveFromClientReplicationBucket()
 {
 	if (ClientAuthReplicationData.bIsCurrentlyClientAuth)
 	{
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveObjectFromBucketByFunctionName(this, FName(TEXT("PollReplicationEvent")));
+		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveFromBucket(ClientAuthReplicationData.BucketUpdateHandle);
 		CeaseReplicationBlocking();
 		return true;
 	}
@@ -483,7 +486,11 @@ bool AGrippableStaticMeshActor::PollReplicationEvent()
 					FRepMovementVR ClientAuthMovementRep;
 					if (ClientAuthMovementRep.GatherActorsMovement(this))
 					{
-						Server_GetClientAuthReplication(ClientAuthMovementRep);
+						// Batched with the rest of our connections client auth movements if possible
+						if (!AVRBasePlayerController::QueueClientAuthMovement(this, ClientAuthMovementRep, ++ClientAuthReplicationData.MovementSequence))
+						{
+							Server_GetClientAuthReplication(ClientAuthMovementRep);
+						}
 
 						if (PrimComp->RigidBodyIsAwake())
 						{
@@ -541,6 +548,14 @@ bool AGrippableStaticMeshActor::PollReplicationEvent()
 		CeaseReplicationBlocking();
 	}
 
+	// A movement still waiting in the controllers batch would be applied after the end call and re-add the replication target
+	// send it on our own channel ahead of it instead
+	FRepMovementVR PendingMovementRep;
+	if (AVRBasePlayerController::RemoveQueuedClientAuthMovement(this, PendingMovementRep))
+	{
+		Server_GetClientAuthReplication(PendingMovementRep);
+	}
+
 	// Tell server to kill us
 	Server_EndClientAuthReplication();
 	return false; // Tell the bucket subsystem to remove us from consideration
@@ -615,6 +630,14 @@ void AGrippableStaticMeshActor::Server_GetClientAuthReplication_Implementation(c
 	}
 }
 
+void AGrippableStaticMeshActor::ApplyBatchedClientAuthMovement(const FRepMovementVR& newMovement, uint16 Sequence, const AActor* Sender)
+{
+	if (ClientAuthReplicationData.ConsumeMovementSequence(Sequence, Sender))
+	{
+		Server_GetClientAuthReplication_Implementation(newMovement);
+	}
+}
+
 bool AGrippableStaticMeshActor::ShouldWeSkipAttachmentReplication(bool bConsiderHeld) const
 {
 	if ((bConsiderHeld && !VRGripInterfaceSettings.bWasHeld) || GetNetMode() < ENetMode::NM_Client)
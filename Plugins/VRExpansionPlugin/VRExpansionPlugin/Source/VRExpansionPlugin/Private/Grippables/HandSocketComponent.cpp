@@ -5,6 +5,8 @@
 
 #include "CoreMinimal.h"
 #include "UObject/UObjectIterator.h"
+#include "Engine/Engine.h"
+#include "Misc/HandSocketRegistrySubsystem.h"
 #include "Engine/CollisionProfile.h"
 #include "BoneContainer.h"
 #include "Animation/AnimSequence.h"
@@ -60,6 +62,9 @@ UHandSocketComponent::UHandSocketComponent(const FObjectInitializer& ObjectIniti
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 	// Setting absolute scale so we don't have to care about our parents scale
 	this->SetUsingAbsoluteScale(true); 
+
+	// Needed for OnUpdateTransform to keep our cell in the hand socket registry current as we move
+	bWantsOnUpdateTransform = true;
 	//this->bReplicates = true;
 
 	bRepGameplayTags = true;
@@ -100,65 +105,58 @@ UAnimSequence* UHandSocketComponent::GetTargetAnimation()
 	return HandTargetAnimation;
 }
 
-void UHandSocketComponent::GetAllHandSocketComponents(TArray<UHandSocketComponent*>& OutHandSockets)
+// The static queries have no world context, so they run against the registry of every active world
+template<typename FuncType>
+static void ForEachHandSocketRegistry(FuncType&& Func)
 {
-	for (TObjectIterator<UHandSocketComponent> It; It; ++It)
+	if (!GEngine)
+		return;
+
+	for (const FWorldContext& Context : GEngine->GetWorldContexts())
 	{
-		UHandSocketComponent* HandSocket = *It;
-		if (IsValid(HandSocket) && !HandSocket->IsTemplate())
+		if (UWorld* World = Context.World())
 		{
-			OutHandSockets.Add(HandSocket);
+			if (UHandSocketRegistrySubsystem* Registry = World->GetSubsystem<UHandSocketRegistrySubsystem>())
+			{
+				Func(*Registry);
+			}
 		}
 	}
 }
 
-bool UHandSocketComponent::GetAllHandSocketComponentsInRange(FVector SearchFromWorldLocation, float SearchRange, TArray<UHandSocketComponent*>& OutHandSockets)
+void UHandSocketComponent::GetAllHandSocketComponents(TArray<UHandSocketComponent*>& OutHandSockets)
 {
-	float SearchDistSq = FMath::Square(SearchRange);
+	ForEachHandSocketRegistry([&](const UHandSocketRegistrySubsystem& Registry)
+	{
+		Registry.GetAllHandSockets(OutHandSockets);
+	});
+}
 
-	UHandSocketComponent* HandSocket = nullptr;
-	FTransform HandSocketTrans;
-	for (TObjectIterator<UHandSocketComponent> It; It; ++It)
+bool UHandSocketComponent::GetAllHandSocketComponentsInRange(FVector SearchFromWorldLocation, float SearchRange, TArray<UHandSocketComponent*>& OutHandSockets)
+{
+	ForEachHandSocketRegistry([&](const UHandSocketRegistrySubsystem& Registry)
 	{
-		HandSocket = *It;
-		if (IsValid(HandSocket) && !HandSocket->IsTemplate())
-		{
-			HandSocketTrans = HandSocket->GetRelativeTransform() * HandSocket->GetOwner()->GetActorTransform();
-			if (FVector::DistSquared(HandSocketTrans.GetLocation(), SearchFromWorldLocation) <= SearchDistSq)
-			{
-				OutHandSockets.Add(HandSocket);
-			}
-		}
-	}
+		Registry.GetHandSocketsInRange(SearchFromWorldLocation, SearchRange, OutHandSockets);
+	});
 
 	return OutHandSockets.Num() > 0;
 }
 
 UHandSocketComponent* UHandSocketComponent::GetClosestHandSocketComponentInRange(FVector SearchFromWorldLocation, float SearchRange)
 {
-	float SearchDistSq = FMath::Square(SearchRange);
 	UHandSocketComponent* ClosestHandSocket = nullptr;
 	float LastDist = 0.0f;
-	float DistSq = 0.0f;
 
-	bool bFoundOne = false;
-	UHandSocketComponent* HandSocket = nullptr;
-	FTransform HandSocketTrans;
-	for (TObjectIterator<UHandSocketComponent> It; It; ++It)
+	ForEachHandSocketRegistry([&](const UHandSocketRegistrySubsystem& Registry)
 	{
-		HandSocket = *It;
-		if (IsValid(HandSocket) && !HandSocket->IsTemplate())
+		float DistSq = 0.0f;
+		UHandSocketComponent* HandSocket = Registry.GetClosestHandSocketInRange(SearchFromWorldLocation, SearchRange, DistSq);
+		if (HandSocket && (!ClosestHandSocket || DistSq < LastDist))
 		{
-			HandSocketTrans = HandSocket->GetRelativeTransform() * HandSocket->GetOwner()->GetActorTransform();
-			DistSq = FVector::DistSquared(HandSocketTrans.GetLocation(), SearchFromWorldLocation);
-			if (DistSq <= SearchDistSq && (!bFoundOne || DistSq < LastDist))
-			{
-				bFoundOne = true;
-				ClosestHandSocket = HandSocket;
-				LastDist = DistSq;
-			}
+			ClosestHandSocket = HandSocket;
+			LastDist = DistSq;
 		}
-	}
+	});
 
 	return ClosestHandSocket;
 }
@@ -733,6 +731,98 @@ void UHandSocketComponent::OnRegister()
 	}
 
 	Super::OnRegister();
+
+	RegisterWithHandSocketRegistry();
+}
+
+void UHandSocketComponent::OnUnregister()
+{
+	UnregisterFromHandSocketRegistry();
+
+	Super::OnUnregister();
+}
+
+void UHandSocketComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	if (bRegisteredWithHandSocketRegistry)
+	{
+		if (UWorld* MyWorld = GetWorld())
+		{
+			if (UHandSocketRegistrySubsystem* Registry = MyWorld->GetSubsystem<UHandSocketRegistrySubsystem>())
+			{
+				Registry->UpdateHandSocket(this);
+			}
+		}
+	}
+}
+
+void UHandSocketComponent::RegisterWithHandSocketRegistry()
+{
+	if (bRegisteredWithHandSocketRegistry || IsTemplate())
+		return;
+
+	UWorld* MyWorld = GetWorld();
+	UHandSocketRegistrySubsystem* Registry = MyWorld ? MyWorld->GetSubsystem<UHandSocketRegistrySubsystem>() : nullptr;
+
+	if (!Registry)
+		return;
+
+	Registry->RegisterHandSocket(this);
+	bRegisteredWithHandSocketRegistry = true;
+
+	// Absolute sockets don't receive transform updates from their parents, watch the actor root so the index stays current
+	if (IsUsingAbsoluteLocation())
+	{
+		if (AActor* MyOwner = GetOwner())
+		{
+			USceneComponent* OwnerRoot = MyOwner->GetRootComponent();
+			if (OwnerRoot && OwnerRoot != this)
+			{
+				RootTransformUpdatedHandle = OwnerRoot->TransformUpdated.AddUObject(this, &UHandSocketComponent::OnOwnerRootTransformUpdated);
+				RegistryTrackedRoot = OwnerRoot;
+			}
+		}
+	}
+}
+
+void UHandSocketComponent::UnregisterFromHandSocketRegistry()
+{
+	if (USceneComponent* OwnerRoot = RegistryTrackedRoot.Get())
+	{
+		OwnerRoot->TransformUpdated.Remove(RootTransformUpdatedHandle);
+	}
+
+	RegistryTrackedRoot.Reset();
+	RootTransformUpdatedHandle.Reset();
+
+	if (!bRegisteredWithHandSocketRegistry)
+		return;
+
+	bRegisteredWithHandSocketRegistry = false;
+
+	if (UWorld* MyWorld = GetWorld())
+	{
+		if (UHandSocketRegistrySubsystem* Registry = MyWorld->GetSubsystem<UHandSocketRegistrySubsystem>())
+		{
+			Registry->UnregisterHandSocket(this);
+		}
+	}
+}
+
+void UHandSocketComponent::OnOwnerRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (bRegisteredWithHandSocketRegistry)
+	{
+		if (UWorld* MyWorld = GetWorld())
+		{
+			if (UHandSocketRegistrySubsystem* Registry = MyWorld->GetSubsystem<UHandSocketRegistrySubsystem>())
+			{
+				Registry->UpdateHandSocket(this);
+			}
+		}
+	}
 }
 
 #if WITH_EDITORONLY_DATA
@@ -3,6 +3,28 @@
 #include "Misc/BucketUpdateSubsystem.h"
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BucketUpdateSubsystem)
 
+#include "HAL/IConsoleManager.h"
+
+  // CVars
+namespace BucketUpdateCvars
+{
+	static int32 SpreadBucketUpdates = 0;
+	FAutoConsoleVariableRef CVarSpreadBucketUpdates(
+		TEXT("vr.BucketUpdates.Spread"),
+		SpreadBucketUpdates,
+		TEXT("If 1 then bucket update callbacks are spread evenly across frames instead of all firing on the frame the bucket rate elapses.\n")
+		TEXT("Each callback still runs at its bucket rate but at its own phase offset, so many objects at the same rate cost a flat slice every frame instead of a spike."),
+		ECVF_Default);
+
+	static int32 MaxCallbacksPerBucketPerFrame = 0;
+	FAutoConsoleVariableRef CVarMaxCallbacksPerBucketPerFrame(
+		TEXT("vr.BucketUpdates.MaxCallbacksPerBucketPerFrame"),
+		MaxCallbacksPerBucketPerFrame,
+		TEXT("When spreading bucket updates, the max number of callbacks a single bucket can run in one frame, 0 is unlimited.\n")
+		TEXT("Callbacks over the budget are deferred to the following frames, the bucket will fall behind its rate if this is set too low."),
+		ECVF_Default);
+}
+
 	bool UBucketUpdateSubsystem::AddObjectToBucket(int32 UpdateHTZ, UObject* InObject, FName FunctionName)
 	{
 		if (!InObject || UpdateHTZ < 1)
@@ -28,6 +50,29 @@
 		return BucketContainer.AddBucketObject(UpdateHTZ, Delegate);
 	}
 
+	FBucketUpdateHandle UBucketUpdateSubsystem::AddCallbackToBucket(int32 UpdateHTZ, FBucketUpdateTickSignature&& Callback)
+	{
+		if (!Callback.IsBound() || UpdateHTZ < 1)
+			return FBucketUpdateHandle();
+
+		return BucketContainer.AddBucketCallback(UpdateHTZ, MoveTemp(Callback));
+	}
+
+	bool UBucketUpdateSubsystem::RemoveFromBucket(FBucketUpdateHandle& Handle)
+	{
+		if (!Handle.IsValid())
+			return false;
+
+		bool bRemoved = BucketContainer.RemoveBucketCallback(Handle);
+		Handle.Invalidate();
+		return bRemoved;
+	}
+
+	bool UBucketUpdateSubsystem::IsHandleInBucket(const FBucketUpdateHandle& Handle) const
+	{
+		return BucketContainer.IsHandleInBucket(Handle);
+	}
+
 	bool UBucketUpdateSubsystem::RemoveObjectFromBucketByFunctionName(UObject* InObject, FName FunctionName)
 	{
 		if (!InObject)
@@ -136,15 +181,26 @@
 	FUpdateBucketDrop::FUpdateBucketDrop()
 	{
 		FunctionName = NAME_None;
+		HandleID = 0;
 	}
 
 	FUpdateBucketDrop::FUpdateBucketDrop(FDynamicBucketUpdateTickSignature & DynCallback)
 	{
 		DynamicCallback = DynCallback;
+		HandleID = 0;
+	}
+
+	FUpdateBucketDrop::FUpdateBucketDrop(FBucketUpdateTickSignature && Callback)
+	{
+		NativeCallback = MoveTemp(Callback);
+		FunctionName = NAME_None;
+		HandleID = 0;
 	}
 
 	FUpdateBucketDrop::FUpdateBucketDrop(UObject * Obj, FName FuncName)
 	{
+		HandleID = 0;
+
 		if (Obj && Obj->FindFunction(FuncName))
 		{
 			FunctionName = FuncName;
@@ -156,12 +212,25 @@
 		}
 	}
 	
-	bool FUpdateBucket::Update(float DeltaTime)
+	bool FUpdateBucket::Update(float DeltaTime, bool bSpreadUpdates, int32 MaxCallbacksPerFrame)
 	{
-		//#TODO: Need to consider batching / spreading out load if there are a lot of updating objects in the bucket
 		if (Callbacks.Num() < 1)
 			return false;
 
+		if (bSpreadUpdates)
+		{
+			UpdateSpread(DeltaTime, MaxCallbacksPerFrame);
+		}
+		else
+		{
+			UpdateAll(DeltaTime);
+		}
+
+		return Callbacks.Num() > 0;
+	}
+
+	void FUpdateBucket::UpdateAll(float DeltaTime)
+	{
 		// Check for if this bucket is ready to fire events
 		nUpdateCount += DeltaTime;
 		if (nUpdateCount >= nUpdateRate)
@@ -176,19 +245,113 @@
 				}
 
 				// Remove the callback, it is complete or invalid
-				Callbacks.RemoveAt(i);
+				RemoveCallbackAt(i);
 			}
 		}
+	}
 
-		return Callbacks.Num() > 0;
+	void FUpdateBucket::UpdateSpread(float DeltaTime, int32 MaxCallbacksPerFrame)
+	{
+		// Each callback gets its own slot in the update period, so every frame we run the share of the
+		// callbacks that fell within this frames delta. Fractional callbacks carry over to the next frame.
+		const int32 NumCallbacks = Callbacks.Num();
+		SpreadAccumulator += (DeltaTime / nUpdateRate) * NumCallbacks;
+
+		// Never fall more than a full cycle behind, a hitch shouldn't cause a burst of catch up frames
+		SpreadAccumulator = FMath::Min(SpreadAccumulator, (float)NumCallbacks);
+
+		int32 NumToRun = FMath::FloorToInt32(SpreadAccumulator);
+		if (MaxCallbacksPerFrame > 0)
+		{
+			NumToRun = FMath::Min(NumToRun, MaxCallbacksPerFrame);
+		}
+
+		if (NumToRun < 1)
+			return;
+
+		SpreadAccumulator -= NumToRun;
+
+		// Callbacks from StartIndex to the end run before the wrap, the ones before StartIndex after it
+		const int32 StartIndex = SpreadIndex < Callbacks.Num() ? SpreadIndex : 0;
+		SpreadIndex = StartIndex;
+		bool bWrapped = false;
+
+		// Each step either advances past a callback or swap removes it, which moves the last callback into the slot to run next
+		for (int32 Step = 0; Step < NumToRun && Callbacks.Num() > 0; ++Step)
+		{
+			if (SpreadIndex >= Callbacks.Num())
+			{
+				if (bWrapped)
+					break;
+
+				SpreadIndex = 0;
+				bWrapped = true;
+			}
+
+			// Every callback has been visited this frame
+			if (bWrapped && SpreadIndex >= StartIndex)
+				break;
+
+			if (Callbacks[SpreadIndex].ExecuteBoundCallback())
+			{
+				// If this returns true then we keep it in the queue
+				++SpreadIndex;
+				continue;
+			}
+
+			// After the wrap the last callback was already run this frame, skip over it once it is swapped into this slot
+			const bool bSwappedInWasVisited = bWrapped && (Callbacks.Num() - 1) >= StartIndex;
+
+			// Remove the callback, it is complete or invalid
+			RemoveCallbackAt(SpreadIndex);
+
+			if (bSwappedInWasVisited)
+			{
+				++SpreadIndex;
+			}
+		}
+	}
+
+	void FUpdateBucket::AddCallback(FUpdateBucketDrop && NewDrop, uint64 HandleID)
+	{
+		NewDrop.HandleID = HandleID;
+		HandleToIndex.Add(HandleID, Callbacks.Add(MoveTemp(NewDrop)));
+	}
+
+	void FUpdateBucket::RemoveCallbackAt(int32 Index)
+	{
+		HandleToIndex.Remove(Callbacks[Index].HandleID);
+
+		// The last callback is moved into this slot, when spreading it may wait an extra cycle if it lands behind the cursor
+		const int32 LastIndex = Callbacks.Num() - 1;
+		if (Index != LastIndex)
+		{
+			HandleToIndex.Add(Callbacks[LastIndex].HandleID, Index);
+		}
+
+		Callbacks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+
+	bool FUpdateBucket::RemoveCallbackByHandle(uint64 HandleID)
+	{
+		if (const int32* Index = HandleToIndex.Find(HandleID))
+		{
+			RemoveCallbackAt(*Index);
+			return true;
+		}
+
+		return false;
 	}
 	
 	void FUpdateBucketContainer::UpdateBuckets(float DeltaTime)
 	{
-		TArray<uint32> BucketsToRemove;
+		const bool bSpreadUpdates = BucketUpdateCvars::SpreadBucketUpdates > 0;
+		const int32 MaxCallbacksPerFrame = BucketUpdateCvars::MaxCallbacksPerBucketPerFrame;
+
+		BucketsToRemove.Reset();
 		for(auto& Bucket : ReplicationBuckets)
 		{		
-			if (!Bucket.Value.Update(DeltaTime))
+			if (!Bucket.Value.Update(DeltaTime, bSpreadUpdates, MaxCallbacksPerFrame))
 			{
 				// Add Bucket to list to remove at end of update
 				BucketsToRemove.Add(Bucket.Key);
@@ -213,18 +376,8 @@
 		// First verify that this object isn't already contained in a bucket, if it is then erase it so that we can replace it below
 		RemoveBucketObject(InObject, FunctionName);
 
-		if (ReplicationBuckets.Contains(UpdateHTZ))
-		{
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(InObject, FunctionName));
-		}
-		else
-		{
-			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(InObject, FunctionName));
-		}
-
-		if (ReplicationBuckets.Num() > 0)
-			bNeedsUpdate = true;
+		FindOrAddBucket(UpdateHTZ).AddCallback(FUpdateBucketDrop(InObject, FunctionName), ++LastHandleID);
+		bNeedsUpdate = true;
 
 		return true;
 	}
@@ -238,20 +391,63 @@
 		// First verify that this object isn't already contained in a bucket, if it is then erase it so that we can replace it below
 		RemoveBucketObject(Delegate);
 
-		if (ReplicationBuckets.Contains(UpdateHTZ))
+		FindOrAddBucket(UpdateHTZ).AddCallback(FUpdateBucketDrop(Delegate), ++LastHandleID);
+		bNeedsUpdate = true;
+
+		return true;
+	}
+
+	FBucketUpdateHandle FUpdateBucketContainer::AddBucketCallback(uint32 UpdateHTZ, FBucketUpdateTickSignature &&Callback)
+	{
+		FBucketUpdateHandle NewHandle;
+		if (!Callback.IsBound() || UpdateHTZ < 1)
+			return NewHandle;
+
+		// Native callbacks are identified by their handle, so unlike the other adds there is no searching for duplicates
+		NewHandle.ID = ++LastHandleID;
+		NewHandle.UpdateHTZ = UpdateHTZ;
+
+		FindOrAddBucket(UpdateHTZ).AddCallback(FUpdateBucketDrop(MoveTemp(Callback)), NewHandle.ID);
+		bNeedsUpdate = true;
+
+		return NewHandle;
+	}
+
+	FUpdateBucket& FUpdateBucketContainer::FindOrAddBucket(uint32 UpdateHTZ)
+	{
+		if (FUpdateBucket* Bucket = ReplicationBuckets.Find(UpdateHTZ))
 		{
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(Delegate));
+			return *Bucket;
 		}
-		else
+
+		return ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
+	}
+
+	bool FUpdateBucketContainer::RemoveBucketCallback(const FBucketUpdateHandle &Handle)
+	{
+		if (!Handle.IsValid())
+			return false;
+
+		// Empty buckets are cleaned up on the next update
+		if (FUpdateBucket* Bucket = ReplicationBuckets.Find(Handle.UpdateHTZ))
 		{
-			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(Delegate));
+			return Bucket->RemoveCallbackByHandle(Handle.ID);
 		}
 
-		if (ReplicationBuckets.Num() > 0)
-			bNeedsUpdate = true;
+		return false;
+	}
 
-		return true;
+	bool FUpdateBucketContainer::IsHandleInBucket(const FBucketUpdateHandle &Handle) const
+	{
+		if (!Handle.IsValid())
+			return false;
+
+		if (const FUpdateBucket* Bucket = ReplicationBuckets.Find(Handle.UpdateHTZ))
+		{
+			return Bucket->HandleToIndex.Contains(Handle.ID);
+		}
+
+		return false;
 	}
 
 	bool FUpdateBucketContainer::RemoveBucketObject(UObject * ObjectToRemove, FName FunctionName)
@@ -262,14 +458,13 @@
 		// Store if we ended up removing it
 		bool bRemovedObject = false;
 
-		TArray<uint32> BucketsToRemove;
 		for (auto& Bucket : ReplicationBuckets)
 		{
 			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
 			{
 				if (Bucket.Value.Callbacks[i].IsBoundToObjectFunction(ObjectToRemove, FunctionName))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
+					Bucket.Value.RemoveCallbackAt(i);
 					bRemovedObject = true;
 
 					// Leave the loop, this is called in add as well so we should never get duplicate entries
@@ -294,14 +489,13 @@
 		// Store if we ended up removing it
 		bool bRemovedObject = false;
 
-		TArray<uint32> BucketsToRemove;
 		for (auto& Bucket : ReplicationBuckets)
 		{
 			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
 			{
 				if (Bucket.Value.Callbacks[i].IsBoundToObjectDelegate(DynEvent))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
+					Bucket.Value.RemoveCallbackAt(i);
 					bRemovedObject = true;
 
 					// Leave the loop, this is called in add as well so we should never get duplicate entries
@@ -326,14 +520,13 @@
 		// Store if we ended up removing it
 		bool bRemovedObject = false;
 
-		TArray<uint32> BucketsToRemove;
 		for (auto& Bucket : ReplicationBuckets)
 		{
 			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
 			{
 				if (Bucket.Value.Callbacks[i].IsBoundToObject(ObjectToRemove))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
+					Bucket.Value.RemoveCallbackAt(i);
 					bRemovedObject = true;
 				}
 			}
@@ -20,13 +20,68 @@
 
 DEFINE_LOG_CATEGORY(VRE_CollisionIgnoreLog);
 
+DECLARE_CYCLE_STAT(TEXT("CollisionIgnore ~ ContactModification"), STAT_CollisionIgnoreContactModification, STATGROUP_CollisionIgnore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CollisionIgnore ~ Pair Lookups"), STAT_CollisionIgnorePairLookups, STATGROUP_CollisionIgnore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CollisionIgnore ~ Pair Hits"), STAT_CollisionIgnorePairHits, STATGROUP_CollisionIgnore);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("CollisionIgnore ~ Ignored Particle Pairs"), STAT_CollisionIgnoreParticlePairs, STATGROUP_CollisionIgnore);
+
+
+void FCollisionIgnoreSubsystemAsyncCallback::ApplyInput_Internal(const FSimCallbackInputVR& Input)
+{
+	if (!Input.bIsInitialized || Input.Version == AppliedVersion_Internal)
+	{
+		// Nothing new since the last step
+		return;
+	}
+
+	if (Input.bIsFullRebuild)
+	{
+		ParticlePairs_Internal = Input.ParticlePairs;
+		AppliedVersion_Internal = Input.Version;
+	}
+	else if (Input.bHasChanges)
+	{
+		if (Input.BaseVersion == AppliedVersion_Internal)
+		{
+			for (const FChaosParticlePair& RemovedPair : Input.PairsToRemove)
+			{
+				ParticlePairs_Internal.Remove(RemovedPair);
+			}
+
+			for (const FChaosParticlePair& AddedPair : Input.PairsToAdd)
+			{
+				ParticlePairs_Internal.Add(AddedPair);
+			}
+
+			AppliedVersion_Internal = Input.Version;
+		}
+		else
+		{
+			// We missed a delta somewhere, ask the game thread for the full set again
+			// Keep asking until one lands, the rebuild input can be skipped the same way the delta was
+			// and the game thread merges repeated requests anyway
+			GetProducerOutputData_Internal().bRequiresFullRebuild = true;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_CollisionIgnoreParticlePairs, ParticlePairs_Internal.Num());
+}
 
 void FCollisionIgnoreSubsystemAsyncCallback::OnContactModification_Internal(Chaos::FCollisionContactModifier& Modifier)
 {
-	const FSimCallbackInputVR* Input = GetConsumerInput_Internal();
+	SCOPE_CYCLE_COUNTER(STAT_CollisionIgnoreContactModification);
+
+	if (const FSimCallbackInputVR* Input = GetConsumerInput_Internal())
+	{
+		ApplyInput_Internal(*Input);
+	}
 
-	if (Input && Input->bIsInitialized)
+	if (ParticlePairs_Internal.Num() > 0)
 	{
+		// Accumulate locally and push to the stats system once per step
+		uint32 NumLookups = 0;
+		uint32 NumHits = 0;
+
 		for (Chaos::FContactPairModifierIterator ContactIterator = Modifier.Begin(); ContactIterator; ++ContactIterator)
 		{
 			if (ContactIterator.IsValid())
@@ -55,15 +110,20 @@ void FCollisionIgnoreSubsystemAsyncCallback::OnContactModification_Internal(Chao
 					//if (bHasCollisionFlag && bHadCollisionFlag2)
 					{
 						FChaosParticlePair SearchPair(ParticleHandle0, ParticleHandle1);
+						++NumLookups;
 
-						if (Input->ParticlePairs.Contains(SearchPair))
+						if (ParticlePairs_Internal.Contains(SearchPair))
 						{
+							++NumHits;
 							ContactIterator->Disable();
 						}
 					}
 				}
 			}
 		}
+
+		INC_DWORD_STAT_BY(STAT_CollisionIgnorePairLookups, NumLookups);
+		INC_DWORD_STAT_BY(STAT_CollisionIgnorePairHits, NumHits);
 	}
 }
 
@@ -77,22 +137,151 @@ void UCollisionIgnoreSubsystem::ConstructInput()
 			Input->bIsInitialized = true;
 		}
 
-		// Clear out the pair array
+		// Clear out the pair set and any pending deltas, this input now carries the full state
 		Input->Reset();
+		Input->bIsFullRebuild = true;
+		Input->Version = ++InputVersion;
+
+		int32 NumPairs = 0;
+		for (TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& CollisionPairArray : CollisionTrackedPairs)
+		{
+			NumPairs += CollisionPairArray.Value.PairArray.Num();
+		}
+		Input->ParticlePairs.Reserve(NumPairs);
 
 		for (TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& CollisionPairArray : CollisionTrackedPairs)
 		{
 			for (FCollisionIgnorePair& IgnorePair : CollisionPairArray.Value.PairArray)
 			{
-				if (IgnorePair.Actor1 && IgnorePair.Actor2)
+				if (IgnorePair.ParticlePair.ParticleHandle0 && IgnorePair.ParticlePair.ParticleHandle1)
 				{
-					Input->ParticlePairs.Add(FChaosParticlePair(IgnorePair.Actor1->GetHandle_LowLevel()->CastToRigidParticle(), IgnorePair.Actor2->GetHandle_LowLevel()->CastToRigidParticle()));
+					Input->ParticlePairs.Add(IgnorePair.ParticlePair);
 				}
 			}
 		}
 	}
 }
 
+void UCollisionIgnoreSubsystem::PushPairDelta(const FChaosParticlePair& ParticlePair, bool bWasAdded)
+{
+	if (!ContactModifierCallback || !IsUsingIncrementalUpdates() || !ParticlePair.ParticleHandle0 || !ParticlePair.ParticleHandle1)
+	{
+		return;
+	}
+
+	// The same producer input is returned for the entire frame, so deltas accumulate until it is marshalled
+	FSimCallbackInputVR* Input = ContactModifierCallback->GetProducerInputData_External();
+	Input->bIsInitialized = true;
+
+	if (Input->bIsFullRebuild)
+	{
+		// Already sending the full set this frame, just keep it current
+		if (bWasAdded)
+		{
+			Input->ParticlePairs.Add(ParticlePair);
+		}
+		else
+		{
+			Input->ParticlePairs.Remove(ParticlePair);
+		}
+
+		return;
+	}
+
+	if (!Input->bHasChanges)
+	{
+		Input->bHasChanges = true;
+		Input->BaseVersion = InputVersion;
+		Input->Version = ++InputVersion;
+	}
+
+	// Cancel out opposing deltas so that application order on the physics thread doesn't matter
+	if (bWasAdded)
+	{
+		Input->PairsToRemove.RemoveSwap(ParticlePair);
+		Input->PairsToAdd.AddUnique(ParticlePair);
+	}
+	else
+	{
+		Input->PairsToAdd.RemoveSwap(ParticlePair);
+		Input->PairsToRemove.AddUnique(ParticlePair);
+	}
+}
+
+void UCollisionIgnoreSubsystem::ProcessCallbackOutputs()
+{
+	if (!ContactModifierCallback)
+	{
+		return;
+	}
+
+	bool bRequiresFullRebuild = false;
+	while (Chaos::TSimCallbackOutputHandle<FSimCallbackOutputVR> Output = ContactModifierCallback->PopOutputData_External())
+	{
+		bRequiresFullRebuild |= Output->bRequiresFullRebuild;
+	}
+
+	if (bRequiresFullRebuild)
+	{
+		ConstructInput();
+	}
+}
+
+bool UCollisionIgnoreSubsystem::IsUsingIncrementalUpdates() const
+{
+	return GetDefault<UVRGlobalSettings>()->bUseIncrementalCollisionIgnoreUpdates;
+}
+
+void UCollisionIgnoreSubsystem::BindPhysicsStateChanged(UPrimitiveComponent* Prim)
+{
+	if (IsValid(Prim))
+	{
+		Prim->OnComponentPhysicsStateChanged.AddUniqueDynamic(this, &UCollisionIgnoreSubsystem::OnTrackedPrimitivePhysicsStateChanged);
+	}
+}
+
+void UCollisionIgnoreSubsystem::UnbindPhysicsStateChangedIfUntracked(UPrimitiveComponent* Prim)
+{
+	if (Prim && !IsComponentIgnoringCollision(Prim))
+	{
+		Prim->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UCollisionIgnoreSubsystem::OnTrackedPrimitivePhysicsStateChanged);
+	}
+}
+
+void UCollisionIgnoreSubsystem::OnTrackedPrimitivePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange)
+{
+	if (!ChangedComponent || StateChange != EComponentPhysicsStateChange::Destroyed)
+	{
+		return;
+	}
+
+	// The bodies are already gone at this point and chaos cleans up its own ignore entries for them
+	// So we only need to drop our tracking and let the physics thread know about the removed pairs
+	TArray<UPrimitiveComponent*> OtherPrims;
+	for (TMap<FCollisionPrimPair, FCollisionIgnorePairArray>::TIterator ItRemove = CollisionTrackedPairs.CreateIterator(); ItRemove; ++ItRemove)
+	{
+		if (ItRemove->Key.Prim1 == ChangedComponent || ItRemove->Key.Prim2 == ChangedComponent)
+		{
+			for (const FCollisionIgnorePair& IgnorePair : ItRemove->Value.PairArray)
+			{
+				PushPairDelta(IgnorePair.ParticlePair, false);
+			}
+
+			OtherPrims.AddUnique(ItRemove->Key.Prim1 == ChangedComponent ? ItRemove->Key.Prim2.Get() : ItRemove->Key.Prim1.Get());
+			ItRemove.RemoveCurrent();
+		}
+	}
+
+	ChangedComponent->OnComponentPhysicsStateChanged.RemoveDynamic(this, &UCollisionIgnoreSubsystem::OnTrackedPrimitivePhysicsStateChanged);
+
+	for (UPrimitiveComponent* OtherPrim : OtherPrims)
+	{
+		UnbindPhysicsStateChangedIfUntracked(OtherPrim);
+	}
+
+	UpdateTimer(true);
+}
+
 void UCollisionIgnoreSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
@@ -108,38 +297,47 @@ void UCollisionIgnoreSubsystem::UpdateTimer(bool bChangesWereMade)
 {
 	RemovedPairs.Reset();
 	const UVRGlobalSettings& VRSettings = *GetDefault<UVRGlobalSettings>();
+	const bool bIncremental = IsUsingIncrementalUpdates();
 
 	if (CollisionTrackedPairs.Num() > 0)
 	{
 		if (!UpdateHandle.IsValid())
 		{
 			// Setup the heartbeat on 1htz checks
+			// In incremental mode this only services resync requests from the physics thread, pairs are invalidated by physics state callbacks
 			GetWorld()->GetTimerManager().SetTimer(UpdateHandle, this, &UCollisionIgnoreSubsystem::CheckActiveFilters, VRSettings.CollisionIgnoreSubsystemUpdateRate, true, VRSettings.CollisionIgnoreSubsystemUpdateRate);
+		}
 
-			if (VRSettings.bUseCollisionModificationForCollisionIgnore && !ContactModifierCallback)
+		if (VRSettings.bUseCollisionModificationForCollisionIgnore && !ContactModifierCallback)
+		{
+			if (UWorld* World = GetWorld())
 			{
-				if (UWorld* World = GetWorld())
+				if (FPhysScene* PhysScene = World->GetPhysicsScene())
 				{
-					if (FPhysScene* PhysScene = World->GetPhysicsScene())
-					{
-						// Register a callback
-						ContactModifierCallback = PhysScene->GetSolver()->CreateAndRegisterSimCallbackObject_External<FCollisionIgnoreSubsystemAsyncCallback>(/*true*/);
-					}
+					// Register a callback
+					ContactModifierCallback = PhysScene->GetSolver()->CreateAndRegisterSimCallbackObject_External<FCollisionIgnoreSubsystemAsyncCallback>(/*true*/);
+
+					// A new callback always needs the full set
+					ConstructInput();
+					return;
 				}
 			}
 		}
 
-		// Need to only add input when changes are made
-		if (VRSettings.bUseCollisionModificationForCollisionIgnore && ContactModifierCallback && bChangesWereMade)
+		// Need to only add input when changes are made, incremental mode pushes its deltas as they happen
+		if (VRSettings.bUseCollisionModificationForCollisionIgnore && ContactModifierCallback && bChangesWereMade && !bIncremental)
 		{
 			ConstructInput();
 		}
 	}
-	else if (UpdateHandle.IsValid())
+	else
 	{
-		GetWorld()->GetTimerManager().ClearTimer(UpdateHandle);
+		if (UpdateHandle.IsValid())
+		{
+			GetWorld()->GetTimerManager().ClearTimer(UpdateHandle);
+		}
 
-		if (VRSettings.bUseCollisionModificationForCollisionIgnore && ContactModifierCallback)
+		if (ContactModifierCallback)
 		{
 			//FSimCallbackInputVR* Input = ContactModifierCallback->GetProducerInputData_External();
 			//Input->bIsInitialized = false;
@@ -159,6 +357,14 @@ void UCollisionIgnoreSubsystem::UpdateTimer(bool bChangesWereMade)
 
 void UCollisionIgnoreSubsystem::CheckActiveFilters()
 {
+	if (IsUsingIncrementalUpdates())
+	{
+		// Invalidation is handled by the physics state callbacks, only service the physics thread here
+		ProcessCallbackOutputs();
+		UpdateTimer(false);
+		return;
+	}
+
 	bool bMadeChanges = false;
 
 	for (TMap<FCollisionPrimPair, FCollisionIgnorePairArray>::TIterator ItRemove = CollisionTrackedPairs.CreateIterator(); ItRemove; ++ItRemove)
@@ -532,6 +738,11 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 					auto* pHandle1 = ApplicableBodies[i].BInstance->ActorHandle->GetHandle_LowLevel();
 					auto* pHandle2 = ApplicableBodies2[j].BInstance->ActorHandle->GetHandle_LowLevel();
 
+					if (pHandle1 && pHandle2)
+					{
+						newIgnorePair.ParticlePair = FChaosParticlePair(pHandle1->CastToRigidParticle(), pHandle2->CastToRigidParticle());
+					}
+
 					Chaos::FIgnoreCollisionManager& IgnoreCollisionManager = PhysScene->GetSolver()->GetEvolution()->GetBroadPhase().GetIgnoreCollisionManager();
 
 					FPhysicsCommand::ExecuteWrite(PhysScene, [&]()
@@ -558,6 +769,7 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 										}
 
 										CollisionTrackedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
+										PushPairDelta(newIgnorePair.ParticlePair, true);
 									}										
 								}
 							}
@@ -567,7 +779,11 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 								{
 									IgnoreCollisionManager.RemoveIgnoreCollisions(pHandle1, pHandle2);
 
-									CollisionTrackedPairs[newPrimPair].PairArray.Remove(newIgnorePair);
+									if (CollisionTrackedPairs[newPrimPair].PairArray.Remove(newIgnorePair) > 0)
+									{
+										PushPairDelta(newIgnorePair.ParticlePair, false);
+									}
+
 									if (CollisionTrackedPairs[newPrimPair].PairArray.Num() < 1)
 									{
 										CollisionTrackedPairs.Remove(newPrimPair);
@@ -587,6 +803,20 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 		}
 	}
 
+	if (IsUsingIncrementalUpdates())
+	{
+		if (bIgnoreCollision && CollisionTrackedPairs.Contains(newPrimPair))
+		{
+			BindPhysicsStateChanged(Prim1);
+			BindPhysicsStateChanged(Prim2);
+		}
+		else if (!bIgnoreCollision)
+		{
+			UnbindPhysicsStateChangedIfUntracked(Prim1);
+			UnbindPhysicsStateChangedIfUntracked(Prim2);
+		}
+	}
+
 	// Update our timer state
 	UpdateTimer(true);
 }
\ No newline at end of file
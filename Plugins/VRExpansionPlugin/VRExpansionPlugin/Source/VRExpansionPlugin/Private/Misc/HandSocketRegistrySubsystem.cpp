@@ -0,0 +1,269 @@
+// Copyright 1998-2016 Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/HandSocketRegistrySubsystem.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HandSocketRegistrySubsystem)
+
+#include "Grippables/HandSocketComponent.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY(LogVRHandSocketRegistry);
+
+DECLARE_CYCLE_STAT(TEXT("HandSocketRegistry ~ Range Query"), STAT_HandSocketRegistryQuery, STATGROUP_HandSocketRegistry);
+DECLARE_CYCLE_STAT(TEXT("HandSocketRegistry ~ Update Socket"), STAT_HandSocketRegistryUpdate, STATGROUP_HandSocketRegistry);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HandSocketRegistry ~ Sockets Tested"), STAT_HandSocketRegistrySocketsTested, STATGROUP_HandSocketRegistry);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HandSocketRegistry ~ Registered Sockets"), STAT_HandSocketRegistryRegistered, STATGROUP_HandSocketRegistry);
+
+  // CVars
+namespace HandSocketRegistryCvars
+{
+	static float RegistryCellSize = 200.0f;
+	FAutoConsoleVariableRef CVarHandSocketRegistryCellSize(
+		TEXT("vr.HandSocketRegistry.CellSize"),
+		RegistryCellSize,
+		TEXT("Edge length in world units of the grid cells used to index hand sockets, applied when a world is initialized.\n")
+		TEXT("Should be around the size of the typical hand socket search range."),
+		ECVF_Default);
+}
+
+void UHandSocketRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(HandSocketRegistryCvars::RegistryCellSize, 1.0f);
+}
+
+void UHandSocketRegistrySubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_HandSocketRegistryRegistered, SocketCells.Num());
+
+	Cells.Empty();
+	SocketCells.Empty();
+
+	Super::Deinitialize();
+}
+
+FVector UHandSocketRegistrySubsystem::GetHandSocketQueryLocation(const UHandSocketComponent* HandSocket)
+{
+	// Matches the location that the old iterator based lookups used, locked sockets keep their relative transform
+	// relative to the actor even though they are absolute during play
+	if (const AActor* Owner = HandSocket->GetOwner())
+	{
+		return (HandSocket->GetRelativeTransform() * Owner->GetActorTransform()).GetLocation();
+	}
+
+	return HandSocket->GetComponentLocation();
+}
+
+FIntVector UHandSocketRegistrySubsystem::GetCellForLocation(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize)
+	);
+}
+
+void UHandSocketRegistrySubsystem::RegisterHandSocket(UHandSocketComponent* HandSocket)
+{
+	if (!HandSocket)
+		return;
+
+	if (SocketCells.Contains(TObjectKey<UHandSocketComponent>(HandSocket)))
+	{
+		UpdateHandSocket(HandSocket);
+		return;
+	}
+
+	const FVector Location = GetHandSocketQueryLocation(HandSocket);
+	const FIntVector Cell = GetCellForLocation(Location);
+
+	Cells.FindOrAdd(Cell).Emplace(HandSocket, Location);
+	SocketCells.Add(TObjectKey<UHandSocketComponent>(HandSocket), Cell);
+
+	INC_DWORD_STAT(STAT_HandSocketRegistryRegistered);
+}
+
+void UHandSocketRegistrySubsystem::UnregisterHandSocket(UHandSocketComponent* HandSocket)
+{
+	FIntVector Cell;
+	if (!HandSocket || !SocketCells.RemoveAndCopyValue(TObjectKey<UHandSocketComponent>(HandSocket), Cell))
+		return;
+
+	RemoveFromCell(HandSocket, Cell);
+
+	DEC_DWORD_STAT(STAT_HandSocketRegistryRegistered);
+}
+
+void UHandSocketRegistrySubsystem::RemoveFromCell(UHandSocketComponent* HandSocket, const FIntVector& Cell)
+{
+	if (TArray<FHandSocketRegistryCellEntry>* CellEntries = Cells.Find(Cell))
+	{
+		for (int i = CellEntries->Num() - 1; i >= 0; --i)
+		{
+			if ((*CellEntries)[i].IsFor(HandSocket))
+			{
+				CellEntries->RemoveAtSwap(i, 1, EAllowShrinking::No);
+				break;
+			}
+		}
+
+		// Drop empty cells so that large range queries falling back to walking the cells stay cheap
+		if (CellEntries->Num() < 1)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UHandSocketRegistrySubsystem::UpdateHandSocket(UHandSocketComponent* HandSocket)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HandSocketRegistryUpdate);
+
+	FIntVector* CurrentCell = HandSocket ? SocketCells.Find(TObjectKey<UHandSocketComponent>(HandSocket)) : nullptr;
+	if (!CurrentCell)
+		return;
+
+	const FVector Location = GetHandSocketQueryLocation(HandSocket);
+	const FIntVector NewCell = GetCellForLocation(Location);
+
+	if (NewCell == *CurrentCell)
+	{
+		// Same cell, just refresh the cached location
+		if (TArray<FHandSocketRegistryCellEntry>* CellEntries = Cells.Find(NewCell))
+		{
+			for (FHandSocketRegistryCellEntry& Entry : *CellEntries)
+			{
+				if (Entry.IsFor(HandSocket))
+				{
+					Entry.Location = Location;
+					break;
+				}
+			}
+		}
+
+		return;
+	}
+
+	RemoveFromCell(HandSocket, *CurrentCell);
+	Cells.FindOrAdd(NewCell).Emplace(HandSocket, Location);
+	*CurrentCell = NewCell;
+}
+
+template<typename FuncType>
+void UHandSocketRegistrySubsystem::ForEachEntryInRange(const FVector& SearchFromWorldLocation, float SearchRange, FuncType&& Func) const
+{
+	const FVector Extent(FMath::Max(SearchRange, 0.0f));
+	const FIntVector MinCell = GetCellForLocation(SearchFromWorldLocation - Extent);
+	const FIntVector MaxCell = GetCellForLocation(SearchFromWorldLocation + Extent);
+
+	const int64 NumCellsInRange =
+		((int64)MaxCell.X - MinCell.X + 1) *
+		((int64)MaxCell.Y - MinCell.Y + 1) *
+		((int64)MaxCell.Z - MinCell.Z + 1);
+
+	// Huge search ranges would hash more empty cells than exist, just walk the occupied ones instead
+	if (NumCellsInRange > Cells.Num())
+	{
+		for (const TPair<FIntVector, TArray<FHandSocketRegistryCellEntry>>& CellPair : Cells)
+		{
+			const FIntVector& Cell = CellPair.Key;
+			if (Cell.X < MinCell.X || Cell.Y < MinCell.Y || Cell.Z < MinCell.Z ||
+				Cell.X > MaxCell.X || Cell.Y > MaxCell.Y || Cell.Z > MaxCell.Z)
+			{
+				continue;
+			}
+
+			for (const FHandSocketRegistryCellEntry& Entry : CellPair.Value)
+			{
+				Func(Entry);
+			}
+		}
+
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const TArray<FHandSocketRegistryCellEntry>* CellEntries = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					for (const FHandSocketRegistryCellEntry& Entry : *CellEntries)
+					{
+						Func(Entry);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UHandSocketRegistrySubsystem::GetAllHandSockets(TArray<UHandSocketComponent*>& OutHandSockets) const
+{
+	OutHandSockets.Reserve(OutHandSockets.Num() + SocketCells.Num());
+	for (const TPair<TObjectKey<UHandSocketComponent>, FIntVector>& SocketPair : SocketCells)
+	{
+		UHandSocketComponent* HandSocket = SocketPair.Key.ResolveObjectPtr();
+		if (IsValid(HandSocket))
+		{
+			OutHandSockets.Add(HandSocket);
+		}
+	}
+}
+
+bool UHandSocketRegistrySubsystem::GetHandSocketsInRange(const FVector& SearchFromWorldLocation, float SearchRange, TArray<UHandSocketComponent*>& OutHandSockets) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_HandSocketRegistryQuery);
+
+	const double SearchDistSq = FMath::Square((double)SearchRange);
+	const int32 StartingNum = OutHandSockets.Num();
+	int32 NumTested = 0;
+
+	ForEachEntryInRange(SearchFromWorldLocation, SearchRange, [&](const FHandSocketRegistryCellEntry& Entry)
+	{
+		++NumTested;
+		if (FVector::DistSquared(Entry.Location, SearchFromWorldLocation) <= SearchDistSq)
+		{
+			UHandSocketComponent* HandSocket = Entry.HandSocket.Get();
+			if (IsValid(HandSocket))
+			{
+				OutHandSockets.Add(HandSocket);
+			}
+		}
+	});
+
+	INC_DWORD_STAT_BY(STAT_HandSocketRegistrySocketsTested, NumTested);
+	return OutHandSockets.Num() > StartingNum;
+}
+
+UHandSocketComponent* UHandSocketRegistrySubsystem::GetClosestHandSocketInRange(const FVector& SearchFromWorldLocation, float SearchRange, float& OutDistSq) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_HandSocketRegistryQuery);
+
+	const double SearchDistSq = FMath::Square((double)SearchRange);
+	UHandSocketComponent* ClosestHandSocket = nullptr;
+	double ClosestDistSq = 0.0;
+	int32 NumTested = 0;
+
+	ForEachEntryInRange(SearchFromWorldLocation, SearchRange, [&](const FHandSocketRegistryCellEntry& Entry)
+	{
+		++NumTested;
+		const double DistSq = FVector::DistSquared(Entry.Location, SearchFromWorldLocation);
+		if (DistSq <= SearchDistSq && (!ClosestHandSocket || DistSq < ClosestDistSq))
+		{
+			UHandSocketComponent* HandSocket = Entry.HandSocket.Get();
+			if (IsValid(HandSocket))
+			{
+				ClosestHandSocket = HandSocket;
+				ClosestDistSq = DistSq;
+			}
+		}
+	});
+
+	INC_DWORD_STAT_BY(STAT_HandSocketRegistrySocketsTested, NumTested);
+	OutDistSq = (float)ClosestDistSq;
+	return ClosestHandSocket;
+}
@@ -0,0 +1,195 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRGripUpdateSubsystem.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRGripUpdateSubsystem)
+
+#include "GripMotionControllerComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("VRGripUpdate ~ Batched Update"), STAT_BatchedGripUpdate, STATGROUP_VRGripUpdate);
+DECLARE_CYCLE_STAT(TEXT("VRGripUpdate ~ Gather"), STAT_BatchedGripGather, STATGROUP_VRGripUpdate);
+DECLARE_CYCLE_STAT(TEXT("VRGripUpdate ~ Parallel Transforms"), STAT_BatchedGripParallel, STATGROUP_VRGripUpdate);
+DECLARE_CYCLE_STAT(TEXT("VRGripUpdate ~ Apply"), STAT_BatchedGripApply, STATGROUP_VRGripUpdate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRGripUpdate ~ Controllers"), STAT_BatchedGripControllers, STATGROUP_VRGripUpdate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("VRGripUpdate ~ Parallel Grips"), STAT_BatchedGripParallelGrips, STATGROUP_VRGripUpdate);
+
+  // CVars
+namespace VRGripUpdateCvars
+{
+	static int32 BatchedGripUpdates = 0;
+	FAutoConsoleVariableRef CVarBatchedGripUpdates(
+		TEXT("vr.BatchedGripUpdates"),
+		BatchedGripUpdates,
+		TEXT("When on, grip motion controllers defer their grip processing to one batched update per world that computes\n")
+		TEXT("parallel safe grip script transforms on worker threads before applying every grip in a stable order.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static int32 MinParallelControllers = 2;
+	FAutoConsoleVariableRef CVarBatchedGripMinParallelControllers(
+		TEXT("vr.BatchedGripUpdates.MinParallelControllers"),
+		MinParallelControllers,
+		TEXT("Minimum number of controllers with parallel safe grips before the transforms are spread across worker threads."),
+		ECVF_Default);
+}
+
+void FVRGripUpdateTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && IsValid(Target))
+	{
+		Target->UpdateQueuedGrips();
+	}
+}
+
+FString FVRGripUpdateTickFunction::DiagnosticMessage()
+{
+	return TEXT("FVRGripUpdateTickFunction");
+}
+
+FName FVRGripUpdateTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("VRGripUpdate"));
+}
+
+bool UVRGripUpdateSubsystem::IsBatchingEnabled()
+{
+	return VRGripUpdateCvars::BatchedGripUpdates > 0;
+}
+
+void UVRGripUpdateSubsystem::Deinitialize()
+{
+	if (GripUpdateTickFunction.IsTickFunctionRegistered())
+	{
+		GripUpdateTickFunction.UnRegisterTickFunction();
+	}
+
+	RegisteredControllers.Empty();
+	QueuedUpdates.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRGripUpdateSubsystem::RegisterController(UGripMotionControllerComponent* Controller)
+{
+	if (!Controller || RegisteredControllers.Contains(Controller))
+		return;
+
+	if (!GripUpdateTickFunction.IsTickFunctionRegistered())
+	{
+		UWorld* World = GetWorld();
+		if (!World || !World->PersistentLevel)
+			return;
+
+		GripUpdateTickFunction.Target = this;
+		GripUpdateTickFunction.bCanEverTick = true;
+		GripUpdateTickFunction.bStartWithTickEnabled = true;
+		GripUpdateTickFunction.bTickEvenWhenPaused = true;
+		GripUpdateTickFunction.TickGroup = TG_PrePhysics;
+		GripUpdateTickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	// Make sure that we run after the controller has updated its tracking and queued itself
+	GripUpdateTickFunction.AddPrerequisite(Controller, Controller->PrimaryComponentTick);
+	RegisteredControllers.Add(Controller);
+}
+
+void UVRGripUpdateSubsystem::UnregisterController(UGripMotionControllerComponent* Controller)
+{
+	if (!Controller || RegisteredControllers.Remove(Controller) < 1)
+		return;
+
+	GripUpdateTickFunction.RemovePrerequisite(Controller, Controller->PrimaryComponentTick);
+}
+
+bool UVRGripUpdateSubsystem::QueueGripUpdate(UGripMotionControllerComponent* Controller, float DeltaTime)
+{
+	if (!IsBatchingEnabled() || !Controller || !GripUpdateTickFunction.IsTickFunctionRegistered() || !RegisteredControllers.Contains(Controller))
+		return false;
+
+	QueuedUpdates.Emplace(Controller, DeltaTime);
+	return true;
+}
+
+void UVRGripUpdateSubsystem::UpdateQueuedGrips()
+{
+	if (!QueuedUpdates.Num())
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_BatchedGripUpdate);
+
+	TArray<FVRQueuedGripUpdate> Updates = MoveTemp(QueuedUpdates);
+	QueuedUpdates.Reset();
+
+	// Controllers can tick in any order, sort them so that the apply phase is deterministic
+	Updates.RemoveAll([](const FVRQueuedGripUpdate& Update) { return !Update.Controller.IsValid(); });
+	Updates.Sort([](const FVRQueuedGripUpdate& A, const FVRQueuedGripUpdate& B)
+	{
+		return A.Controller->GetUniqueID() < B.Controller->GetUniqueID();
+	});
+
+	INC_DWORD_STAT_BY(STAT_BatchedGripControllers, Updates.Num());
+
+	TArray<UGripMotionControllerComponent*> ParallelControllers;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BatchedGripGather);
+
+		for (const FVRQueuedGripUpdate& Update : Updates)
+		{
+			Update.Controller->GatherBatchedGripJobs(Update.DeltaTime);
+		}
+
+		// Grip scripts live on the gripped object, if it is held more than once they could be run by two workers at the same time
+		TMap<const UObject*, int32> GrippedObjectCounts;
+		for (const FVRQueuedGripUpdate& Update : Updates)
+		{
+			for (const FVRBatchedGripJob& Job : Update.Controller->BatchedGripJobs)
+			{
+				++GrippedObjectCounts.FindOrAdd(Job.GrippedObject);
+			}
+		}
+
+		int32 NumParallelGrips = 0;
+		for (const FVRQueuedGripUpdate& Update : Updates)
+		{
+			TArray<FVRBatchedGripJob>& Jobs = Update.Controller->BatchedGripJobs;
+			Jobs.RemoveAll([&GrippedObjectCounts](const FVRBatchedGripJob& Job) { return GrippedObjectCounts.FindRef(Job.GrippedObject) > 1; });
+
+			if (Jobs.Num())
+			{
+				ParallelControllers.Add(Update.Controller.Get());
+				NumParallelGrips += Jobs.Num();
+			}
+		}
+
+		INC_DWORD_STAT_BY(STAT_BatchedGripParallelGrips, NumParallelGrips);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BatchedGripParallel);
+
+		// One task per controller, a controllers grips share its default grip script so they stay on one thread
+		const bool bForceSingleThread = ParallelControllers.Num() < FMath::Max(VRGripUpdateCvars::MinParallelControllers, 2);
+		ParallelFor(ParallelControllers.Num(), [&ParallelControllers](int32 Index)
+		{
+			ParallelControllers[Index]->RunBatchedGripJobs();
+		}, bForceSingleThread);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BatchedGripApply);
+
+		for (const FVRQueuedGripUpdate& Update : Updates)
+		{
+			// Grip callbacks from an earlier controller could have destroyed this one
+			if (UGripMotionControllerComponent* Controller = Update.Controller.Get())
+			{
+				Controller->TickGrip(Update.DeltaTime);
+				Controller->BatchedGripJobs.Reset();
+			}
+		}
+	}
+}
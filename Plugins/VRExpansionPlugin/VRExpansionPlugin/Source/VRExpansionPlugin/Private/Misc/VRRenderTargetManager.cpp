@@ -24,6 +24,7 @@
 #include "Serialization/ArchiveLoadCompressedProxy.h"
 #include "Materials/Material.h"
 #include "Net/UnrealNetwork.h"
+#include "Tasks/Task.h"
 
 // Iris
 #include "Serializers/SerializerHelpers.h"
@@ -73,6 +74,89 @@ namespace RLE_Funcs
 	static inline void RLEWriteRunFlag(uint32 Count, uint8** loc, TArray<DataType>& Data, bool bCompressed);
 }
 
+namespace VRRenderTargetHelpers
+{
+	FORCEINLINE uint16 ColorTo565(const FColor& Col)
+	{
+		return (Col.R >> 3) << 11 | (Col.G >> 2) << 5 | (Col.B >> 3);
+	}
+
+	// Note the channel order here is swapped, the FColor buffer is memcpy'd into an RGBA texture which swaps it back
+	FORCEINLINE FColor ColorFrom565(uint16 CompColor)
+	{
+		FColor ColorVal;
+		ColorVal.R = CompColor << 3;
+		ColorVal.G = CompColor >> 5 << 2;
+		ColorVal.B = CompColor >> 11 << 3;
+		ColorVal.A = 0xFF;
+		return ColorVal;
+	}
+
+	// These run on worker threads for the full texture, so they do 4 pixels at a time.
+	// Reading an FColor as a uint32 gives A R G B from high to low byte on little endian platforms.
+	static void ConvertColorsTo565(const FColor* Src, uint16* Dest, int32 Num)
+	{
+		int32 i = 0;
+
+#if PLATFORM_LITTLE_ENDIAN
+		const VectorRegister4Int MaskR = VectorIntSet1(0xF800);
+		const VectorRegister4Int MaskG = VectorIntSet1(0x07E0);
+		const VectorRegister4Int MaskB = VectorIntSet1(0x001F);
+		alignas(16) uint32 Lanes[4];
+
+		for (; i + 4 <= Num; i += 4)
+		{
+			const VectorRegister4Int Pixels = VectorIntLoad(Src + i);
+			const VectorRegister4Int R = VectorIntAnd(VectorShiftRightImmLogical(Pixels, 8), MaskR);
+			const VectorRegister4Int G = VectorIntAnd(VectorShiftRightImmLogical(Pixels, 5), MaskG);
+			const VectorRegister4Int B = VectorIntAnd(VectorShiftRightImmLogical(Pixels, 3), MaskB);
+			VectorIntStoreAligned(VectorIntOr(R, VectorIntOr(G, B)), Lanes);
+
+			Dest[i] = (uint16)Lanes[0];
+			Dest[i + 1] = (uint16)Lanes[1];
+			Dest[i + 2] = (uint16)Lanes[2];
+			Dest[i + 3] = (uint16)Lanes[3];
+		}
+#endif
+
+		for (; i < Num; ++i)
+		{
+			Dest[i] = ColorTo565(Src[i]);
+		}
+	}
+
+	static void ConvertColorsFrom565(const uint16* Src, FColor* Dest, int32 Num)
+	{
+		int32 i = 0;
+
+#if PLATFORM_LITTLE_ENDIAN
+		// Same swapped channel order as ColorFrom565
+		const VectorRegister4Int MaskB = VectorIntSet1(0x000000F8);
+		const VectorRegister4Int MaskG = VectorIntSet1(0x0000FC00);
+		const VectorRegister4Int MaskR = VectorIntSet1(0x00F80000);
+		const VectorRegister4Int Alpha = VectorIntSet1((int32)0xFF000000);
+
+		for (; i + 4 <= Num; i += 4)
+		{
+			const VectorRegister4Int Comp = MakeVectorRegisterInt(Src[i], Src[i + 1], Src[i + 2], Src[i + 3]);
+			const VectorRegister4Int B = VectorIntAnd(VectorShiftRightImmLogical(Comp, 8), MaskB);
+			const VectorRegister4Int G = VectorIntAnd(VectorShiftLeftImm(Comp, 5), MaskG);
+			const VectorRegister4Int R = VectorIntAnd(VectorShiftLeftImm(Comp, 19), MaskR);
+			VectorIntStore(VectorIntOr(VectorIntOr(B, G), VectorIntOr(R, Alpha)), Dest + i);
+		}
+#endif
+
+		for (; i < Num; ++i)
+		{
+			Dest[i] = ColorFrom565(Src[i]);
+		}
+	}
+
+	// Patches index tiles with a uint16 so keep the tile count under that
+	static constexpr int32 MinTileSize = 32;
+	static constexpr int32 MaxTileCount = MAX_uint16;
+}
+
 UVRRenderTargetManager::UVRRenderTargetManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -95,6 +179,13 @@ UVRRenderTargetManager::UVRRenderTargetManager(const FObjectInitializer& ObjectI
 	bInitiallyReplicateTexture = false;
 	bIsLoadingTextureBuffer = false;
 
+	bUseDeltaTextureReplication = false;
+	DeltaTileSize = 64;
+	TextureVersion = 0;
+	TileCount = FIntPoint::ZeroValue;
+	TrackedTileSize = DeltaTileSize;
+	AppliedTextureVersion = 0;
+
 	OwnerIDCounter = 0;
 }
 
@@ -325,9 +416,21 @@ void UVRRenderTargetManager::DrawOperations()
 
 	if (CanvasToUse)
 	{
+		// Track the areas that were drawn to so that delta replication can send only those
+		const bool bTrackDirtyTiles = bUseDeltaTextureReplication && TileVersions.Num() > 0 && GetNetMode() < ENetMode::NM_Client;
+		if (bTrackDirtyTiles && RenderOperationStore.Num() > 0)
+		{
+			++TextureVersion;
+		}
+
 		for (const FRenderManagerOperation& opt : RenderOperationStore)
 		{
 			DrawOperation(CanvasToUse, opt);
+
+			if (bTrackDirtyTiles)
+			{
+				MarkOperationDirty(opt);
+			}
 		}
 
 		RenderOperationStore.Empty();
@@ -350,6 +453,7 @@ ARenderTargetReplicationProxy::ARenderTargetReplicationProxy(const FObjectInitia
 	PrimaryActorTick.bCanEverTick = false;
 	SetReplicateMovement(false);
 	bWaitingForManager = false;
+	PendingTextureVersion = 0;
 }
 
 void ARenderTargetReplicationProxy::OnRep_Manager()
@@ -409,11 +513,23 @@ void ARenderTargetReplicationProxy::ReceiveTexture_Implementation(const FBPVRRep
 	}
 }
 
-void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/)
+void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped, bool bIsDeltaPatch, int32 TileSize, int32 BaseVersion, int32 Version/*, bool bIsJPG*/)
 {
 	TextureStore.Reset();
+
+	// A patch against a texture we don't have, don't bother receiving it and ask for a full copy instead
+	if (bIsDeltaPatch && IsValid(OwningManager) && OwningManager->GetLatestTextureVersion() < (uint32)BaseVersion)
+	{
+		RequestTextureKeyframe();
+		return;
+	}
+
 	TextureStore.PixelFormat = PixelFormat;
 	TextureStore.bIsZipped = bIsZipped;
+	TextureStore.bIsDeltaPatch = bIsDeltaPatch;
+	TextureStore.TileSize = (uint32)TileSize;
+	TextureStore.BaseVersion = (uint32)BaseVersion;
+	TextureStore.Version = (uint32)Version;
 	//TextureStore.bJPG = bIsJPG;
 	TextureStore.Width = Width;
 	TextureStore.Height = Height;
@@ -438,7 +554,7 @@ bool ARenderTargetReplicationProxy::Ack_InitTextureSend_Validate(int32 TotalData
 
 void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 TotalDataCount)
 {
-	if (TotalDataCount == TextureStore.PackedData.Num())
+	if (OutgoingTextureStore.IsValid() && TotalDataCount == OutgoingTextureStore->PackedData.Num())
 	{
 		BlobNum = 0;
 
@@ -452,21 +568,39 @@ void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 Tot
 	}
 }
 
+void ARenderTargetReplicationProxy::SendTexture(const FBPVRSharedTextureStorePtr& InTextureStore)
+{
+	// Kill off any in progress send, the client will reset its buffer on the new init message
+	if (SendTimer_Handle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
+
+	BlobNum = 0;
+	OutgoingTextureStore = InTextureStore;
+
+	if (OutgoingTextureStore.IsValid())
+	{
+		SendInitMessage();
+	}
+}
+
 void ARenderTargetReplicationProxy::SendInitMessage()
 {
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	if (!OutgoingTextureStore.IsValid())
+		return;
 
-	InitTextureSend(TextureStore.Width, TextureStore.Height, TextureStore.PackedData.Num(), TotalBlobs, TextureStore.PixelFormat, TextureStore.bIsZipped/*, TextureStore.bJPG*/);
+	const FBPVRReplicatedTextureStore& Store = *OutgoingTextureStore;
+	int32 TotalBlobs = Store.PackedData.Num() / TextureBlobSize + (Store.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+
+	InitTextureSend(Store.Width, Store.Height, Store.PackedData.Num(), TotalBlobs, Store.PixelFormat, Store.bIsZipped, Store.bIsDeltaPatch, (int32)Store.TileSize, (int32)Store.BaseVersion, (int32)Store.Version/*, Store.bJPG*/);
 
 }
 
 void ARenderTargetReplicationProxy::SendNextDataBlob()
 {
-	if (!IsValidChecked(this) || !this->GetOwner() || !IsValid(this->GetOwner()))
+	if (!IsValidChecked(this) || !this->GetOwner() || !IsValid(this->GetOwner()) || !OutgoingTextureStore.IsValid())
 	{	
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
+		OutgoingTextureStore.Reset();
+		BlobScratch.Empty();
 		BlobNum = 0;
 		if (SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
@@ -474,29 +608,26 @@ void ARenderTargetReplicationProxy::SendNextDataBlob()
 		return;
 	}
 
+	const TArray<uint8>& PackedData = OutgoingTextureStore->PackedData;
+
 	BlobNum++;
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	int32 TotalBlobs = PackedData.Num() / TextureBlobSize + (PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
 
 	if (BlobNum <= TotalBlobs)
 	{
-		TArray<uint8> BlobStore;
-		int32 BlobLen = (BlobNum == TotalBlobs ? TextureStore.PackedData.Num() % TextureBlobSize : TextureBlobSize);
-
-
-		BlobStore.AddUninitialized(BlobLen);
-		uint8* MemLoc = TextureStore.PackedData.GetData();
 		int32 MemCount = (BlobNum - 1) * TextureBlobSize;
-		MemLoc += MemCount;
+		int32 BlobLen = FMath::Min(TextureBlobSize, PackedData.Num() - MemCount);
 
-		FMemory::Memcpy(BlobStore.GetData(), MemLoc, BlobLen);
+		BlobScratch.Reset(TextureBlobSize);
+		BlobScratch.Append(PackedData.GetData() + MemCount, BlobLen);
 
-		ReceiveTextureBlob(BlobStore, MemCount, BlobNum);
+		ReceiveTextureBlob(BlobScratch, MemCount, BlobNum);
 	}
 	else
 	{
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
+		// Done sending, drop our reference to the shared data
+		OutgoingTextureStore.Reset();
+		BlobScratch.Empty();
 		if (SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 		BlobNum = 0;
@@ -508,6 +639,8 @@ void ARenderTargetReplicationProxy::EndPlay(const EEndPlayReason::Type EndPlayRe
 	if (SendTimer_Handle.IsValid())
 		GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 
+	OutgoingTextureStore.Reset();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -567,6 +700,24 @@ void ARenderTargetReplicationProxy::Ack_ReceiveTextureBlob_Implementation(int32
 	// Send next data blob
 	//SendNextDataBlob();
 
+	// The client only acks the final blob, it now has this version of the texture
+	if (IsValid(OwningManager))
+	{
+		OwningManager->OnClientTextureSynced(this, PendingTextureVersion);
+	}
+}
+
+bool ARenderTargetReplicationProxy::RequestTextureKeyframe_Validate()
+{
+	return true;
+}
+
+void ARenderTargetReplicationProxy::RequestTextureKeyframe_Implementation()
+{
+	if (IsValid(OwningManager))
+	{
+		OwningManager->OnClientRequestedKeyframe(this);
+	}
 }
 
 void UVRRenderTargetManager::UpdateRelevancyMap()
@@ -672,36 +823,240 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	if (!RenderTarget)
 		return false;
 
-	RenderTargetStore.UnPackData();
+	// We don't have the texture this patch was made against (or one queued up), need the full thing
+	if (RenderTargetStore.bIsDeltaPatch && GetLatestTextureVersion() < RenderTargetStore.BaseVersion)
+	{
+		RenderTargetStore.Reset();
 
+		if (IsValid(LocalProxy))
+		{
+			LocalProxy->RequestTextureKeyframe();
+		}
 
-	int32 Width = RenderTargetStore.Width;
-	int32 Height = RenderTargetStore.Height;
-	EPixelFormat PixelFormat = RenderTargetStore.PixelFormat;
-	uint8 PixelFormat8 = 0;
+		return false;
+	}
 
-	TArray<FColor> FinalColorData;
-	FinalColorData.AddUninitialized(RenderTargetStore.UnpackedData.Num());
+	// A full texture makes anything still decoding irrelevant, patches have to wait their turn
+	if (!RenderTargetStore.bIsDeltaPatch)
+	{
+		for (const FRenderTargetDecodeJobPtr& PendingJob : DecodeJobs)
+		{
+			PendingJob->bCancelled = true;
+		}
+	}
 
-	uint32 Counter = 0;
-	FColor ColorVal;
-	ColorVal.A = 0xFF;
-	for (uint16 CompColor : RenderTargetStore.UnpackedData)
+	// Too far behind, throw it all out and catch up with a full copy instead
+	if (DecodeJobs.Num() >= MaxPendingDecodeJobs)
 	{
-		//CompColor.FillTo(ColorVal);
-		ColorVal.R = CompColor << 3;
-		ColorVal.G = CompColor >> 5 << 2;
-		ColorVal.B = CompColor >> 11 << 3;
-		ColorVal.A = 0xFF;
-		FinalColorData[Counter++] = ColorVal;
+		for (const FRenderTargetDecodeJobPtr& PendingJob : DecodeJobs)
+		{
+			PendingJob->bCancelled = true;
+		}
+
+		if (RenderTargetStore.bIsDeltaPatch)
+		{
+			RenderTargetStore.Reset();
+			AppliedTextureVersion = 0;
+
+			if (IsValid(LocalProxy))
+			{
+				LocalProxy->RequestTextureKeyframe();
+			}
+
+			return false;
+		}
 	}
 
+	FRenderTargetDecodeJobPtr Job = MakeShared<FRenderTargetDecodeJob, ESPMode::ThreadSafe>();
+	Job->Store = MoveTemp(RenderTargetStore);
+	RenderTargetStore.Reset();
+
+	// Unpacking and color conversion happens off of the game thread, the texture upload is published in tick
+	Job->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]()
+		{
+			if (!Job->bCancelled)
+			{
+				Job->bDecoded = DecodeTexturePayload(*Job);
+			}
+		});
+
+	DecodeJobs.Add(Job);
+	bIsLoadingTextureBuffer = true;
+	SetComponentTickEnabled(true);
+
+	return true;
+}
+
+bool UVRRenderTargetManager::DecodeTexturePayload(FRenderTargetDecodeJob& Job)
+{
+	FBPVRReplicatedTextureStore& Store = Job.Store;
+	Store.UnPackData();
+
+	const int32 Width = (int32)Store.Width;
+	const int32 Height = (int32)Store.Height;
+
+	if (Width <= 0 || Height <= 0)
+		return false;
+
+	if (!Store.bIsDeltaPatch)
+	{
+		if (Store.UnpackedData.Num() < Width * Height)
+			return false;
+
+		Job.TextureSize = FIntPoint(Width, Height);
+		Job.DestRect = FIntRect(0, 0, Width, Height);
+		Job.ColorData.SetNumUninitialized(Width * Height);
+		VRRenderTargetHelpers::ConvertColorsFrom565(Store.UnpackedData.GetData(), Job.ColorData.GetData(), Job.ColorData.Num());
+		return true;
+	}
+
+	const TArray<uint16>& PatchData = Store.UnpackedData;
+	const int32 TileSize = (int32)Store.TileSize;
+
+	if (PatchData.Num() < 1 || TileSize <= 0)
+		return false;
+
+	const int32 NumTiles = PatchData[0];
+	const int32 TilesX = FMath::DivideAndRoundUp(Width, TileSize);
+
+	if (PatchData.Num() < 1 + NumTiles)
+		return false;
+
+	// Nothing changed, still valid so that the version gets bumped
+	if (NumTiles < 1)
+	{
+		Job.DestRect = FIntRect();
+		return true;
+	}
+
+	// Bounds of all of the tiles in the patch, we upload a single texture covering it and skip the untouched pixels
+	FIntRect PatchRect(FIntPoint(Width, Height), FIntPoint(0, 0));
+	for (int32 i = 0; i < NumTiles; ++i)
+	{
+		const int32 TileIndex = PatchData[1 + i];
+		const FIntPoint TileMin((TileIndex % TilesX) * TileSize, (TileIndex / TilesX) * TileSize);
+		PatchRect.Min = PatchRect.Min.ComponentMin(TileMin);
+		PatchRect.Max = PatchRect.Max.ComponentMax(FIntPoint(FMath::Min(TileMin.X + TileSize, Width), FMath::Min(TileMin.Y + TileSize, Height)));
+	}
+
+	if (PatchRect.Width() <= 0 || PatchRect.Height() <= 0)
+		return false;
+
+	const int32 PatchWidth = PatchRect.Width();
+	Job.ColorData.SetNumZeroed(PatchWidth * PatchRect.Height());
+
+	int32 ReadOffset = 1 + NumTiles;
+	for (int32 i = 0; i < NumTiles; ++i)
+	{
+		if (Job.bCancelled)
+			return false;
+
+		const int32 TileIndex = PatchData[1 + i];
+		const FIntPoint TileMin((TileIndex % TilesX) * TileSize, (TileIndex / TilesX) * TileSize);
+		const FIntPoint TileMax(FMath::Min(TileMin.X + TileSize, Width), FMath::Min(TileMin.Y + TileSize, Height));
+		const int32 RowLength = TileMax.X - TileMin.X;
+
+		if (RowLength <= 0 || TileMax.Y <= TileMin.Y || ReadOffset + RowLength * (TileMax.Y - TileMin.Y) > PatchData.Num())
+			return false;
+
+		for (int32 Y = TileMin.Y; Y < TileMax.Y; ++Y)
+		{
+			FColor* DestRow = Job.ColorData.GetData() + ((Y - PatchRect.Min.Y) * PatchWidth + (TileMin.X - PatchRect.Min.X));
+			VRRenderTargetHelpers::ConvertColorsFrom565(PatchData.GetData() + ReadOffset, DestRow, RowLength);
+			ReadOffset += RowLength;
+		}
+	}
+
+	Job.TextureSize = PatchRect.Size();
+	Job.DestRect = PatchRect;
+	return true;
+}
+
+void UVRRenderTargetManager::PublishDecodedTextures()
+{
+	// Published strictly in the order received so that patches stack correctly
+	while (DecodeJobs.Num() > 0 && DecodeJobs[0]->Task.IsCompleted())
+	{
+		FRenderTargetDecodeJobPtr Job = DecodeJobs[0];
+		DecodeJobs.RemoveAt(0, 1, EAllowShrinking::No);
+
+		if (Job->bCancelled || !RenderTarget)
+			continue;
+
+		const FBPVRReplicatedTextureStore& Store = Job->Store;
+
+		if (!Job->bDecoded || (Store.bIsDeltaPatch && AppliedTextureVersion < Store.BaseVersion))
+		{
+			// Any patches queued behind this one are useless now too
+			for (const FRenderTargetDecodeJobPtr& PendingJob : DecodeJobs)
+			{
+				if (PendingJob->Store.bIsDeltaPatch)
+				{
+					PendingJob->bCancelled = true;
+				}
+			}
+
+			if (IsValid(LocalProxy))
+			{
+				LocalProxy->RequestTextureKeyframe();
+			}
+
+			continue;
+		}
+
+		if (!Store.bIsDeltaPatch)
+		{
+			DrawColorDataToRenderTarget(Job->ColorData, Job->TextureSize, FVector2D(0, 0), FVector2D(RenderTarget->SizeX, RenderTarget->SizeY), true);
+			AppliedTextureVersion = Store.Version;
+		}
+		else
+		{
+			if (Job->DestRect.Area() > 0)
+			{
+				// Scale into our render target in case it was made a different size than the servers
+				const FVector2D Scale((float)RenderTarget->SizeX / Store.Width, (float)RenderTarget->SizeY / Store.Height);
+				DrawColorDataToRenderTarget(Job->ColorData, Job->TextureSize, FVector2D(Job->DestRect.Min) * Scale, FVector2D(Job->DestRect.Size()) * Scale, false);
+			}
+
+			AppliedTextureVersion = FMath::Max(AppliedTextureVersion, Store.Version);
+		}
+	}
+
+	if (!DecodeJobs.Num() && bIsLoadingTextureBuffer)
+	{
+		bIsLoadingTextureBuffer = false;
+	}
+}
+
+uint32 UVRRenderTargetManager::GetLatestTextureVersion() const
+{
+	uint32 LatestVersion = AppliedTextureVersion;
+
+	for (const FRenderTargetDecodeJobPtr& PendingJob : DecodeJobs)
+	{
+		if (!PendingJob->bCancelled)
+		{
+			LatestVersion = FMath::Max(LatestVersion, PendingJob->Store.Version);
+		}
+	}
+
+	return LatestVersion;
+}
+
+void UVRRenderTargetManager::DrawColorDataToRenderTarget(const TArray<FColor>& FinalColorData, FIntPoint TextureSize, FVector2D DestPosition, FVector2D DestSize, bool bOpaque)
+{
+	int32 Width = TextureSize.X;
+	int32 Height = TextureSize.Y;
+
+	if (!RenderTarget || Width <= 0 || Height <= 0 || FinalColorData.Num() < Width * Height)
+		return;
+
 	// Write this to a texture2d
 	UTexture2D* RenderBase = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);// RenderTargetStore.PixelFormat);
 
 	// Switched to a Memcpy instead of byte by byte transer
 	uint8* MipData = (uint8*)RenderBase->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-	FMemory::Memcpy(MipData, (void*)FinalColorData.GetData(), FinalColorData.Num() * sizeof(FColor));
+	FMemory::Memcpy(MipData, (void*)FinalColorData.GetData(), Width * Height * sizeof(FColor));
 	RenderBase->GetPlatformData()->Mips[0].BulkData.Unlock();
 
 	//Setting some Parameters for the Texture and finally returning it
@@ -760,8 +1115,8 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	if (CanvasToUse)
 	{
 		FTexture* RenderTextureResource = (RenderBase) ? RenderBase->GetResource() : GWhiteTexture;
-		FCanvasTileItem TileItem(FVector2D(0, 0), RenderTextureResource, FVector2D(RenderTarget->SizeX, RenderTarget->SizeY), FVector2D(0, 0), FVector2D(1.f, 1.f), FLinearColor::White);
-		TileItem.BlendMode = FCanvas::BlendToSimpleElementBlend(EBlendMode::BLEND_Opaque);
+		FCanvasTileItem TileItem(DestPosition, RenderTextureResource, DestSize, FVector2D(0, 0), FVector2D(1.f, 1.f), FLinearColor::White);
+		TileItem.BlendMode = FCanvas::BlendToSimpleElementBlend(bOpaque ? EBlendMode::BLEND_Opaque : EBlendMode::BLEND_Translucent);
 		CanvasToUse->DrawItem(TileItem);
 
 
@@ -774,8 +1129,6 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 
 	RenderBase->ReleaseResource();
 	RenderBase->MarkAsGarbage();
-
-	return true;
 }
 
 void UVRRenderTargetManager::QueueImageStore()
@@ -799,6 +1152,41 @@ void UVRRenderTargetManager::QueueImageStore()
 
 	renderData->Size2D = renderTargetResource->GetSizeXY();
 	renderData->PixelFormat = RenderTarget->GetFormat();
+	renderData->ReadRect = FIntRect(0, 0, renderData->Size2D.X, renderData->Size2D.Y);
+	renderData->Version = TextureVersion;
+
+	if (bUseDeltaTextureReplication && TileVersions.Num() > 0)
+	{
+		renderData->TileVersions = TileVersions;
+		renderData->bIsFullRead = false;
+		renderData->ReadBaseVersion = TextureVersion;
+
+		// Only need the full texture if someone hasn't gotten a keyframe yet, otherwise read
+		// back the area covering everything drawn since the oldest client sync
+		for (const FClientRepData& RepData : NetRelevancyLog)
+		{
+			if (!RepData.bIsDirty)
+				continue;
+
+			if (RepData.SyncedTextureVersion == 0)
+			{
+				renderData->bIsFullRead = true;
+				break;
+			}
+
+			renderData->ReadBaseVersion = FMath::Min(renderData->ReadBaseVersion, RepData.SyncedTextureVersion);
+		}
+
+		if (renderData->bIsFullRead)
+		{
+			renderData->ReadBaseVersion = 0;
+		}
+		else if (!GetDirtyTileRect(renderData->ReadBaseVersion, renderData->ReadRect))
+		{
+			// Nothing was drawn since then, clients get an empty patch
+			renderData->ReadRect = FIntRect();
+		}
+	}
 
 	struct FReadSurfaceContext {
 		FRenderTarget* SrcRenderTarget;
@@ -812,19 +1200,22 @@ void UVRRenderTargetManager::QueueImageStore()
 	{
 		renderTargetResource,
 		&(renderData->ColorData),
-		FIntRect(0,0,renderTargetResource->GetSizeXY().X, renderTargetResource->GetSizeXY().Y),
+		renderData->ReadRect,
 		FReadSurfaceDataFlags(RCM_UNorm, CubeFace_MAX)
 	};
 
-	ENQUEUE_RENDER_COMMAND(SceneDrawCompletion)(
-		[readSurfaceContext](FRHICommandListImmediate& RHICmdList) {
-			RHICmdList.ReadSurfaceData(
-				readSurfaceContext.SrcRenderTarget->GetRenderTargetTexture(),
-				readSurfaceContext.Rect,
-				*readSurfaceContext.OutData,
-				readSurfaceContext.Flags
-			);
-		});
+	if (readSurfaceContext.Rect.Area() > 0)
+	{
+		ENQUEUE_RENDER_COMMAND(SceneDrawCompletion)(
+			[readSurfaceContext](FRHICommandListImmediate& RHICmdList) {
+				RHICmdList.ReadSurfaceData(
+					readSurfaceContext.SrcRenderTarget->GetRenderTargetTexture(),
+					readSurfaceContext.Rect,
+					*readSurfaceContext.OutData,
+					readSurfaceContext.Flags
+				);
+			});
+	}
 
 	// Notify new task in RenderQueue
 	RenderDataQueue.Enqueue(renderData);
@@ -839,72 +1230,375 @@ void UVRRenderTargetManager::TickComponent(float DeltaTime, enum ELevelTick Tick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// Read pixels once RenderFence is completed
-	if (!bInitiallyReplicateTexture || RenderDataQueue.IsEmpty() || GetNetMode() == ENetMode::NM_DedicatedServer)
+	// Client side, upload anything that finished decoding
+	PublishDecodedTextures();
+
+	if (bInitiallyReplicateTexture && GetNetMode() != ENetMode::NM_DedicatedServer)
+	{
+		// Send out anything that finished encoding
+		PublishEncodedTextures();
+
+		// Read pixels once RenderFence is completed, hold it in the queue if we are already at our encode limit
+		FRenderDataStore* nextRenderData = nullptr;
+		if (RenderDataQueue.Peek(nextRenderData) && nextRenderData && nextRenderData->RenderFence.IsFenceComplete() && EncodeJobs.Num() < MaxPendingEncodeJobs)
+		{
+			bIsStoringImage = false;
+			RenderDataQueue.Pop();
+			LaunchEncodeJob(nextRenderData);
+		}
+	}
+
+	if (RenderDataQueue.IsEmpty() && !EncodeJobs.Num() && !DecodeJobs.Num())
 	{
 		SetComponentTickEnabled(false);
 	}
-	else
+}
+
+void UVRRenderTargetManager::LaunchEncodeJob(FRenderDataStore* ReadData)
+{
+	// This read is newer than anything still encoding, they would just be sending stale data
+	for (const FRenderTargetEncodeJobPtr& PendingJob : EncodeJobs)
+	{
+		PendingJob->bCancelled = true;
+	}
+
+	FRenderTargetEncodeJobPtr Job = MakeShared<FRenderTargetEncodeJob, ESPMode::ThreadSafe>();
+	Job->ReadData = ReadData;
+	Job->bIsDelta = bUseDeltaTextureReplication && ReadData->TileVersions.Num() > 0;
+	Job->TileSize = TrackedTileSize;
+	Job->TileCount = TileCount;
+
+	// Work out what the currently dirty clients will need out of this read
+	for (const FClientRepData& RepData : NetRelevancyLog)
+	{
+		if (!RepData.bIsDirty || !IsValid(RepData.PC) || RepData.PC->IsLocalController() || !IsValid(RepData.ReplicationProxy))
+			continue;
+
+		const uint32 BaseVersion = RepData.SyncedTextureVersion;
+
+		if (!Job->bIsDelta || BaseVersion == 0)
+		{
+			Job->bBuildKeyframe |= ReadData->bIsFullRead;
+		}
+		else if (BaseVersion < ReadData->Version && (ReadData->bIsFullRead || BaseVersion >= ReadData->ReadBaseVersion))
+		{
+			Job->PatchBaseVersions.AddUnique(BaseVersion);
+		}
+	}
+
+	Job->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]()
+		{
+			EncodeTexturePayloads(*Job);
+		});
+
+	EncodeJobs.Add(Job);
+}
+
+void UVRRenderTargetManager::EncodeTexturePayloads(FRenderTargetEncodeJob& Job)
+{
+	const FRenderDataStore& ReadData = *Job.ReadData;
+
+	if (Job.bBuildKeyframe && !Job.bCancelled)
+	{
+		TSharedRef<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe> NewKeyframe = MakeShared<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe>();
+		NewKeyframe->UnpackedData.SetNumUninitialized(ReadData.ColorData.Num());
+		VRRenderTargetHelpers::ConvertColorsTo565(ReadData.ColorData.GetData(), NewKeyframe->UnpackedData.GetData(), ReadData.ColorData.Num());
+		NewKeyframe->Width = ReadData.Size2D.X;
+		NewKeyframe->Height = ReadData.Size2D.Y;
+		NewKeyframe->PixelFormat = ReadData.PixelFormat;
+		NewKeyframe->Version = ReadData.Version;
+		NewKeyframe->PackData();
+		Job.Keyframe = NewKeyframe;
+	}
+
+	for (uint32 BaseVersion : Job.PatchBaseVersions)
+	{
+		if (Job.bCancelled)
+			return;
+
+		TSharedRef<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe> NewPatch = MakeShared<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe>();
+		BuildTexturePatch(ReadData, Job.TileSize, Job.TileCount, BaseVersion, *NewPatch);
+		Job.Patches.Add(BaseVersion, NewPatch);
+	}
+}
+
+void UVRRenderTargetManager::PublishEncodedTextures()
+{
+	bool bNeedsAnotherRead = false;
+
+	while (EncodeJobs.Num() > 0 && EncodeJobs[0]->Task.IsCompleted())
+	{
+		FRenderTargetEncodeJobPtr Job = EncodeJobs[0];
+		EncodeJobs.RemoveAt(0, 1, EAllowShrinking::No);
+
+		if (!Job->bCancelled)
+		{
+			bNeedsAnotherRead |= SendTextureUpdates(*Job);
+		}
+	}
+
+	// Some clients needed more of the texture than the read covered
+	if (bNeedsAnotherRead)
+	{
+		QueueImageStore();
+	}
+}
+
+void UVRRenderTargetManager::InitTileTracking()
+{
+	TileVersions.Reset();
+	TileCount = FIntPoint::ZeroValue;
+	TextureVersion = 0;
+
+	if (!RenderTarget || !bUseDeltaTextureReplication || GetNetMode() >= ENetMode::NM_Client)
+		return;
+
+	TrackedTileSize = FMath::Max(DeltaTileSize, VRRenderTargetHelpers::MinTileSize);
+
+	// Tiles are indexed with 16 bits in the patches, grow them until they fit
+	while (FMath::DivideAndRoundUp((int32)RenderTarget->SizeX, TrackedTileSize) * FMath::DivideAndRoundUp((int32)RenderTarget->SizeY, TrackedTileSize) > VRRenderTargetHelpers::MaxTileCount)
+	{
+		TrackedTileSize *= 2;
+	}
+
+	TileCount.X = FMath::DivideAndRoundUp((int32)RenderTarget->SizeX, TrackedTileSize);
+	TileCount.Y = FMath::DivideAndRoundUp((int32)RenderTarget->SizeY, TrackedTileSize);
+	TileVersions.SetNumZeroed(TileCount.X * TileCount.Y);
+}
+
+void UVRRenderTargetManager::MarkOperationDirty(const FRenderManagerOperation& Operation)
+{
+	FBox2D Region(ForceInit);
+
+	switch (Operation.OperationType)
+	{
+	case ERenderManagerOperationType::Op_LineDraw:
+	{
+		Region += Operation.P1;
+		Region += Operation.P2;
+		Region = Region.ExpandBy((Operation.Thickness * 0.5f) + 1.0f);
+	}break;
+	case ERenderManagerOperationType::Op_TexDraw:
+	{
+		// DrawOperation skips textures that aren't loaded
+		if (Operation.Texture && Operation.Texture->GetResource())
+		{
+			Region += Operation.P1;
+			Region += Operation.P1 + FVector2D(Operation.Texture->GetSizeX(), Operation.Texture->GetSizeY());
+			Region = Region.ExpandBy(1.0f);
+		}
+	}break;
+	case ERenderManagerOperationType::Op_TriDraw:
+	{
+		for (const FRenderManagerTri& Tri : Operation.Tris)
+		{
+			Region += Tri.P1;
+			Region += Tri.P2;
+			Region += Tri.P3;
+		}
+
+		Region = Region.ExpandBy(1.0f);
+	}break;
+	}
+
+	MarkRegionDirty(Region);
+}
+
+void UVRRenderTargetManager::MarkRegionDirty(const FBox2D& Region)
+{
+	if (!Region.bIsValid || !TileVersions.Num() || !RenderTarget)
+		return;
+
+	const int32 SizeX = RenderTarget->SizeX;
+	const int32 SizeY = RenderTarget->SizeY;
+
+	// Entirely off of the texture
+	if (Region.Max.X < 0.0 || Region.Max.Y < 0.0 || Region.Min.X >= SizeX || Region.Min.Y >= SizeY)
+		return;
+
+	const int32 MinTileX = FMath::Clamp(FMath::FloorToInt32(Region.Min.X), 0, SizeX - 1) / TrackedTileSize;
+	const int32 MinTileY = FMath::Clamp(FMath::FloorToInt32(Region.Min.Y), 0, SizeY - 1) / TrackedTileSize;
+	const int32 MaxTileX = FMath::Clamp(FMath::CeilToInt32(Region.Max.X), 0, SizeX - 1) / TrackedTileSize;
+	const int32 MaxTileY = FMath::Clamp(FMath::CeilToInt32(Region.Max.Y), 0, SizeY - 1) / TrackedTileSize;
+
+	for (int32 TileY = MinTileY; TileY <= MaxTileY; ++TileY)
 	{
-		// Peek the next RenderRequest from queue
-		FRenderDataStore* nextRenderData;
-		RenderDataQueue.Peek(nextRenderData);
+		for (int32 TileX = MinTileX; TileX <= MaxTileX; ++TileX)
+		{
+			TileVersions[TileY * TileCount.X + TileX] = TextureVersion;
+		}
+	}
+}
+
+bool UVRRenderTargetManager::GetDirtyTileRect(uint32 SinceVersion, FIntRect& OutRect) const
+{
+	if (!RenderTarget)
+		return false;
 
-		if (nextRenderData)
+	FIntPoint MinTile(TileCount.X, TileCount.Y);
+	FIntPoint MaxTile(-1, -1);
+
+	for (int32 TileY = 0; TileY < TileCount.Y; ++TileY)
+	{
+		for (int32 TileX = 0; TileX < TileCount.X; ++TileX)
 		{
-			if (nextRenderData->RenderFence.IsFenceComplete())
+			if (TileVersions[TileY * TileCount.X + TileX] > SinceVersion)
 			{
-				bIsStoringImage = false;
-				RenderTargetStore.Reset();
-				uint32 SizeOfData = nextRenderData->ColorData.Num();
+				MinTile = MinTile.ComponentMin(FIntPoint(TileX, TileY));
+				MaxTile = MaxTile.ComponentMax(FIntPoint(TileX, TileY));
+			}
+		}
+	}
 
-				RenderTargetStore.UnpackedData.Reset(SizeOfData);
-				RenderTargetStore.UnpackedData.AddUninitialized(SizeOfData);
+	if (MaxTile.X < 0)
+		return false;
 
-				uint16 ColorVal = 0;
-				uint32 Counter = 0;
+	OutRect.Min = MinTile * TrackedTileSize;
+	OutRect.Max.X = FMath::Min((MaxTile.X + 1) * TrackedTileSize, (int32)RenderTarget->SizeX);
+	OutRect.Max.Y = FMath::Min((MaxTile.Y + 1) * TrackedTileSize, (int32)RenderTarget->SizeY);
+	return true;
+}
 
-				// Convert to 16bit color
-				for (FColor col : nextRenderData->ColorData)
-				{
-					ColorVal = (col.R >> 3) << 11 | (col.G >> 2) << 5 | (col.B >> 3);
-					RenderTargetStore.UnpackedData[Counter++] = ColorVal;
-				}
+void UVRRenderTargetManager::BuildTexturePatch(const FRenderDataStore& ReadData, int32 TrackedTileSize, FIntPoint TileCount, uint32 BaseVersion, FBPVRReplicatedTextureStore& OutPatch)
+{
+	OutPatch.Reset();
+	OutPatch.bIsDeltaPatch = true;
+	OutPatch.TileSize = (uint32)TrackedTileSize;
+	OutPatch.BaseVersion = BaseVersion;
+	OutPatch.Version = ReadData.Version;
+	OutPatch.Width = ReadData.Size2D.X;
+	OutPatch.Height = ReadData.Size2D.Y;
+	OutPatch.PixelFormat = ReadData.PixelFormat;
 
-				FIntPoint Size2D = nextRenderData->Size2D;
-				RenderTargetStore.Width = Size2D.X;
-				RenderTargetStore.Height = Size2D.Y;
-				RenderTargetStore.PixelFormat = nextRenderData->PixelFormat;
-				RenderTargetStore.PackData();
+	const FIntRect& ReadRect = ReadData.ReadRect;
+	const int32 ReadWidth = ReadRect.Width();
 
+	TArray<int32> PatchTiles;
+	int32 PixelCount = 0;
 
-//#if WITH_PUSH_MODEL
-				//MARK_PROPERTY_DIRTY_FROM_NAME(UVRRenderTargetManager, RenderTargetStore, this);
-//#endif
+	for (int32 TileIndex = 0; TileIndex < ReadData.TileVersions.Num(); ++TileIndex)
+	{
+		if (ReadData.TileVersions[TileIndex] <= BaseVersion)
+			continue;
 
+		const FIntPoint TileMin((TileIndex % TileCount.X) * TrackedTileSize, (TileIndex / TileCount.X) * TrackedTileSize);
+		const FIntPoint TileMax(FMath::Min(TileMin.X + TrackedTileSize, ReadData.Size2D.X), FMath::Min(TileMin.Y + TrackedTileSize, ReadData.Size2D.Y));
 
-				// Delete the first element from RenderQueue
-				RenderDataQueue.Pop();
-				delete nextRenderData;
+		// Should never happen, the read covers everything newer than the oldest base we send from
+		if (!ensure(ReadRect.Contains(TileMin) && TileMax.X <= ReadRect.Max.X && TileMax.Y <= ReadRect.Max.Y))
+			continue;
 
-				for (int i = NetRelevancyLog.Num() - 1; i >= 0; i--)
-				{
-					if (NetRelevancyLog[i].bIsDirty && IsValid(NetRelevancyLog[i].PC) && !NetRelevancyLog[i].PC->IsLocalController())
-					{
-						if (IsValid(NetRelevancyLog[i].ReplicationProxy))
-						{
-							NetRelevancyLog[i].ReplicationProxy->TextureStore = RenderTargetStore;
-							NetRelevancyLog[i].ReplicationProxy->SendInitMessage();
-							NetRelevancyLog[i].bIsDirty = false;
-						}
-					}
-				}
+		PatchTiles.Add(TileIndex);
+		PixelCount += (TileMax.X - TileMin.X) * (TileMax.Y - TileMin.Y);
+	}
+
+	OutPatch.UnpackedData.Reset(1 + PatchTiles.Num() + PixelCount);
+	OutPatch.UnpackedData.Add((uint16)PatchTiles.Num());
+
+	for (int32 TileIndex : PatchTiles)
+	{
+		OutPatch.UnpackedData.Add((uint16)TileIndex);
+	}
+
+	for (int32 TileIndex : PatchTiles)
+	{
+		const FIntPoint TileMin((TileIndex % TileCount.X) * TrackedTileSize, (TileIndex / TileCount.X) * TrackedTileSize);
+		const FIntPoint TileMax(FMath::Min(TileMin.X + TrackedTileSize, ReadData.Size2D.X), FMath::Min(TileMin.Y + TrackedTileSize, ReadData.Size2D.Y));
+		const int32 RowLength = TileMax.X - TileMin.X;
+
+		for (int32 Y = TileMin.Y; Y < TileMax.Y; ++Y)
+		{
+			const FColor* SrcRow = ReadData.ColorData.GetData() + ((Y - ReadRect.Min.Y) * ReadWidth + (TileMin.X - ReadRect.Min.X));
+			const int32 DestOffset = OutPatch.UnpackedData.AddUninitialized(RowLength);
+			VRRenderTargetHelpers::ConvertColorsTo565(SrcRow, OutPatch.UnpackedData.GetData() + DestOffset, RowLength);
+		}
+	}
 
+	OutPatch.PackData();
+}
 
+bool UVRRenderTargetManager::SendTextureUpdates(const FRenderTargetEncodeJob& Job)
+{
+	bool bNeedsAnotherRead = false;
+	const FRenderDataStore& ReadData = *Job.ReadData;
+
+	for (int i = NetRelevancyLog.Num() - 1; i >= 0; i--)
+	{
+		FClientRepData& RepData = NetRelevancyLog[i];
+
+		if (!RepData.bIsDirty || !IsValid(RepData.PC) || RepData.PC->IsLocalController() || !IsValid(RepData.ReplicationProxy))
+			continue;
+
+		const uint32 BaseVersion = RepData.SyncedTextureVersion;
+
+		if (!Job.bIsDelta || BaseVersion == 0)
+		{
+			// Became dirty after the read was planned or the read didn't cover the whole texture
+			if (!Job.Keyframe.IsValid())
+			{
+				bNeedsAnotherRead = true;
+				continue;
+			}
+
+			RepData.ReplicationProxy->SendTexture(Job.Keyframe);
+		}
+		else
+		{
+			if (BaseVersion >= ReadData.Version)
+			{
+				// Already has everything in this read
+				RepData.bIsDirty = false;
+				continue;
+			}
+
+			// Encoded once and shared by every client that synced to the same version
+			const FBPVRSharedTextureStorePtr* Patch = Job.Patches.Find(BaseVersion);
+			if (!Patch)
+			{
+				bNeedsAnotherRead = true;
+				continue;
 			}
+
+			RepData.ReplicationProxy->SendTexture(*Patch);
 		}
+
+		RepData.ReplicationProxy->PendingTextureVersion = ReadData.Version;
+		RepData.bIsDirty = false;
+	}
+
+	return bNeedsAnotherRead;
+}
+
+void UVRRenderTargetManager::OnClientTextureSynced(ARenderTargetReplicationProxy* Proxy, uint32 Version)
+{
+	FClientRepData* RepData = NetRelevancyLog.FindByPredicate([Proxy](const FClientRepData& Other)
+		{
+			return Other.ReplicationProxy == Proxy;
+		});
+
+	if (RepData)
+	{
+		RepData->SyncedTextureVersion = Version;
 	}
+}
+
+void UVRRenderTargetManager::OnClientRequestedKeyframe(ARenderTargetReplicationProxy* Proxy)
+{
+	FClientRepData* RepData = NetRelevancyLog.FindByPredicate([Proxy](const FClientRepData& Other)
+		{
+			return Other.ReplicationProxy == Proxy;
+		});
+
+	if (RepData)
+	{
+		RepData->SyncedTextureVersion = 0;
 
+		if (RepData->bIsRelevant)
+		{
+			RepData->bIsDirty = true;
+			QueueImageStore();
+		}
+	}
 }
 
 void UVRRenderTargetManager::BeginPlay()
@@ -932,6 +1626,19 @@ void UVRRenderTargetManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		}
 	}
 
+	// The jobs own their data, in flight ones will finish on their own and be released
+	for (const FRenderTargetEncodeJobPtr& PendingJob : EncodeJobs)
+	{
+		PendingJob->bCancelled = true;
+	}
+	EncodeJobs.Empty();
+
+	for (const FRenderTargetDecodeJobPtr& PendingJob : DecodeJobs)
+	{
+		PendingJob->bCancelled = true;
+	}
+	DecodeJobs.Empty();
+
 	if (GetNetMode() < ENetMode::NM_Client)
 		GetWorld()->GetTimerManager().ClearTimer(NetRelevancyTimer_Handle);
 
@@ -976,6 +1683,7 @@ void UVRRenderTargetManager::InitRenderTarget()
 			RenderTarget->ClearColor = ClearColor;
 			RenderTarget->bAutoGenerateMips = false;
 			RenderTarget->UpdateResourceImmediate(true);
+			InitTileTracking();
 		}
 		else
 		{
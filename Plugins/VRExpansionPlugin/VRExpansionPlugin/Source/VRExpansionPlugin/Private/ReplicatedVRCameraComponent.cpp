@@ -89,6 +89,26 @@ void UReplicatedVRCameraComponent::GetLifetimeReplicatedProps(TArray< class FLif
 	//DOREPLIFETIME(UReplicatedVRCameraComponent, bReplicateTransform);
 }
 
+void UReplicatedVRCameraComponent::PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// The owning character can throttle the pose out to the other players based on how far / visible we are to them
+	if (AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner()))
+	{
+		const bool bReplicatePose = OwningChar->ShouldReplicateTrackedPoses();
+		DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(UReplicatedVRCameraComponent, ReplicatedCameraTransform, bReplicatePose);
+
+#if WITH_PUSH_MODEL
+		// Changes made while we were throttled had their dirty state consumed, make sure the latest gets compared
+		if (bReplicatePose && OwningChar->bThrottleTrackedPoseReplication)
+		{
+			MARK_PROPERTY_DIRTY_FROM_NAME(UReplicatedVRCameraComponent, ReplicatedCameraTransform, this);
+		}
+#endif
+	}
+}
+
 void UReplicatedVRCameraComponent::Server_SendCameraTransform_Implementation(FBPVRComponentPosRep NewTransform)
 {
 	// Store new transform and trigger OnRep_Function
@@ -262,7 +282,22 @@ void UReplicatedVRCameraComponent::RunNetworkedSmoothing(float DeltaTime)
 
 	if (bLerpingPosition)
 	{
-		if (!bUseExponentialSmoothing)
+		if (bUseSnapshotInterpolation)
+		{
+			const double RenderTime = GetWorld()->GetTimeSeconds() - SnapshotInterpolationDelay;
+
+			FVector NewPosition = GetRelativeLocation();
+			FQuat NewRotation = GetRelativeRotation().Quaternion();
+			PoseSnapshotBuffer.Sample(RenderTime, SnapshotMaxExtrapolationTime, NewPosition, NewRotation);
+			SetRelativeLocationAndRotation(NewPosition, NewRotation);
+
+			// Nothing new for long enough that we are just holding, stop until the next update
+			if (PoseSnapshotBuffer.IsEmpty() || RenderTime > PoseSnapshotBuffer.GetNewestTime() + SnapshotMaxExtrapolationTime)
+			{
+				bLerpingPosition = false;
+			}
+		}
+		else if (!bUseExponentialSmoothing)
 		{
 			NetUpdateCount += DeltaTime;
 			float LerpVal = FMath::Clamp(NetUpdateCount / (1.0f / NetUpdateRate), 0.0f, 1.0f);
@@ -396,7 +431,8 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 			{
 				NetUpdateCount += DeltaTime;
 
-				if (NetUpdateCount >= (1.0f / NetUpdateRate))
+				const float SendRate = AdaptiveNetUpdateSettings.GetNetUpdateRate(NetUpdateRate, RelativeLoc - LastUpdatesRelativePosition, RelativeRot - LastUpdatesRelativeRotation, NetUpdateCount);
+				if (NetUpdateCount >= (1.0f / SendRate))
 				{
 					NetUpdateCount = 0.0f;
 
@@ -549,7 +585,24 @@ void UReplicatedVRCameraComponent::OnRep_ReplicatedCameraTransform()
     
     if (bSmoothReplicatedMotion)
     {
-        if (bReppedOnce)
+		if (bUseSnapshotInterpolation)
+		{
+			// Buffering the already offset position, the roomscale offset is applied per update here anyway
+			const bool bTooFar = !PoseSnapshotBuffer.IsEmpty() &&
+				FVector::DistSquared(CameraPosition, GetRelativeLocation()) >= FMath::Square(NetworkNoSmoothUpdateDistance);
+
+			// Start over on the first update or if we teleported
+			if (!bReppedOnce || bTooFar)
+			{
+				PoseSnapshotBuffer.Reset();
+				SetRelativeLocationAndRotation(CameraPosition, ReplicatedCameraTransform.Rotation);
+				bReppedOnce = true;
+			}
+
+			PoseSnapshotBuffer.AddSnapshot(GetWorld()->GetTimeSeconds(), 1.0f / FMath::Max(NetUpdateRate, 1.0f), CameraPosition, ReplicatedCameraTransform.Rotation);
+			bLerpingPosition = true;
+		}
+        else if (bReppedOnce)
         {
             bLerpingPosition = true;
             NetUpdateCount = 0.0f;
@@ -6,6 +6,10 @@
 #include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
 #include "Iris/ReplicationState/ReplicationStateDescriptorBuilder.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("PosRep ~ Full Serializes"), STAT_PosRepFullSerializes, STATGROUP_VRNetSerializers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PosRep ~ Full Bits"), STAT_PosRepFullBits, STATGROUP_VRNetSerializers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PosRep ~ Delta Serializes"), STAT_PosRepDeltaSerializes, STATGROUP_VRNetSerializers);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PosRep ~ Delta Bits"), STAT_PosRepDeltaBits, STATGROUP_VRNetSerializers);
 
 namespace UE::Net
 {
@@ -15,25 +19,11 @@ namespace UE::Net
     // -----------------------------------------------------------------------------
     struct FBPVRComponentPosRepNetSerializer
     {
-
-        inline static const FVectorNetQuantize10NetSerializerConfig Quantize10SerializerConfig;
-        inline static const FVectorNetQuantize100NetSerializerConfig Quantize100SerializerConfig;
-
-        inline static const FNetSerializerConfig* VectorNetQuantizeNetSerializerConfigs[2] = { &Quantize10SerializerConfig, &Quantize100SerializerConfig};
-        inline static const FNetSerializer* VectorNetQuantizeNetSerializers[2] = {};
-
-
         class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
         {
         public:
             virtual ~FNetSerializerRegistryDelegates();
 
-            void InitNetSerializer()
-            {
-                FBPVRComponentPosRepNetSerializer::VectorNetQuantizeNetSerializers[0] = &UE_NET_GET_SERIALIZER(FVectorNetQuantize10NetSerializer);
-                FBPVRComponentPosRepNetSerializer::VectorNetQuantizeNetSerializers[1] = &UE_NET_GET_SERIALIZER(FVectorNetQuantize100NetSerializer);
-            }
-
         private:
             virtual void OnPreFreezeNetSerializerRegistry() override;
             //virtual void OnPostFreezeNetSerializerRegistry() override;
@@ -45,71 +35,138 @@ namespace UE::Net
         /** Version is required. */
         static constexpr uint32 Version = 0;
 
-        struct alignas(8) FQuantizedData
-        {
-            uint64 Position[4]; // We don't need to store double for tracked device positions, but their forwarded serializer uses it
-            uint16 Rotation[3];
-
-            uint8 QuantizationLevel : 1;
-            uint8 RotationQuantizationLevel : 1;
-        };
-
         typedef FBPVRComponentPosRep SourceType;
-        typedef FQuantizedData QuantizedType;
+        typedef FBPVRComponentPosRepQuantizedData QuantizedType;
         typedef FBPVRComponentPosRepNetSerializerConfig ConfigType;
         inline static const ConfigType DefaultConfig;
 
         /** Set to false when a same value delta compression method is undesirable, for example when the serializer only writes a single bit for the state. */
-        static constexpr bool bUseDefaultDelta = true;
-        // Not doing delta, the majority of the time a single bit (bool) controls the serialization of the entirity
-        
-        /**
-         * Optional. Same as Serialize but where an acked previous state is provided for bitpacking purposes.
-         * This is implemented by default to do same value optimization, at the cost of a bit. If implemented
-         * then DeserializeDelta is required.
-         */
-         /*static void SerializeDelta(FNetSerializationContext&, const FNetSerializeDeltaArgs&)
-         {
+        static constexpr bool bUseDefaultDelta = false;
+        // We implement our own delta below, tracked devices move a few mm per update so the residuals are tiny
+
+        // Matches the ranges of the archive NetSerialize, 22 bits at 2 decimals and 18 bits at 1 decimal
+        static constexpr int32 PositionScales[2] = { 10, 100 };
+        static constexpr uint32 PositionMaxBits[2] = { 18, 22 };
+
+        // Enough to hold the bit count of any of the zigzag encoded values below (max 25 bits, counts up to 31 fit)
+        static constexpr uint32 BitCountBits = 5;
+
+        static uint32 GetRotationBits(uint8 RotationQuantizationLevel)
+        {
+            return (EVRRotationQuantization)RotationQuantizationLevel == EVRRotationQuantization::RoundTo10Bits ? 10 : 16;
+        }
+
+        static uint32 ZigZagEncode(int32 Value)
+        {
+            return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+        }
+
+        static int32 ZigZagDecode(uint32 Value)
+        {
+            return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+        }
+
+        // Writes three signed values with a shared bit count, the count is sized to the largest of them
+        static void WriteAdaptiveTriplet(FNetBitStreamWriter* Writer, const int32 Values[3])
+        {
+            uint32 Encoded[3];
+            uint32 CombinedBits = 0;
+            for (int32 i = 0; i < 3; ++i)
+            {
+                Encoded[i] = ZigZagEncode(Values[i]);
+                CombinedBits |= Encoded[i];
+            }
+
+            const uint32 NumBits = CombinedBits ? FMath::FloorLog2(CombinedBits) + 1 : 0;
+            Writer->WriteBits(NumBits, BitCountBits);
+
+            if (NumBits > 0)
+            {
+                for (int32 i = 0; i < 3; ++i)
+                {
+                    Writer->WriteBits(Encoded[i], NumBits);
+                }
+            }
+        }
+
+        static void ReadAdaptiveTriplet(FNetBitStreamReader* Reader, int32 OutValues[3])
+        {
+            const uint32 NumBits = Reader->ReadBits(BitCountBits);
+
+            for (int32 i = 0; i < 3; ++i)
+            {
+                OutValues[i] = NumBits > 0 ? ZigZagDecode(Reader->ReadBits(NumBits)) : 0;
+            }
+        }
+
+        // Shortest signed distance between two compressed axis values, wraps around the same as the angles do
+        static int32 GetRotationResidual(uint16 Current, uint16 Previous, uint32 RotationBits)
+        {
+            const uint32 Mask = (1U << RotationBits) - 1U;
+            const uint32 Diff = (static_cast<uint32>(Current) - static_cast<uint32>(Previous)) & Mask;
+            const uint32 SignBit = 1U << (RotationBits - 1U);
+            return static_cast<int32>(Diff ^ SignBit) - static_cast<int32>(SignBit);
+        }
+
+        static uint16 ApplyRotationResidual(uint16 Previous, int32 Residual, uint32 RotationBits)
+        {
+            const uint32 Mask = (1U << RotationBits) - 1U;
+            return static_cast<uint16>((static_cast<uint32>(Previous) + static_cast<uint32>(Residual)) & Mask);
+        }
+
+        static void SerializeFull(FNetBitStreamWriter* Writer, const QuantizedType& Source)
+        {
+            Writer->WriteBits(static_cast<uint32>(Source.QuantizationLevel), 1);
+            Writer->WriteBits(static_cast<uint32>(Source.RotationQuantizationLevel), 1);
+
+            WriteAdaptiveTriplet(Writer, Source.Position);
 
-         }*/
+            const uint32 RotationBits = GetRotationBits(Source.RotationQuantizationLevel);
+            Writer->WriteBits(static_cast<uint32>(Source.Rotation[0]), RotationBits);
+            Writer->WriteBits(static_cast<uint32>(Source.Rotation[1]), RotationBits);
+            Writer->WriteBits(static_cast<uint32>(Source.Rotation[2]), RotationBits);
+        }
 
-         /**
-          * Optional. Same as Deserialize but where an acked previous state is provided for bitpacking purposes.
-          * This is implemented by default to do same value optimization, at the cost of a bit. If implemented
-          * then SerializeDelta is required.
-          */
-          /*static void DeserializeDelta(FNetSerializationContext&, const FNetDeserializeDeltaArgs&)
-          {
+        static void DeserializeFull(FNetBitStreamReader* Reader, QuantizedType& Target)
+        {
+            Target.QuantizationLevel = Reader->ReadBits(1);
+            Target.RotationQuantizationLevel = Reader->ReadBits(1);
 
-          }*/
+            ReadAdaptiveTriplet(Reader, Target.Position);
+
+            const uint32 RotationBits = GetRotationBits(Target.RotationQuantizationLevel);
+            Target.Rotation[0] = static_cast<uint16>(Reader->ReadBits(RotationBits));
+            Target.Rotation[1] = static_cast<uint16>(Reader->ReadBits(RotationBits));
+            Target.Rotation[2] = static_cast<uint16>(Reader->ReadBits(RotationBits));
+        }
 
           // Called to create a "quantized snapshot" of the struct
         static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
         {
-            // Actually do the real quantization step here next instead of just in serialize, will save on memory overall
             const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
             QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
-            
+
+            // IsEqual memcmps the quantized state, don't leave garbage in the padding
+            FMemory::Memzero(&Target, sizeof(QuantizedType));
+
             Target.QuantizationLevel = (uint8)Source.QuantizationLevel;
             Target.RotationQuantizationLevel = (uint8)Source.RotationQuantizationLevel;
 
-            const FNetSerializer* Serializer = VectorNetQuantizeNetSerializers[Target.QuantizationLevel] ;
-            const FNetSerializerConfig* SerializerConfig = VectorNetQuantizeNetSerializerConfigs[Target.QuantizationLevel] ;
-
-            FNetQuantizeArgs MemberArgs = Args;
-            MemberArgs.NetSerializerConfig = NetSerializerConfigParam(SerializerConfig);
-            MemberArgs.Source = NetSerializerValuePointer(&Source.Position);
-            MemberArgs.Target = NetSerializerValuePointer(&Target.Position[0]);
-            Serializer->Quantize(Context, MemberArgs);
+            const int32 Scale = PositionScales[Target.QuantizationLevel];
+            const int64 MaxValue = (1LL << PositionMaxBits[Target.QuantizationLevel]) - 1;
+            for (int32 i = 0; i < 3; ++i)
+            {
+                Target.Position[i] = (int32)FMath::Clamp<int64>(FMath::RoundToInt64(Source.Position[i] * Scale), -MaxValue, MaxValue);
+            }
 
             // Manually quantize these
             switch (Source.RotationQuantizationLevel)
             {
             case EVRRotationQuantization::RoundTo10Bits:
             {        
-                Target.Rotation[0] = FBPVRComponentPosRep::CompressAxisTo10BitShort(Source.Rotation.Pitch);
-                Target.Rotation[1] = FBPVRComponentPosRep::CompressAxisTo10BitShort(Source.Rotation.Yaw);
-                Target.Rotation[2] = FBPVRComponentPosRep::CompressAxisTo10BitShort(Source.Rotation.Roll);
+                Target.Rotation[0] = FBPVRComponentPosRep::CompressAxisTo10BitShort(Source.Rotation.Pitch) & 0x3FF;
+                Target.Rotation[1] = FBPVRComponentPosRep::CompressAxisTo10BitShort(Source.Rotation.Yaw) & 0x3FF;
+                Target.Rotation[2] = FBPVRComponentPosRep::CompressAxisTo10BitShort(Source.Rotation.Roll) & 0x3FF;
             }break;
 
             case EVRRotationQuantization::RoundToShort:
@@ -130,14 +187,8 @@ namespace UE::Net
             Target.QuantizationLevel = (EVRVectorQuantization)Source.QuantizationLevel;
             Target.RotationQuantizationLevel = (EVRRotationQuantization)Source.RotationQuantizationLevel;
 
-            const FNetSerializer* Serializer = VectorNetQuantizeNetSerializers[Source.QuantizationLevel];
-            const FNetSerializerConfig* SerializerConfig = VectorNetQuantizeNetSerializerConfigs[Source.QuantizationLevel];
-
-            FNetDequantizeArgs MemberArgs = Args;
-            MemberArgs.NetSerializerConfig = NetSerializerConfigParam(SerializerConfig);
-            MemberArgs.Source = NetSerializerValuePointer(&Source.Position[0]);
-            MemberArgs.Target = NetSerializerValuePointer(&Target.Position);
-            Serializer->Dequantize(Context, MemberArgs);
+            const double InvScale = 1.0 / PositionScales[Source.QuantizationLevel];
+            Target.Position = FVector(Source.Position[0] * InvScale, Source.Position[1] * InvScale, Source.Position[2] * InvScale);
             
             // Manually quantize these
             switch (Target.RotationQuantizationLevel)
@@ -164,68 +215,111 @@ namespace UE::Net
             const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
             FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
 
-            Writer->WriteBits(static_cast<uint32>(Source.QuantizationLevel), 1);
-            Writer->WriteBits(static_cast<uint32>(Source.RotationQuantizationLevel), 1);
+            const uint32 StartPos = Writer->GetPosBits();
+            SerializeFull(Writer, Source);
 
-            const FNetSerializer* Serializer = VectorNetQuantizeNetSerializers[Source.QuantizationLevel] ;
-            const FNetSerializerConfig* SerializerConfig = VectorNetQuantizeNetSerializerConfigs[Source.QuantizationLevel];
+            INC_DWORD_STAT(STAT_PosRepFullSerializes);
+            INC_DWORD_STAT_BY(STAT_PosRepFullBits, Writer->GetPosBits() - StartPos);
+        }
 
-            FNetSerializeArgs MemberArgs = Args;
-            MemberArgs.NetSerializerConfig = NetSerializerConfigParam(SerializerConfig);
-            MemberArgs.Source = NetSerializerValuePointer(&Source.Position[0]);
-            Serializer->Serialize(Context, MemberArgs);
+        // Deserialize from bitstream
+        static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+        {
+            QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+            FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+
+            DeserializeFull(Reader, Target);
+        }
 
-            switch ((EVRRotationQuantization)Source.RotationQuantizationLevel)
+        /**
+         * Same as Serialize but against the last acked state.
+         * Layout: [changed bit] then either [full state] when the quantization levels changed or
+         * [adaptive position residuals][adaptive rotation residuals].
+         */
+        static void SerializeDelta(FNetSerializationContext& Context, const FNetSerializeDeltaArgs& Args)
+        {
+            const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+            const QuantizedType& Prev = *reinterpret_cast<const QuantizedType*>(Args.Prev);
+            FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+
+            const uint32 StartPos = Writer->GetPosBits();
+
+            if (FPlatformMemory::Memcmp(&Source, &Prev, sizeof(QuantizedType)) == 0)
             {
-                case EVRRotationQuantization::RoundTo10Bits:
-                {
-                    Writer->WriteBits(static_cast<uint32>(Source.Rotation[0]), 10);
-                    Writer->WriteBits(static_cast<uint32>(Source.Rotation[1]), 10);
-                    Writer->WriteBits(static_cast<uint32>(Source.Rotation[2]), 10);
-                }break;
+                Writer->WriteBits(0U, 1);
+                INC_DWORD_STAT(STAT_PosRepDeltaSerializes);
+                INC_DWORD_STAT_BY(STAT_PosRepDeltaBits, Writer->GetPosBits() - StartPos);
+                return;
+            }
 
-                case EVRRotationQuantization::RoundToShort:
-                {
-                    Writer->WriteBits(static_cast<uint32>(Source.Rotation[0]), 16);
-                    Writer->WriteBits(static_cast<uint32>(Source.Rotation[1]), 16);
-                    Writer->WriteBits(static_cast<uint32>(Source.Rotation[2]), 16);
-                }break;
+            Writer->WriteBits(1U, 1);
+
+            // The residuals are only meaningful if both states are in the same units
+            const bool bSameLevels = Source.QuantizationLevel == Prev.QuantizationLevel && Source.RotationQuantizationLevel == Prev.RotationQuantizationLevel;
+            Writer->WriteBits(bSameLevels ? 1U : 0U, 1);
+
+            if (!bSameLevels)
+            {
+                SerializeFull(Writer, Source);
+                INC_DWORD_STAT(STAT_PosRepFullSerializes);
+                INC_DWORD_STAT_BY(STAT_PosRepFullBits, Writer->GetPosBits() - StartPos);
+                return;
             }
-   
+
+            const int32 PositionResiduals[3] = {
+                Source.Position[0] - Prev.Position[0],
+                Source.Position[1] - Prev.Position[1],
+                Source.Position[2] - Prev.Position[2]
+            };
+            WriteAdaptiveTriplet(Writer, PositionResiduals);
+
+            const uint32 RotationBits = GetRotationBits(Source.RotationQuantizationLevel);
+            const int32 RotationResiduals[3] = {
+                GetRotationResidual(Source.Rotation[0], Prev.Rotation[0], RotationBits),
+                GetRotationResidual(Source.Rotation[1], Prev.Rotation[1], RotationBits),
+                GetRotationResidual(Source.Rotation[2], Prev.Rotation[2], RotationBits)
+            };
+            WriteAdaptiveTriplet(Writer, RotationResiduals);
+
+            INC_DWORD_STAT(STAT_PosRepDeltaSerializes);
+            INC_DWORD_STAT_BY(STAT_PosRepDeltaBits, Writer->GetPosBits() - StartPos);
         }
 
-        // Deserialize from bitstream
-        static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+        static void DeserializeDelta(FNetSerializationContext& Context, const FNetDeserializeDeltaArgs& Args)
         {
             QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+            const QuantizedType& Prev = *reinterpret_cast<const QuantizedType*>(Args.Prev);
             FNetBitStreamReader* Reader = Context.GetBitStreamReader();
 
-            Target.QuantizationLevel = Reader->ReadBits(1);
-            Target.RotationQuantizationLevel = Reader->ReadBits(1);
+            if (!Reader->ReadBits(1))
+            {
+                Target = Prev;
+                return;
+            }
 
-            const FNetSerializer* Serializer = VectorNetQuantizeNetSerializers[Target.QuantizationLevel] ;
-            const FNetSerializerConfig* SerializerConfig = VectorNetQuantizeNetSerializerConfigs[Target.QuantizationLevel];
+            if (!Reader->ReadBits(1))
+            {
+                DeserializeFull(Reader, Target);
+                return;
+            }
 
-            FNetDeserializeArgs MemberArgs = Args;
-            MemberArgs.NetSerializerConfig = NetSerializerConfigParam(SerializerConfig);
-            MemberArgs.Target = NetSerializerValuePointer(&Target.Position[0]);
-            Serializer->Deserialize(Context, MemberArgs);
+            FMemory::Memzero(&Target, sizeof(QuantizedType));
+            Target.QuantizationLevel = Prev.QuantizationLevel;
+            Target.RotationQuantizationLevel = Prev.RotationQuantizationLevel;
 
-            switch ((EVRRotationQuantization)Target.RotationQuantizationLevel)
+            int32 PositionResiduals[3];
+            ReadAdaptiveTriplet(Reader, PositionResiduals);
+            for (int32 i = 0; i < 3; ++i)
             {
-            case EVRRotationQuantization::RoundTo10Bits:
-            {
-                Target.Rotation[0] = Reader->ReadBits(10);
-                Target.Rotation[1] = Reader->ReadBits(10);
-                Target.Rotation[2] = Reader->ReadBits(10);
-            }break;
+                Target.Position[i] = Prev.Position[i] + PositionResiduals[i];
+            }
 
-            case EVRRotationQuantization::RoundToShort:
+            const uint32 RotationBits = GetRotationBits(Target.RotationQuantizationLevel);
+            int32 RotationResiduals[3];
+            ReadAdaptiveTriplet(Reader, RotationResiduals);
+            for (int32 i = 0; i < 3; ++i)
             {
-                Target.Rotation[0] = Reader->ReadBits(16);
-                Target.Rotation[1] = Reader->ReadBits(16);
-                Target.Rotation[2] = Reader->ReadBits(16);
-            }break;
+                Target.Rotation[i] = ApplyRotationResidual(Prev.Rotation[i], RotationResiduals[i], RotationBits);
             }
         }
 
@@ -265,7 +359,6 @@ namespace UE::Net
 
 	void FBPVRComponentPosRepNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
 	{
-        InitNetSerializer();
 		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_BPVRComponentPosRep);
 	}
 
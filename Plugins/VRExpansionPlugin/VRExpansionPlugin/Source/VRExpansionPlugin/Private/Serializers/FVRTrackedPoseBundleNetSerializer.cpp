@@ -0,0 +1,210 @@
+#include "Serializers/FVRTrackedPoseBundleNetSerializer.h"
+#include "Serializers/FBPVRComponentPosRepNetSerializer.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "Iris/Serialization/NetSerializers.h"
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/ReplicationState/ReplicationStateDescriptorBuilder.h"
+#include "VRBaseCharacter.h"
+
+
+namespace UE::Net
+{
+
+    // -----------------------------------------------------------------------------
+    // Iris serializer for FVRTrackedPoseBundle
+    // -----------------------------------------------------------------------------
+    struct FVRTrackedPoseBundleNetSerializer
+    {
+		inline static const FBPVRComponentPosRepNetSerializerConfig PosRepSerializerConfig;
+
+		inline static const FNetSerializerConfig* PosRepSerializerConfigPtr = &PosRepSerializerConfig;
+		inline static const FNetSerializer* PosRepNetSerializerPtr;
+
+        class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+        {
+        public:
+            virtual ~FNetSerializerRegistryDelegates();
+
+			void InitNetSerializer()
+			{
+				FVRTrackedPoseBundleNetSerializer::PosRepNetSerializerPtr = &UE_NET_GET_SERIALIZER(FBPVRComponentPosRepNetSerializer);
+			}
+
+        private:
+            virtual void OnPreFreezeNetSerializerRegistry() override;
+        };
+
+        inline static FVRTrackedPoseBundleNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+
+        /** Version is required. */
+        static constexpr uint32 Version = 0;
+
+        // Poses in the same order as the EVRTrackedPoseBundleFlags bits, only the flagged ones are filled in
+        static constexpr int32 NumPoses = 3;
+
+        struct alignas(8) FQuantizedData
+        {
+			uint8 PresenceMask;
+			FBPVRComponentPosRepQuantizedData Poses[NumPoses];
+        };
+
+        typedef FVRTrackedPoseBundle SourceType;
+        typedef FQuantizedData QuantizedType;
+        typedef FVRTrackedPoseBundleNetSerializerConfig ConfigType;
+        inline static const ConfigType DefaultConfig;
+
+        /** Set to false when a same value delta compression method is undesirable, for example when the serializer only writes a single bit for the state. */
+        static constexpr bool bUseDefaultDelta = true;
+
+		static const FBPVRComponentPosRep& GetPose(const SourceType& Source, int32 PoseIndex)
+		{
+			return PoseIndex == 0 ? Source.CameraPose : (PoseIndex == 1 ? Source.LeftControllerPose : Source.RightControllerPose);
+		}
+
+		static FBPVRComponentPosRep& GetPose(SourceType& Source, int32 PoseIndex)
+		{
+			return PoseIndex == 0 ? Source.CameraPose : (PoseIndex == 1 ? Source.LeftControllerPose : Source.RightControllerPose);
+		}
+
+		static bool HasPose(uint8 PresenceMask, int32 PoseIndex)
+		{
+			return (PresenceMask & (1 << PoseIndex)) != 0;
+		}
+
+          // Called to create a "quantized snapshot" of the struct
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+		{
+			const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+			// IsEqual memcmps the quantized state, missing poses are left zeroed
+			FMemory::Memzero(&Target, sizeof(QuantizedType));
+
+			// 3 bits covers all of the devices
+			Target.PresenceMask = Source.PresenceMask & EVRTrackedPoseBundleFlags::All;
+
+			for (int32 PoseIndex = 0; PoseIndex < NumPoses; ++PoseIndex)
+			{
+				if (HasPose(Target.PresenceMask, PoseIndex))
+				{
+					FNetQuantizeArgs MemberArgs = Args;
+					MemberArgs.NetSerializerConfig = NetSerializerConfigParam(PosRepSerializerConfigPtr);
+					MemberArgs.Source = NetSerializerValuePointer(&GetPose(Source, PoseIndex));
+					MemberArgs.Target = NetSerializerValuePointer(&Target.Poses[PoseIndex]);
+					PosRepNetSerializerPtr->Quantize(Context, MemberArgs);
+				}
+			}
+		}
+
+		// Called to apply the quantized snapshot back to gameplay memory
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+		{
+			const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+			Target.PresenceMask = Source.PresenceMask;
+
+			for (int32 PoseIndex = 0; PoseIndex < NumPoses; ++PoseIndex)
+			{
+				if (HasPose(Source.PresenceMask, PoseIndex))
+				{
+					FNetDequantizeArgs MemberArgs = Args;
+					MemberArgs.NetSerializerConfig = NetSerializerConfigParam(PosRepSerializerConfigPtr);
+					MemberArgs.Source = NetSerializerValuePointer(&Source.Poses[PoseIndex]);
+					MemberArgs.Target = NetSerializerValuePointer(&GetPose(Target, PoseIndex));
+					PosRepNetSerializerPtr->Dequantize(Context, MemberArgs);
+				}
+			}
+		}
+
+		// Serialize into bitstream
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+		{
+			const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+			FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+
+			Writer->WriteBits(static_cast<uint32>(Source.PresenceMask), NumPoses);
+
+			for (int32 PoseIndex = 0; PoseIndex < NumPoses; ++PoseIndex)
+			{
+				if (HasPose(Source.PresenceMask, PoseIndex))
+				{
+					FNetSerializeArgs MemberArgs = Args;
+					MemberArgs.NetSerializerConfig = NetSerializerConfigParam(PosRepSerializerConfigPtr);
+					MemberArgs.Source = NetSerializerValuePointer(&Source.Poses[PoseIndex]);
+					PosRepNetSerializerPtr->Serialize(Context, MemberArgs);
+				}
+			}
+		}
+
+		// Deserialize from bitstream
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+		{
+			QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+			FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+
+			FMemory::Memzero(&Target, sizeof(QuantizedType));
+			Target.PresenceMask = static_cast<uint8>(Reader->ReadBits(NumPoses));
+
+			for (int32 PoseIndex = 0; PoseIndex < NumPoses; ++PoseIndex)
+			{
+				if (HasPose(Target.PresenceMask, PoseIndex))
+				{
+					FNetDeserializeArgs MemberArgs = Args;
+					MemberArgs.NetSerializerConfig = NetSerializerConfigParam(PosRepSerializerConfigPtr);
+					MemberArgs.Target = NetSerializerValuePointer(&Target.Poses[PoseIndex]);
+					PosRepNetSerializerPtr->Deserialize(Context, MemberArgs);
+				}
+			}
+		}
+
+		// Compare two instances to see if they differ
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+		{
+			if (Args.bStateIsQuantized)
+			{
+				const QuantizedType& QuantizedValue0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+				const QuantizedType& QuantizedValue1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+				return FPlatformMemory::Memcmp(&QuantizedValue0, &QuantizedValue1, sizeof(QuantizedType)) == 0;
+			}
+			else
+			{
+				const SourceType& L = *reinterpret_cast<const SourceType*>(Args.Source0);
+				const SourceType& R = *reinterpret_cast<const SourceType*>(Args.Source1);
+
+				if (L.PresenceMask != R.PresenceMask) return false;
+
+				for (int32 PoseIndex = 0; PoseIndex < NumPoses; ++PoseIndex)
+				{
+					if (HasPose(L.PresenceMask, PoseIndex))
+					{
+						FNetIsEqualArgs MemberArgs = Args;
+						MemberArgs.NetSerializerConfig = NetSerializerConfigParam(PosRepSerializerConfigPtr);
+						MemberArgs.Source0 = NetSerializerValuePointer(&GetPose(L, PoseIndex));
+						MemberArgs.Source1 = NetSerializerValuePointer(&GetPose(R, PoseIndex));
+						if (!PosRepNetSerializerPtr->IsEqual(Context, MemberArgs)) return false;
+					}
+				}
+
+				return true;
+			}
+		}
+    };
+
+
+	static const FName PropertyNetSerializerRegistry_NAME_VRTrackedPoseBundle("VRTrackedPoseBundle");
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_VRTrackedPoseBundle, FVRTrackedPoseBundleNetSerializer);
+
+	FVRTrackedPoseBundleNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_VRTrackedPoseBundle);
+	}
+
+	void FVRTrackedPoseBundleNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+	{
+		InitNetSerializer();
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_VRTrackedPoseBundle);
+	}
+
+    UE_NET_IMPLEMENT_SERIALIZER(FVRTrackedPoseBundleNetSerializer);
+}
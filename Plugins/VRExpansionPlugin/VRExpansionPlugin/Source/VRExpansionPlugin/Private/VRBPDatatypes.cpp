@@ -99,6 +99,158 @@ bool FTransform_NetQuantize::NetSerialize(FArchive& Ar, class UPackageMap* Map,
 	return bOutSuccess;
 }
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Snapshot Interp ~ Samples"), STAT_SnapshotInterpSamples, STATGROUP_VRNetSmoothing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Snapshot Interp ~ Underruns"), STAT_SnapshotInterpUnderruns, STATGROUP_VRNetSmoothing);
+
+// ** Adaptive Net Update Rate ** //
+
+float FBPVRAdaptiveNetUpdateSettings::GetNetUpdateRate(float FullNetUpdateRate, const FVector& PositionDelta, const FRotator& RotationDelta, float TimeSinceLastSend) const
+{
+	if (!bUseAdaptiveNetUpdateRate || TimeSinceLastSend <= 0.0f)
+		return FullNetUpdateRate;
+
+	const float LinearSpeed = PositionDelta.Size() / TimeSinceLastSend;
+
+	const FRotator NormalizedDelta = RotationDelta.GetNormalized();
+	const float AngularSpeed = FMath::Max3(FMath::Abs(NormalizedDelta.Pitch), FMath::Abs(NormalizedDelta.Yaw), FMath::Abs(NormalizedDelta.Roll)) / TimeSinceLastSend;
+
+	const float Alpha = FMath::Clamp(FMath::Max(LinearSpeed / FullRateLinearSpeed, AngularSpeed / FullRateAngularSpeed), 0.0f, 1.0f);
+	return FMath::Lerp(FMath::Min(MinNetUpdateRate, FullNetUpdateRate), FullNetUpdateRate, Alpha);
+}
+
+// ** Tracked Pose Snapshot Buffer ** //
+
+void FVRTrackedPoseSnapshotBuffer::AddSnapshot(double ArrivalTime, float NominalInterval, const FVector& Position, const FRotator& Rotation)
+{
+	double SnapshotTime = ArrivalTime;
+
+	if (Num > 0)
+	{
+		// Arrival times carry the network jitter and multiple poses can land in the same frame, so stamp on the average
+		// send cadence instead. Bunched arrivals average out against the gap they leave behind, long gaps (still devices
+		// with adaptive rates, lost packets) are capped so that they don't blow up the estimate.
+		const double ArrivalDelta = ArrivalTime - LastArrivalTime;
+		AverageInterval = FMath::Max(FMath::Lerp(AverageInterval, FMath::Clamp(ArrivalDelta, 0.0, AverageInterval * 4.0), 0.1), MinSnapshotInterval);
+
+		// Drift slowly towards the arrival times, if we are more than a couple of intervals off then re-anchor on them
+		const double CadenceTime = GetNewestTime() + AverageInterval;
+		const double Drift = ArrivalTime - CadenceTime;
+		SnapshotTime = FMath::Abs(Drift) <= AverageInterval * 2.0 ? CadenceTime + Drift * 0.1 : ArrivalTime;
+
+		// Keep the times increasing with a sane spacing so the spline stays valid
+		SnapshotTime = FMath::Max(SnapshotTime, GetNewestTime() + MinSnapshotInterval);
+	}
+	else
+	{
+		AverageInterval = FMath::Max((double)NominalInterval, MinSnapshotInterval);
+	}
+
+	LastArrivalTime = ArrivalTime;
+
+	FSnapshot NewSnapshot;
+	NewSnapshot.Time = SnapshotTime;
+	NewSnapshot.Position = Position;
+	NewSnapshot.Rotation = Rotation.Quaternion();
+
+	if (Num > 0)
+	{
+		// Keep on the same hemisphere as the last one so that the slerps don't take the long way around
+		if ((NewSnapshot.Rotation | GetSnapshot(Num - 1).Rotation) < 0.0f)
+		{
+			NewSnapshot.Rotation = -NewSnapshot.Rotation;
+		}
+	}
+
+	if (Num < MaxSnapshots)
+	{
+		Snapshots[(Head + Num) % MaxSnapshots] = NewSnapshot;
+		++Num;
+	}
+	else
+	{
+		Snapshots[Head] = NewSnapshot;
+		Head = (Head + 1) % MaxSnapshots;
+	}
+}
+
+FVector FVRTrackedPoseSnapshotBuffer::GetTangent(int32 Index) const
+{
+	// Catmull-Rom style velocity, one sided at the ends
+	const int32 PrevIndex = FMath::Max(Index - 1, 0);
+	const int32 NextIndex = FMath::Min(Index + 1, Num - 1);
+
+	if (PrevIndex == NextIndex)
+		return FVector::ZeroVector;
+
+	const FSnapshot& Prev = GetSnapshot(PrevIndex);
+	const FSnapshot& Next = GetSnapshot(NextIndex);
+	return (Next.Position - Prev.Position) / FMath::Max(Next.Time - Prev.Time, MinSnapshotInterval);
+}
+
+bool FVRTrackedPoseSnapshotBuffer::Sample(double RenderTime, float MaxExtrapolationTime, FVector& OutPosition, FQuat& OutRotation)
+{
+	if (Num < 1)
+		return true;
+
+	++NumSamples;
+	INC_DWORD_STAT(STAT_SnapshotInterpSamples);
+
+	const FSnapshot& Oldest = GetSnapshot(0);
+	if (RenderTime <= Oldest.Time || Num == 1)
+	{
+		OutPosition = Oldest.Position;
+		OutRotation = Oldest.Rotation;
+
+		// A single snapshot that we are already past is still a starved buffer
+		if (Num == 1 && RenderTime > Oldest.Time)
+		{
+			++NumUnderruns;
+			INC_DWORD_STAT(STAT_SnapshotInterpUnderruns);
+			return false;
+		}
+
+		return true;
+	}
+
+	const FSnapshot& Newest = GetSnapshot(Num - 1);
+	if (RenderTime >= Newest.Time)
+	{
+		++NumUnderruns;
+		INC_DWORD_STAT(STAT_SnapshotInterpUnderruns);
+
+		// Ran out of data, carry on with the last velocity for a short time and then hold
+		const FSnapshot& Previous = GetSnapshot(Num - 2);
+		const double Interval = FMath::Max(Newest.Time - Previous.Time, MinSnapshotInterval);
+		const double ExtrapolationTime = FMath::Min(RenderTime - Newest.Time, (double)FMath::Max(MaxExtrapolationTime, 0.0f));
+
+		OutPosition = Newest.Position + ((Newest.Position - Previous.Position) / Interval) * ExtrapolationTime;
+
+		FVector Axis;
+		float Angle;
+		(Newest.Rotation * Previous.Rotation.Inverse()).ToAxisAndAngle(Axis, Angle);
+		Angle = FMath::UnwindRadians(Angle);
+		OutRotation = FQuat(Axis, Angle * (ExtrapolationTime / Interval)) * Newest.Rotation;
+		OutRotation.Normalize();
+		return false;
+	}
+
+	// Find the span that contains the render time, the buffer is tiny so a linear walk from the back is fine
+	int32 Index = Num - 2;
+	while (Index > 0 && GetSnapshot(Index).Time > RenderTime)
+	{
+		--Index;
+	}
+
+	const FSnapshot& From = GetSnapshot(Index);
+	const FSnapshot& To = GetSnapshot(Index + 1);
+	const double SpanTime = To.Time - From.Time;
+	const float Alpha = (float)FMath::Clamp((RenderTime - From.Time) / SpanTime, 0.0, 1.0);
+
+	OutPosition = FMath::CubicInterp(From.Position, GetTangent(Index) * SpanTime, To.Position, GetTangent(Index + 1) * SpanTime, Alpha);
+	OutRotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha);
+	return true;
+}
+
 // ** Euro Low Pass Filter ** //
 
 void FBPEuroLowPassFilter::ResetSmoothingFilter()
@@ -304,4 +456,62 @@ bool FBPActorGripInformation::operator==(const UPrimitiveComponent* Other) const
 		return true;
 
 	return false;
-}
\ No newline at end of file
+}
+bool FBPActorGripInformation::HasReplicatedChanges(const FBPActorGripInformation& Other) const
+{
+	return (GripID != Other.GripID ||
+		GripTargetType != Other.GripTargetType ||
+		GrippedObject != Other.GrippedObject ||
+		GripCollisionType != Other.GripCollisionType ||
+		GripLateUpdateSetting != Other.GripLateUpdateSetting ||
+		!RelativeTransform.Equals(Other.RelativeTransform) ||
+		bIsSlotGrip != Other.bIsSlotGrip ||
+		GrippedBoneName != Other.GrippedBoneName ||
+		SlotName != Other.SlotName ||
+		GripMovementReplicationSetting != Other.GripMovementReplicationSetting ||
+		bOriginalReplicatesMovement != Other.bOriginalReplicatesMovement ||
+		bOriginalGravity != Other.bOriginalGravity ||
+		Damping != Other.Damping ||
+		Stiffness != Other.Stiffness ||
+		AdvancedGripSettings != Other.AdvancedGripSettings ||
+		SecondaryGripInfo.bHasSecondaryAttachment != Other.SecondaryGripInfo.bHasSecondaryAttachment ||
+		SecondaryGripInfo.SecondaryAttachment != Other.SecondaryGripInfo.SecondaryAttachment ||
+		!SecondaryGripInfo.SecondaryRelativeTransform.Equals(Other.SecondaryGripInfo.SecondaryRelativeTransform) ||
+		SecondaryGripInfo.bIsSlotGrip != Other.SecondaryGripInfo.bIsSlotGrip ||
+		SecondaryGripInfo.SecondarySlotName != Other.SecondaryGripInfo.SecondarySlotName ||
+		SecondaryGripInfo.LerpToRate != Other.SecondaryGripInfo.LerpToRate
+		);
+}
+
+bool FBPGripArray::MarkChangedGripsDirty()
+{
+	bool bMarkedDirty = false;
+
+	for (FBPActorGripInformation& Grip : Grips)
+	{
+		const FBPActorGripInformation* Snapshot = GripSnapshots.Find(Grip.GripID);
+		if (Grip.ReplicationID == INDEX_NONE || !Snapshot || Grip.HasReplicatedChanges(*Snapshot))
+		{
+			MarkItemDirty(Grip);
+			GripSnapshots.Add(Grip.GripID, Grip);
+			bMarkedDirty = true;
+		}
+	}
+
+	// Every current grip has a snapshot now, any extra ones are grips that were removed since the last send
+	if (GripSnapshots.Num() != Grips.Num())
+	{
+		for (TMap<uint8, FBPActorGripInformation>::TIterator It = GripSnapshots.CreateIterator(); It; ++It)
+		{
+			if (!Grips.Contains(It.Key()))
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		MarkArrayDirty();
+		bMarkedDirty = true;
+	}
+
+	return bMarkedDirty;
+}
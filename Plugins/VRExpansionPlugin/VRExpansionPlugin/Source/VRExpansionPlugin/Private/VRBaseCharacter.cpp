@@ -96,7 +96,7 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	{
 		//VRReplicatedCamera->bOffsetByHMD = false;
 		VRReplicatedCamera->SetupAttachment(VRProxyComponent ? VRProxyComponent : NetSmoother ? NetSmoother : RootComponent);
-		VRReplicatedCamera->OverrideSendTransform = &AVRBaseCharacter::Server_SendTransformCamera;
+		VRReplicatedCamera->OverrideSendTransform = &AVRBaseCharacter::SendTransformCamera;
 	}
 
 	VRMovementReference = NULL;
@@ -131,7 +131,7 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 		//LeftMotionController->bUpdateInCharacterMovement = true;
 		// Keep the controllers ticking after movement
 		LeftMotionController->AddTickPrerequisiteComponent(GetCharacterMovement());
-		LeftMotionController->OverrideSendTransform = &AVRBaseCharacter::Server_SendTransformLeftController;
+		LeftMotionController->OverrideSendTransform = &AVRBaseCharacter::SendTransformLeftController;
 	}
 
 	RightMotionController = CreateOptionalDefaultSubobject<UGripMotionControllerComponent>(AVRBaseCharacter::RightMotionControllerComponentName);
@@ -145,7 +145,7 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 		//RightMotionController->bUpdateInCharacterMovement = true;
 		// Keep the controllers ticking after movement
 		RightMotionController->AddTickPrerequisiteComponent(GetCharacterMovement());
-		RightMotionController->OverrideSendTransform = &AVRBaseCharacter::Server_SendTransformRightController;
+		RightMotionController->OverrideSendTransform = &AVRBaseCharacter::SendTransformRightController;
 	}
 
 	OffsetComponentToWorld = FTransform(FQuat(0.0f, 0.0f, 0.0f, 1.0f), FVector::ZeroVector, FVector(1.0f));
@@ -169,6 +169,66 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	bTrackingPaused = false;
 	PausedTrackingLoc = FVector::ZeroVector;
 	PausedTrackingRot = 0.f;
+
+	bBundleTrackedPoseRPCs = true;
+
+	bThrottleTrackedPoseReplication = false;
+	TrackedPoseFullRateDistance = 500.0f;
+	TrackedPoseMinRateDistance = 3000.0f;
+	TrackedPoseMinReplicationRate = 5.0f;
+	TrackedPoseOutOfViewDistanceScale = 3.0f;
+	bReplicateTrackedPosesThisUpdate = true;
+	LastTrackedPoseReplicationTime = 0.0;
+
+	// Post physics so that the camera and controllers have all updated for the frame
+	TrackedPoseBundleTickFunction.TickGroup = TG_PostPhysics;
+	TrackedPoseBundleTickFunction.bCanEverTick = true;
+	TrackedPoseBundleTickFunction.bStartWithTickEnabled = false;
+	TrackedPoseBundleTickFunction.bAllowTickOnDedicatedServer = false;
+	TrackedPoseBundleTickFunction.Target = this;
+}
+
+void AVRBaseCharacter::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		// Only owning clients ever send, it gets enabled when the first pose is queued
+		if (TrackedPoseBundleTickFunction.bCanEverTick && GetNetMode() == NM_Client)
+		{
+			TrackedPoseBundleTickFunction.Target = this;
+			TrackedPoseBundleTickFunction.SetTickFunctionEnable(false);
+			TrackedPoseBundleTickFunction.RegisterTickFunction(GetLevel());
+		}
+	}
+	else
+	{
+		if (TrackedPoseBundleTickFunction.IsTickFunctionRegistered())
+		{
+			TrackedPoseBundleTickFunction.UnRegisterTickFunction();
+		}
+	}
+}
+
+void FVRTrackedPoseBundleTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FVRTrackedPoseBundleTickFunction_ExecuteTick);
+
+	if (Target && IsValid(Target) && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->FlushTrackedPoseBundle();
+	}
+}
+
+FString FVRTrackedPoseBundleTickFunction::DiagnosticMessage()
+{
+	return TEXT("VRTrackedPoseBundleTickFunction");
+}
+
+FName FVRTrackedPoseBundleTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("VRTrackedPoseBundle"));
 }
 
  void AVRBaseCharacter::PossessedBy(AController* NewController)
@@ -277,6 +337,70 @@ void AVRBaseCharacter::PreReplication(IRepChangedPropertyTracker & ChangedProper
 
 	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(AVRBaseCharacter, ReplicatedCapsuleHeight, VRReplicateCapsuleHeight);
 	DOREPLIFETIME_ACTIVE_OVERRIDE_FAST(AVRBaseCharacter, ReplicatedMovementVR, IsReplicatingMovement());
+
+	// Runs before the components PreReplication, they read the result through ShouldReplicateTrackedPoses
+	bReplicateTrackedPosesThisUpdate = true;
+	UWorld* MyWorld = GetWorld();
+	if (bThrottleTrackedPoseReplication && MyWorld && GetNetMode() < NM_Client)
+	{
+		// The poses go to everyone but the owner, so we have to go at the rate of the viewer that needs it most
+		float ThrottleAlpha = 1.0f;
+		for (FConstPlayerControllerIterator Iterator = MyWorld->GetPlayerControllerIterator(); Iterator && ThrottleAlpha > 0.0f; ++Iterator)
+		{
+			APlayerController* PC = Iterator->Get();
+			if (!PC || PC == Controller || PC->IsLocalController())
+				continue;
+
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ThrottleAlpha = FMath::Min(ThrottleAlpha, GetTrackedPoseThrottleAlpha(ViewLocation, ViewRotation.Vector()));
+		}
+
+		if (ThrottleAlpha > 0.0f)
+		{
+			const float FullRate = FMath::Max(GetNetUpdateFrequency(), TrackedPoseMinReplicationRate);
+			const float ReplicationRate = FMath::Lerp(FullRate, TrackedPoseMinReplicationRate, ThrottleAlpha);
+			const double CurrentTime = MyWorld->GetTimeSeconds();
+
+			bReplicateTrackedPosesThisUpdate = (CurrentTime - LastTrackedPoseReplicationTime) >= (1.0 / ReplicationRate);
+		}
+
+		if (bReplicateTrackedPosesThisUpdate)
+		{
+			LastTrackedPoseReplicationTime = MyWorld->GetTimeSeconds();
+		}
+	}
+}
+
+float AVRBaseCharacter::GetTrackedPoseThrottleAlpha(const FVector& ViewLocation, const FVector& ViewDirection) const
+{
+	const FVector ToCharacter = GetActorLocation() - ViewLocation;
+	float Distance = ToCharacter.Size();
+
+	// Behind the viewer, they can turn around but we don't need to be as accurate until they do
+	if ((ToCharacter | ViewDirection) < 0.0f)
+	{
+		Distance *= TrackedPoseOutOfViewDistanceScale;
+	}
+
+	if (TrackedPoseMinRateDistance <= TrackedPoseFullRateDistance)
+		return Distance > TrackedPoseFullRateDistance ? 1.0f : 0.0f;
+
+	return FMath::Clamp((Distance - TrackedPoseFullRateDistance) / (TrackedPoseMinRateDistance - TrackedPoseFullRateDistance), 0.0f, 1.0f);
+}
+
+float AVRBaseCharacter::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth)
+{
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+
+	// Per connection, far away or out of view characters give up their place to closer ones when the connection is saturated
+	if (bThrottleTrackedPoseReplication && ViewTarget != this && Viewer != Controller)
+	{
+		Priority *= FMath::Lerp(1.0f, 0.25f, GetTrackedPoseThrottleAlpha(ViewPos, ViewDir));
+	}
+
+	return Priority;
 }
 
 /*USkeletalMeshComponent* AVRBaseCharacter::GetIKMesh_Implementation() const
@@ -396,6 +520,103 @@ bool AVRBaseCharacter::Server_SendTransformRightController_Validate(FBPVRCompone
 	return true;
 	// Optionally check to make sure that player is inside of their bounds and deny it if they aren't?
 }
+
+void AVRBaseCharacter::Server_SendTrackedPoseBundle_Implementation(FVRTrackedPoseBundle PoseBundle)
+{
+	// Route through the per device RPC implementations so that subclass overrides still run
+	if (PoseBundle.HasPose(EVRTrackedPoseBundleFlags::Camera))
+		Server_SendTransformCamera_Implementation(PoseBundle.CameraPose);
+
+	if (PoseBundle.HasPose(EVRTrackedPoseBundleFlags::LeftController))
+		Server_SendTransformLeftController_Implementation(PoseBundle.LeftControllerPose);
+
+	if (PoseBundle.HasPose(EVRTrackedPoseBundleFlags::RightController))
+		Server_SendTransformRightController_Implementation(PoseBundle.RightControllerPose);
+}
+
+bool AVRBaseCharacter::Server_SendTrackedPoseBundle_Validate(FVRTrackedPoseBundle PoseBundle)
+{
+	// Same validation as if the poses were sent on their own
+	if (PoseBundle.HasPose(EVRTrackedPoseBundleFlags::Camera) && !Server_SendTransformCamera_Validate(PoseBundle.CameraPose))
+		return false;
+
+	if (PoseBundle.HasPose(EVRTrackedPoseBundleFlags::LeftController) && !Server_SendTransformLeftController_Validate(PoseBundle.LeftControllerPose))
+		return false;
+
+	if (PoseBundle.HasPose(EVRTrackedPoseBundleFlags::RightController) && !Server_SendTransformRightController_Validate(PoseBundle.RightControllerPose))
+		return false;
+
+	return true;
+}
+
+void AVRBaseCharacter::SendTransformCamera(FBPVRComponentPosRep NewTransform)
+{
+	if (bBundleTrackedPoseRPCs)
+		QueueTrackedPose(EVRTrackedPoseBundleFlags::Camera, NewTransform);
+	else
+		Server_SendTransformCamera(NewTransform);
+}
+
+void AVRBaseCharacter::SendTransformLeftController(FBPVRComponentPosRep NewTransform)
+{
+	if (bBundleTrackedPoseRPCs)
+		QueueTrackedPose(EVRTrackedPoseBundleFlags::LeftController, NewTransform);
+	else
+		Server_SendTransformLeftController(NewTransform);
+}
+
+void AVRBaseCharacter::SendTransformRightController(FBPVRComponentPosRep NewTransform)
+{
+	if (bBundleTrackedPoseRPCs)
+		QueueTrackedPose(EVRTrackedPoseBundleFlags::RightController, NewTransform);
+	else
+		Server_SendTransformRightController(NewTransform);
+}
+
+void AVRBaseCharacter::QueueTrackedPose(EVRTrackedPoseBundleFlags::Type Device, const FBPVRComponentPosRep& NewTransform)
+{
+	// Not registered (we aren't a client), just send it directly
+	if (!TrackedPoseBundleTickFunction.IsTickFunctionRegistered())
+	{
+		FVRTrackedPoseBundle SingleBundle;
+		SingleBundle.PresenceMask = Device;
+		switch (Device)
+		{
+		case EVRTrackedPoseBundleFlags::Camera: SingleBundle.CameraPose = NewTransform; break;
+		case EVRTrackedPoseBundleFlags::LeftController: SingleBundle.LeftControllerPose = NewTransform; break;
+		case EVRTrackedPoseBundleFlags::RightController: SingleBundle.RightControllerPose = NewTransform; break;
+		default: return;
+		}
+
+		Server_SendTrackedPoseBundle(SingleBundle);
+		return;
+	}
+
+	switch (Device)
+	{
+	case EVRTrackedPoseBundleFlags::Camera: PendingPoseBundle.CameraPose = NewTransform; break;
+	case EVRTrackedPoseBundleFlags::LeftController: PendingPoseBundle.LeftControllerPose = NewTransform; break;
+	case EVRTrackedPoseBundleFlags::RightController: PendingPoseBundle.RightControllerPose = NewTransform; break;
+	default: return;
+	}
+
+	PendingPoseBundle.PresenceMask |= Device;
+
+	// Stays on after this, the tracked devices send nearly every frame anyway
+	if (!TrackedPoseBundleTickFunction.IsTickFunctionEnabled())
+	{
+		TrackedPoseBundleTickFunction.SetTickFunctionEnable(true);
+	}
+}
+
+void AVRBaseCharacter::FlushTrackedPoseBundle()
+{
+	if (PendingPoseBundle.PresenceMask == EVRTrackedPoseBundleFlags::None)
+		return;
+
+	Server_SendTrackedPoseBundle(PendingPoseBundle);
+	PendingPoseBundle.PresenceMask = EVRTrackedPoseBundleFlags::None;
+}
 FVector AVRBaseCharacter::GetTeleportLocation(FVector OriginalLocation)
 {	
 	return OriginalLocation;
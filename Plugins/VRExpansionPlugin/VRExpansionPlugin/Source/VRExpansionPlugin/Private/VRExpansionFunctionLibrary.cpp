@@ -12,6 +12,9 @@
 #include "Components/SplineComponent.h"
 #include "Components/SplineMeshComponent.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "UObject/ObjectKey.h"
 #include "GripMotionControllerComponent.h"
 //#include "IMotionController.h"
 //#include "HeadMountedDisplayFunctionLibrary.h"
@@ -190,6 +193,156 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName(FName SlotType, A
 	}
 }
 
+namespace VRGripSlotCache
+{
+	// The sockets and hand sockets of a component that match a single slot type
+	struct FSlotTypeTable
+	{
+		FName SlotType;
+		TArray<FName> SocketNames;
+		TArray<TWeakObjectPtr<UHandSocketComponent>> HandSockets;
+	};
+
+	// Pre-classified slots for a component, rebuilt whenever the signature of its mesh / attachments changes
+	struct FComponentSlotTable
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		uint32 Signature = 0;
+		TArray<FSlotTypeTable, TInlineAllocator<2>> SlotTypes;
+	};
+
+	static TMap<TObjectKey<USceneComponent>, FComponentSlotTable> CachedSlotTables;
+
+	// Prune stale components every so many new entries so the map doesn't grow without bound
+	static int32 EntriesSincePrune = 0;
+	static const int32 PruneInterval = 256;
+
+	// Cheap, allocation free hash of everything that changes the slot classification
+	static uint32 CalculateSignature(const USceneComponent* Component)
+	{
+		uint32 Signature = 0;
+
+		if (const UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component))
+		{
+			Signature = PointerHash(StaticMeshComp->GetStaticMesh());
+		}
+		else if (const USkinnedMeshComponent* SkinnedComp = Cast<USkinnedMeshComponent>(Component))
+		{
+			Signature = PointerHash(SkinnedComp->GetSkinnedAsset());
+		}
+
+		const TArray<TObjectPtr<USceneComponent>>& AttachChildren = Component->GetAttachChildren();
+		Signature = HashCombineFast(Signature, (uint32)AttachChildren.Num());
+
+		for (const USceneComponent* AttachChild : AttachChildren)
+		{
+			if (const UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
+			{
+				Signature = HashCombineFast(Signature, PointerHash(SocketComp));
+				Signature = HashCombineFast(Signature, GetTypeHash(SocketComp->SlotPrefix));
+				Signature = HashCombineFast(Signature, GetTypeHash(SocketComp->GetAttachSocketName()));
+			}
+		}
+
+		return Signature;
+	}
+
+	static void BuildSlotTypeTable(const USceneComponent* Component, FName SlotType, FSlotTypeTable& OutTable)
+	{
+		OutTable.SlotType = SlotType;
+		OutTable.SocketNames.Reset();
+		OutTable.HandSockets.Reset();
+
+		const FString GripIdentifier = SlotType.ToString();
+
+		TArray<FName> SocketNames = Component->GetAllSocketNames();
+		for (const FName& SocketName : SocketNames)
+		{
+			if (SocketName.ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+			{
+				OutTable.SocketNames.Add(SocketName);
+			}
+		}
+
+		for (USceneComponent* AttachChild : Component->GetAttachChildren())
+		{
+			if (UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
+			{
+				FName BoneName = SocketComp->GetAttachSocketName();
+				FString SlotPrefix = BoneName != NAME_None ? BoneName.ToString() + SocketComp->SlotPrefix.ToString() : SocketComp->SlotPrefix.ToString();
+
+				if (SlotPrefix.Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+				{
+					OutTable.HandSockets.Add(SocketComp);
+				}
+			}
+		}
+	}
+
+	static const FSlotTypeTable& GetSlotTypeTable(USceneComponent* Component, FName SlotType)
+	{
+		// Off of the game thread we don't touch the shared cache, just classify into a scratch table
+		if (!IsInGameThread())
+		{
+			static thread_local FSlotTypeTable ScratchTable;
+			BuildSlotTypeTable(Component, SlotType, ScratchTable);
+			return ScratchTable;
+		}
+
+		const uint32 Signature = CalculateSignature(Component);
+		FComponentSlotTable* ComponentTable = CachedSlotTables.Find(Component);
+
+		if (!ComponentTable)
+		{
+			if (++EntriesSincePrune >= PruneInterval)
+			{
+				EntriesSincePrune = 0;
+				for (auto It = CachedSlotTables.CreateIterator(); It; ++It)
+				{
+					if (!It.Value().Component.IsValid())
+					{
+						It.RemoveCurrent();
+					}
+				}
+			}
+
+			ComponentTable = &CachedSlotTables.Add(Component);
+			ComponentTable->Component = Component;
+			ComponentTable->Signature = Signature;
+		}
+		else if (ComponentTable->Signature != Signature)
+		{
+			// Mesh or attachments changed, throw out the old classification
+			ComponentTable->SlotTypes.Reset();
+			ComponentTable->Signature = Signature;
+		}
+
+		for (FSlotTypeTable& Table : ComponentTable->SlotTypes)
+		{
+			if (Table.SlotType == SlotType)
+			{
+				return Table;
+			}
+		}
+
+		FSlotTypeTable& NewTable = ComponentTable->SlotTypes.AddDefaulted_GetRef();
+		BuildSlotTypeTable(Component, SlotType, NewTable);
+		return NewTable;
+	}
+}
+
+void UVRExpansionFunctionLibrary::InvalidateGripSlotCache(USceneComponent* Component)
+{
+	if (Component)
+	{
+		VRGripSlotCache::CachedSlotTables.Remove(Component);
+	}
+	else
+	{
+		VRGripSlotCache::CachedSlotTables.Reset();
+	}
+}
+
 void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName SlotType, USceneComponent* Component, FVector WorldLocation, float MaxRange, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* QueryController)
 {
 	bHadSlotInRange = false;
@@ -200,82 +353,66 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName S
 	if (!Component)
 		return;
 
-	FVector RelativeWorldLocation = Component->GetComponentTransform().InverseTransformPosition(WorldLocation);
+	const FTransform& ComponentTransform = Component->GetComponentTransform();
+	FVector RelativeWorldLocation = ComponentTransform.InverseTransformPosition(WorldLocation);
 	MaxRange = FMath::Square(MaxRange);
 
 	float ClosestSlotDistance = -0.1f;
 
-	TArray<FName> SocketNames = Component->GetAllSocketNames();
+	// Sockets and hand sockets are pre-filtered by the slot type, so this is only distance checks
+	const VRGripSlotCache::FSlotTypeTable& SlotTable = VRGripSlotCache::GetSlotTypeTable(Component, SlotType);
 
-	FString GripIdentifier = SlotType.ToString();
+	FName FoundSocketName = NAME_None;
 
-	int foundIndex = 0;
-
-	for (int i = 0; i < SocketNames.Num(); ++i)
+	for (const FName& SocketName : SlotTable.SocketNames)
 	{
-		if (SocketNames[i].ToString().Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+		float vecLen = FVector::DistSquared(RelativeWorldLocation, Component->GetSocketTransform(SocketName, ERelativeTransformSpace::RTS_Component).GetLocation());
+
+		if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
 		{
-			float vecLen = FVector::DistSquared(RelativeWorldLocation, Component->GetSocketTransform(SocketNames[i], ERelativeTransformSpace::RTS_Component).GetLocation());
+			ClosestSlotDistance = vecLen;
+			bHadSlotInRange = true;
+			FoundSocketName = SocketName;
+		}
+	}
 
-			if (MaxRange >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
+	TArray<UHandSocketComponent*, TInlineAllocator<8>> RotationallyMatchingHandSockets;
+	for (const TWeakObjectPtr<UHandSocketComponent>& WeakSocketComp : SlotTable.HandSockets)
+	{
+		UHandSocketComponent* SocketComp = WeakSocketComp.Get();
+		if (!SocketComp || SocketComp->bDisabled)
+			continue;
+
+		FVector SocketRelativeLocation = ComponentTransform.InverseTransformPosition(SocketComp->GetHandSocketTransform(QueryController, true).GetLocation());
+		float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketRelativeLocation);
+		//float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketComp->GetRelativeLocation());
+		if (SocketComp->bAlwaysInRange)
+		{
+			if (SocketComp->bMatchRotation)
 			{
+				RotationallyMatchingHandSockets.Add(SocketComp);
+			}
+			else
+			{
+				TargetHandSocket = SocketComp;
 				ClosestSlotDistance = vecLen;
 				bHadSlotInRange = true;
-				foundIndex = i;
 			}
 		}
-	}
-
-	TArray<USceneComponent*> AttachChildren = Component->GetAttachChildren();
-
-	TArray<UHandSocketComponent*> RotationallyMatchingHandSockets;
-	for (USceneComponent* AttachChild : AttachChildren)
-	{
-		if (AttachChild && AttachChild->IsA<UHandSocketComponent>())
+		else
 		{
-			if (UHandSocketComponent* SocketComp = Cast<UHandSocketComponent>(AttachChild))
+			float RangeVal = (SocketComp->OverrideDistance > 0.0f ? FMath::Square(SocketComp->OverrideDistance) : MaxRange);
+			if (RangeVal >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
 			{
-				if (SocketComp->bDisabled)
-					continue;
-
-				FName BoneName = SocketComp->GetAttachSocketName();
-				FString SlotPrefix = BoneName != NAME_None ? BoneName.ToString() + SocketComp->SlotPrefix.ToString() : SocketComp->SlotPrefix.ToString();
-
-				if (SlotPrefix.Contains(GripIdentifier, ESearchCase::IgnoreCase, ESearchDir::FromStart))
+				if (SocketComp->bMatchRotation)
 				{
-					FVector SocketRelativeLocation = Component->GetComponentTransform().InverseTransformPosition(SocketComp->GetHandSocketTransform(QueryController, true).GetLocation());
-					float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketRelativeLocation);
-					//float vecLen = FVector::DistSquared(RelativeWorldLocation, SocketComp->GetRelativeLocation());
-					if (SocketComp->bAlwaysInRange)
-					{
-						if (SocketComp->bMatchRotation)
-						{
-							RotationallyMatchingHandSockets.Add(SocketComp);
-						}
-						else
-						{
-							TargetHandSocket = SocketComp;
-							ClosestSlotDistance = vecLen;
-							bHadSlotInRange = true;
-						}
-					}
-					else
-					{
-						float RangeVal = (SocketComp->OverrideDistance > 0.0f ? FMath::Square(SocketComp->OverrideDistance) : MaxRange);
-						if (RangeVal >= vecLen && (ClosestSlotDistance < 0.0f || vecLen < ClosestSlotDistance))
-						{
-							if (SocketComp->bMatchRotation)
-							{
-								RotationallyMatchingHandSockets.Add(SocketComp);
-							}
-							else
-							{
-								TargetHandSocket = SocketComp;
-								ClosestSlotDistance = vecLen;
-								bHadSlotInRange = true;
-							}
-						}
-					}
+					RotationallyMatchingHandSockets.Add(SocketComp);
+				}
+				else
+				{
+					TargetHandSocket = SocketComp;
+					ClosestSlotDistance = vecLen;
+					bHadSlotInRange = true;
 				}
 			}
 		}
@@ -313,8 +450,8 @@ void UVRExpansionFunctionLibrary::GetGripSlotInRangeByTypeName_Component(FName S
 		}
 		else
 		{
-			SlotWorldTransform = Component->GetSocketTransform(SocketNames[foundIndex]);
-			SlotName = SocketNames[foundIndex];
+			SlotWorldTransform = Component->GetSocketTransform(FoundSocketName);
+			SlotName = FoundSocketName;
 			SlotWorldTransform.SetScale3D(FVector(1.0f));
 		}
 	}
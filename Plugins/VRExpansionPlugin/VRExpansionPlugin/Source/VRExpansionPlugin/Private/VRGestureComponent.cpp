@@ -10,6 +10,11 @@
 #include "DrawDebugHelpers.h"
 #include "Algo/Reverse.h"
 #include "TimerManager.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+DEFINE_LOG_CATEGORY(LogVRGestureComponent);
 
 DECLARE_CYCLE_STAT(TEXT("TickGesture ~ TickingGesture"), STAT_TickGesture, STATGROUP_TickGesture);
 
@@ -28,8 +33,105 @@ UVRGestureComponent::UVRGestureComponent(const FObjectInitializer& ObjectInitial
 	bDrawSplinesCurved = true;
 	bGetGestureInWorldSpace = true;
 	SplineMeshScaler = FVector2D(1.f);
+
+	bUseStreamingRecognition = false;
+	StreamingRescaleTolerance = 0.05f;
+	StreamingSampleIndex = 0;
+	StreamingScaler = 1.f;
+	StreamingMirroringHand = EVRGestureMirrorMode::GES_NoMirror;
+	bStreamingStateDirty = true;
+
+	bUseParallelRecognition = false;
+	ParallelRecognitionMinGestures = 16;
+	bUseVectorizedDTW = true;
+}
+
+void FVRGesture::CalculateEnvelope()
+{
+	EnvelopeSegments.Reset((Samples.Num() + EnvelopeSegmentLength - 1) / EnvelopeSegmentLength);
+
+	for (int i = 0; i < Samples.Num(); i += EnvelopeSegmentLength)
+	{
+		FBox SegmentBox(ForceInit);
+		const int SegmentEnd = FMath::Min(i + EnvelopeSegmentLength, Samples.Num());
+		for (int j = i; j < SegmentEnd; ++j)
+		{
+			SegmentBox += Samples[j];
+		}
+
+		EnvelopeSegments.Add(SegmentBox);
+	}
+
+	EnvelopeSampleCount = Samples.Num();
+	EnvelopeSamplesHash = GetSamplesHash();
 }
 
+void FVRGesture::CalculatePackedSamples()
+{
+	const int32 PaddedCount = Align(Samples.Num(), 4);
+
+	// Padding stays zeroed, the kernel computes it and the DTW never reads it
+	PackedX.SetNumZeroed(PaddedCount);
+	PackedY.SetNumZeroed(PaddedCount);
+	PackedZ.SetNumZeroed(PaddedCount);
+
+	for (int32 i = 0; i < Samples.Num(); ++i)
+	{
+		PackedX[i] = (float)Samples[i].X;
+		PackedY[i] = (float)Samples[i].Y;
+		PackedZ[i] = (float)Samples[i].Z;
+	}
+
+	PackedSampleCount = Samples.Num();
+	PackedSamplesHash = GetSamplesHash();
+}
+
+float FVRGesture::GetEnvelopeLowerBound(const FBox& InputBounds, bool bMirrorGesture) const
+{
+	float LowerBound = 0.f;
+
+	for (int i = 0; i < EnvelopeSegments.Num(); ++i)
+	{
+		FBox SegmentBox = EnvelopeSegments[i];
+		if (bMirrorGesture)
+		{
+			// Mirroring flips Y, so the bounds swap and negate
+			const double MinY = SegmentBox.Min.Y;
+			SegmentBox.Min.Y = -SegmentBox.Max.Y;
+			SegmentBox.Max.Y = -MinY;
+		}
+
+		const int SamplesInSegment = FMath::Min(EnvelopeSegmentLength, Samples.Num() - (i * EnvelopeSegmentLength));
+		LowerBound += (float)SegmentBox.ComputeSquaredDistanceToBox(InputBounds) * SamplesInSegment;
+	}
+
+	return LowerBound;
+}
+
+void UGesturesDatabase::PostLoad()
+{
+	Super::PostLoad();
+
+	// Envelopes and packed samples aren't serialized, rebuild them for the loaded samples
+	for (FVRGesture& Gesture : Gestures)
+	{
+		Gesture.RebuildCachedData();
+	}
+}
+
+#if WITH_EDITOR
+void UGesturesDatabase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Samples can be edited in place without changing the count, rebuild so the cached data matches them
+	for (FVRGesture& Gesture : Gestures)
+	{
+		Gesture.RebuildCachedData();
+	}
+}
+#endif
+
 void UGesturesDatabase::FillSplineWithGesture(FVRGesture &Gesture, USplineComponent * SplineComponent, bool bCenterPointsOnSpline, bool bScaleToBounds, float OptionalBounds, bool bUseCurvedPoints, bool bFillInSplineMeshComponents, UStaticMesh * Mesh, UMaterial * MeshMat)
 {
 	if (!SplineComponent || Gesture.Samples.Num() < 2)
@@ -137,6 +239,7 @@ void UVRGestureComponent::BeginRecording(bool bRunDetection, EVRGestureFlattenAx
 
 	// Reset does the reserve already
 	GestureLog.Samples.Reset(RecordingBufferSize);
+	bStreamingStateDirty = true;
 
 	CurrentState = bRunDetection ? EVRGestureState::GES_Detecting : EVRGestureState::GES_Recording;
 
@@ -354,7 +457,16 @@ void UVRGestureComponent::TickGesture()
 	case EVRGestureState::GES_Detecting:
 	{
 		CaptureGestureFrame();
-		RecognizeGesture(GestureLog);
+
+		if (bUseStreamingRecognition)
+		{
+			RecognizeGestureStreaming();
+		}
+		else
+		{
+			RecognizeGesture(GestureLog);
+		}
+
 		bGestureChanged = false;
 	}break;
 
@@ -378,7 +490,7 @@ void UVRGestureComponent::TickGesture()
 	}
 }
 
-void UVRGestureComponent::RecognizeGesture(FVRGesture inputGesture)
+void UVRGestureComponent::RecognizeGesture(const FVRGesture& inputGesture)
 {
 	if (!GesturesDB || inputGesture.Samples.Num() < 1 || !bGestureChanged)
 		return;
@@ -386,149 +498,642 @@ void UVRGestureComponent::RecognizeGesture(FVRGesture inputGesture)
 	float minDist = MAX_FLT;
 
 	int OutGestureIndex = -1;
-	bool bMirrorGesture = false;
 
 	FVector Size = inputGesture.GestureSize.GetSize();
 	float Scaler = GesturesDB->TargetGestureScale / Size.GetMax();
-	float FinalScaler = Scaler;
 
-	for (int i = 0; i < GesturesDB->Gestures.Num(); i++)
+	// Cached data is only rebuilt here if something changed the samples without re-calculating the gesture
+	for (FVRGesture& exampleGesture : GesturesDB->Gestures)
 	{
-		FVRGesture &exampleGesture = GesturesDB->Gestures[i];
+		if (!exampleGesture.HasValidCachedData())
+		{
+			exampleGesture.RebuildCachedData();
+		}
+	}
 
-		if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || inputGesture.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
-			continue;
+	if (bUseVectorizedDTW)
+	{
+		PrepareInputVariants(inputGesture, Scaler);
+	}
 
-		FinalScaler = exampleGesture.GestureSettings.bEnableScaling ? Scaler : 1.f;
+	const int NumGestures = GesturesDB->Gestures.Num();
 
-		bMirrorGesture = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+	if (bUseParallelRecognition && NumGestures >= ParallelRecognitionMinGestures)
+	{
+		ParallelGestureResults.SetNumUninitialized(NumGestures, EAllowShrinking::No);
+		const UGesturesDatabase* DB = GesturesDB;
 
-		if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+		// Each gesture only abandons against its own threshold so that the results don't depend on worker ordering
+		ParallelFor(NumGestures, [this, DB, &inputGesture, Scaler](int32 Index)
 		{
-			float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler) / (exampleGesture.Samples.Num());
-			if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
+			ParallelGestureResults[Index] = EvaluateGesture(inputGesture, DB->Gestures[Index], Scaler);
+		});
+
+		// Deterministic reduction, first lowest wins just like the serial path
+		for (int i = 0; i < NumGestures; ++i)
+		{
+			if (ParallelGestureResults[i] < minDist)
+			{
+				minDist = ParallelGestureResults[i];
+				OutGestureIndex = i;
+			}
+		}
+	}
+	else
+	{
+		for (int i = 0; i < NumGestures; i++)
+		{
+			// Anything that can't beat the current best can be abandoned early
+			float d = EvaluateGesture(inputGesture, GesturesDB->Gestures[i], Scaler, minDist);
+			if (d < minDist)
 			{
 				minDist = d;
 				OutGestureIndex = i;
 			}
 		}
-		else if (exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+	}
+
+	if (/*minDist < FMath::Square(globalThreshold) && */OutGestureIndex != -1)
+	{
+		OnGestureDetected(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB, Size);
+		OnGestureDetected_Bind.Broadcast(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB, Size);
+		ClearRecording(); // Clear the recording out, we don't want to detect this gesture again with the same data
+		RecordingGestureDraw.Reset();
+	}
+}
+
+float UVRGestureComponent::EvaluateGesture(const FVRGesture& inputGesture, const FVRGesture& exampleGesture, float Scaler, float AbandonDistance) const
+{
+	if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || inputGesture.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
+		return MAX_FLT;
+
+	const float FinalScaler = exampleGesture.GestureSettings.bEnableScaling ? Scaler : 1.f;
+	const float FullThresholdSq = FMath::Square(exampleGesture.GestureSettings.FullThreshold);
+	const float FirstThresholdSq = FMath::Square(exampleGesture.GestureSettings.firstThreshold);
+
+	// dtw is normalized by the gesture length after the fact, so scale the abandon cost up to match
+	const float AbandonCost = FMath::Min(FullThresholdSq, AbandonDistance) * exampleGesture.Samples.Num();
+
+	bool bMirrorGesture = IsPrimaryMirrored(exampleGesture);
+
+	if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) >= FirstThresholdSq)
+	{
+		if (exampleGesture.GestureSettings.MirrorMode != EVRGestureMirrorMode::GES_MirrorBoth)
+		{
+			return MAX_FLT;
+		}
+
+		bMirrorGesture = true;
+		if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) >= FirstThresholdSq)
+		{
+			return MAX_FLT;
+		}
+	}
+
+	// The input size is only ever grown during recording so it always contains the current samples
+	const FBox ScaledInputBounds(inputGesture.GestureSize.Min * FinalScaler, inputGesture.GestureSize.Max * FinalScaler);
+	if (exampleGesture.HasValidEnvelope() && exampleGesture.GetEnvelopeLowerBound(ScaledInputBounds, bMirrorGesture) >= AbandonCost)
+	{
+		return MAX_FLT;
+	}
+
+	float d = MAX_FLT;
+	if (bUseVectorizedDTW && exampleGesture.HasValidPackedSamples())
+	{
+		const int32 Variant = (exampleGesture.GestureSettings.bEnableScaling ? 1 : 0) | (bMirrorGesture ? 2 : 0);
+		d = dtwPacked(PreparedInput[Variant], exampleGesture, AbandonCost);
+	}
+	else
+	{
+		d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler, AbandonCost);
+	}
+
+	if (d >= AbandonCost)
+	{
+		return MAX_FLT;
+	}
+
+	return d / exampleGesture.Samples.Num();
+}
+
+void FVRGestureDTWColumn::Init(int32 GestureLength)
+{
+	Cost.SetNumUninitialized(GestureLength + 1, EAllowShrinking::No);
+	StartIndex.SetNumUninitialized(GestureLength + 1, EAllowShrinking::No);
+	SlopeI.SetNumUninitialized(GestureLength + 1, EAllowShrinking::No);
+	SlopeJ.SetNumUninitialized(GestureLength + 1, EAllowShrinking::No);
+	Reset();
+}
+
+void FVRGestureDTWColumn::Reset()
+{
+	// Column 0 is the free starting point, a match can begin on any input sample
+	for (int32 j = 0; j < Cost.Num(); ++j)
+	{
+		Cost[j] = MAX_FLT;
+	}
+
+	if (Cost.Num() > 0)
+	{
+		Cost[0] = 0.f;
+	}
+
+	FMemory::Memzero(StartIndex.GetData(), StartIndex.Num() * sizeof(int32));
+	FMemory::Memzero(SlopeI.GetData(), SlopeI.Num() * sizeof(int32));
+	FMemory::Memzero(SlopeJ.GetData(), SlopeJ.Num() * sizeof(int32));
+}
+
+void FVRGestureStreamingState::Init(int32 InGestureLength, bool bInHasMirroredState)
+{
+	GestureLength = InGestureLength;
+	bHasMirroredState = bInHasMirroredState;
+	CurrentColumn = 0;
+
+	Columns[0].Init(GestureLength);
+	Columns[1].Init(GestureLength);
+
+	if (bHasMirroredState)
+	{
+		MirroredColumns[0].Init(GestureLength);
+		MirroredColumns[1].Init(GestureLength);
+	}
+}
+
+void FVRGestureStreamingState::Reset()
+{
+	CurrentColumn = 0;
+	Columns[0].Reset();
+	Columns[1].Reset();
+
+	if (bHasMirroredState)
+	{
+		MirroredColumns[0].Reset();
+		MirroredColumns[1].Reset();
+	}
+}
+
+float UVRGestureComponent::StepStreamingDTW(FVRGestureDTWColumn(&Columns)[2], int32 CurrentColumn, const TArray<FVector>& GestureSamples, const FVector& ScaledSample, bool bMirrorGesture, int32 SampleIndex, int32 OldestValidIndex) const
+{
+	const FVRGestureDTWColumn& Prev = Columns[CurrentColumn];
+	FVRGestureDTWColumn& Cur = Columns[CurrentColumn ^ 1];
+	const int32 GestureLength = GestureSamples.Num();
+
+	Cur.Cost[0] = 0.f;
+	Cur.StartIndex[0] = SampleIndex;
+	Cur.SlopeI[0] = 0;
+	Cur.SlopeJ[0] = 0;
+
+	// Matches that started on samples which have since fallen out of the buffer are thrown out
+	auto GetValidCost = [OldestValidIndex](const FVRGestureDTWColumn& Column, int32 Index)
+	{
+		return (Index == 0 || Column.StartIndex[Index] >= OldestValidIndex) ? Column.Cost[Index] : MAX_FLT;
+	};
+
+	for (int32 j = 1; j <= GestureLength; ++j)
+	{
+		// Gestures are stored newest first, we walk them oldest first so that the newest input sample is always the end of the match
+		const float Dist = GetGestureDistance(ScaledSample, GestureSamples[GestureLength - j], bMirrorGesture);
+
+		const float Horizontal = GetValidCost(Cur, j - 1); // Gesture advanced, input held
+		const float Vertical = GetValidCost(Prev, j); // Input advanced, gesture held
+		const float Diagonal = GetValidCost(Prev, j - 1);
+
+		if (Horizontal < Diagonal && Horizontal < Vertical && Cur.SlopeJ[j - 1] < maxSlope)
 		{
-			bMirrorGesture = true;
-			if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+			Cur.Cost[j] = Dist + Horizontal;
+			Cur.StartIndex[j] = (j == 1) ? SampleIndex : Cur.StartIndex[j - 1];
+			Cur.SlopeI[j] = 0;
+			Cur.SlopeJ[j] = Cur.SlopeJ[j - 1] + 1;
+		}
+		else if (Vertical < Diagonal && Vertical < Horizontal && Prev.SlopeI[j] < maxSlope)
+		{
+			Cur.Cost[j] = Dist + Vertical;
+			Cur.StartIndex[j] = Prev.StartIndex[j];
+			Cur.SlopeI[j] = Prev.SlopeI[j] + 1;
+			Cur.SlopeJ[j] = 0;
+		}
+		else if (Diagonal < MAX_FLT)
+		{
+			Cur.Cost[j] = Dist + Diagonal;
+			Cur.StartIndex[j] = (j == 1) ? SampleIndex : Prev.StartIndex[j - 1];
+			Cur.SlopeI[j] = 0;
+			Cur.SlopeJ[j] = 0;
+		}
+		else
+		{
+			Cur.Cost[j] = MAX_FLT;
+			Cur.StartIndex[j] = SampleIndex;
+			Cur.SlopeI[j] = 0;
+			Cur.SlopeJ[j] = 0;
+		}
+	}
+
+	return GetValidCost(Cur, GestureLength);
+}
+
+void UVRGestureComponent::StepStreamingStates(const FVector& Sample, float Scaler, int32 SampleIndex, int32 OldestValidIndex)
+{
+	for (int i = 0; i < StreamingStates.Num(); ++i)
+	{
+		FVRGestureStreamingState& State = StreamingStates[i];
+		const FVRGesture& Gesture = GesturesDB->Gestures[i];
+
+		if (State.GestureLength < 1)
+		{
+			continue;
+		}
+
+		const FVector ScaledSample = Gesture.GestureSettings.bEnableScaling ? Sample * Scaler : Sample;
+
+		StreamingCosts[i] = StepStreamingDTW(State.Columns, State.CurrentColumn, Gesture.Samples, ScaledSample, IsPrimaryMirrored(Gesture), SampleIndex, OldestValidIndex);
+
+		if (State.bHasMirroredState)
+		{
+			StreamingMirroredCosts[i] = StepStreamingDTW(State.MirroredColumns, State.CurrentColumn, Gesture.Samples, ScaledSample, true, SampleIndex, OldestValidIndex);
+		}
+
+		State.CurrentColumn ^= 1;
+	}
+}
+
+void UVRGestureComponent::RebuildStreamingStates(float Scaler)
+{
+	const int32 NumGestures = GesturesDB->Gestures.Num();
+
+	StreamingStates.SetNum(NumGestures);
+	StreamingCosts.SetNumUninitialized(NumGestures);
+	StreamingMirroredCosts.SetNumUninitialized(NumGestures);
+
+	for (int i = 0; i < NumGestures; ++i)
+	{
+		const FVRGesture& Gesture = GesturesDB->Gestures[i];
+		const bool bNeedsMirror = Gesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth;
+
+		if (StreamingStates[i].GestureLength != Gesture.Samples.Num() || StreamingStates[i].bHasMirroredState != bNeedsMirror)
+		{
+			StreamingStates[i].Init(Gesture.Samples.Num(), bNeedsMirror);
+		}
+		else
+		{
+			StreamingStates[i].Reset();
+		}
+
+		StreamingCosts[i] = MAX_FLT;
+		StreamingMirroredCosts[i] = MAX_FLT;
+	}
+
+	StreamingDB = GesturesDB;
+	StreamingScaler = Scaler;
+	StreamingMirroringHand = MirroringHand;
+	bStreamingStateDirty = false;
+
+	// Replay the buffer oldest to newest, sample 0 is the newest
+	const int32 NumSamples = GestureLog.Samples.Num();
+	const int32 OldestValidIndex = StreamingSampleIndex - (NumSamples - 1);
+	for (int k = NumSamples - 1; k >= 0; --k)
+	{
+		StepStreamingStates(GestureLog.Samples[k], Scaler, StreamingSampleIndex - k, OldestValidIndex);
+	}
+}
+
+void UVRGestureComponent::RecognizeGestureStreaming()
+{
+	if (!GesturesDB || GestureLog.Samples.Num() < 1 || !bGestureChanged)
+		return;
+
+	FVector Size = GestureLog.GestureSize.GetSize();
+	if (Size.GetMax() <= UE_KINDA_SMALL_NUMBER)
+	{
+		// Can't scale yet, rebuild once we have a valid size
+		bStreamingStateDirty = true;
+		return;
+	}
+
+	float Scaler = GesturesDB->TargetGestureScale / Size.GetMax();
+	++StreamingSampleIndex;
+
+	bool bNeedsRebuild = bStreamingStateDirty || StreamingDB.Get() != GesturesDB || StreamingMirroringHand != MirroringHand ||
+		StreamingStates.Num() != GesturesDB->Gestures.Num() ||
+		FMath::Abs(Scaler - StreamingScaler) > StreamingScaler * StreamingRescaleTolerance;
+
+	if (!bNeedsRebuild)
+	{
+		for (int i = 0; i < StreamingStates.Num(); ++i)
+		{
+			if (StreamingStates[i].GestureLength != GesturesDB->Gestures[i].Samples.Num())
 			{
-				float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler) / (exampleGesture.Samples.Num());
-				if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
-				{
-					minDist = d;
-					OutGestureIndex = i;
-				}
+				bNeedsRebuild = true;
+				break;
 			}
 		}
+	}
+
+	if (bNeedsRebuild)
+	{
+		// Replays the full buffer including the newest sample
+		RebuildStreamingStates(Scaler);
+	}
+	else
+	{
+		// Keep using the scaler the columns were built with so that the accumulated costs stay consistent
+		StepStreamingStates(GestureLog.Samples[0], StreamingScaler, StreamingSampleIndex, StreamingSampleIndex - (GestureLog.Samples.Num() - 1));
+	}
+
+	float minDist = MAX_FLT;
+	int OutGestureIndex = -1;
 
-		/*if (exampleGesture.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+	for (int i = 0; i < GesturesDB->Gestures.Num(); i++)
+	{
+		const FVRGesture& exampleGesture = GesturesDB->Gestures[i];
+
+		if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || GestureLog.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
+			continue;
+
+		const FVector ScaledSample = exampleGesture.GestureSettings.bEnableScaling ? GestureLog.Samples[0] * StreamingScaler : GestureLog.Samples[0];
+		const float FirstThresholdSq = FMath::Square(exampleGesture.GestureSettings.firstThreshold);
+
+		float d = MAX_FLT;
+		if (GetGestureDistance(ScaledSample, exampleGesture.Samples[0], IsPrimaryMirrored(exampleGesture)) < FirstThresholdSq)
+		{
+			d = StreamingCosts[i];
+		}
+		else if (exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth && GetGestureDistance(ScaledSample, exampleGesture.Samples[0], true) < FirstThresholdSq)
 		{
-			bMirrorGesture = true;
+			d = StreamingMirroredCosts[i];
+		}
 
-			if (GetGestureDistance(inputGesture.Samples[0], exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+		if (d < MAX_FLT)
+		{
+			d /= exampleGesture.Samples.Num();
+			if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
 			{
-				float d = dtw(inputGesture, exampleGesture, bMirrorGesture) / (exampleGesture.Samples.Num());
-				if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
-				{
-					minDist = d;
-					OutGestureIndex = i;
-				}
+				minDist = d;
+				OutGestureIndex = i;
 			}
-		}*/
+		}
 	}
 
-	if (/*minDist < FMath::Square(globalThreshold) && */OutGestureIndex != -1)
+	if (OutGestureIndex != -1)
 	{
-		OnGestureDetected(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB, Size);
-		OnGestureDetected_Bind.Broadcast(GesturesDB->Gestures[OutGestureIndex].GestureType, /*minDist,*/ GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB, Size);
+		OnGestureDetected(GesturesDB->Gestures[OutGestureIndex].GestureType, GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB, Size);
+		OnGestureDetected_Bind.Broadcast(GesturesDB->Gestures[OutGestureIndex].GestureType, GesturesDB->Gestures[OutGestureIndex].Name, OutGestureIndex, GesturesDB, Size);
 		ClearRecording(); // Clear the recording out, we don't want to detect this gesture again with the same data
 		RecordingGestureDraw.Reset();
 	}
 }
 
-float UVRGestureComponent::dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture, float Scaler)
+namespace VRGestureKernels
 {
+	// Squared distance from a single sample to every packed gesture sample, 4 lanes at a time
+	// The packed arrays and the output are padded to a multiple of 4 so there is no scalar tail
+	static FORCEINLINE void ComputeDistanceRow(const FVector3f& Sample, const float* RESTRICT X, const float* RESTRICT Y, const float* RESTRICT Z, int32 PaddedCount, float* RESTRICT OutDistances)
+	{
+		const VectorRegister4Float SampleX = VectorSetFloat1(Sample.X);
+		const VectorRegister4Float SampleY = VectorSetFloat1(Sample.Y);
+		const VectorRegister4Float SampleZ = VectorSetFloat1(Sample.Z);
+
+		for (int32 j = 0; j < PaddedCount; j += 4)
+		{
+			const VectorRegister4Float DX = VectorSubtract(VectorLoad(X + j), SampleX);
+			const VectorRegister4Float DY = VectorSubtract(VectorLoad(Y + j), SampleY);
+			const VectorRegister4Float DZ = VectorSubtract(VectorLoad(Z + j), SampleZ);
+
+			VectorRegister4Float Dist = VectorMultiply(DX, DX);
+			Dist = VectorMultiplyAdd(DY, DY, Dist);
+			Dist = VectorMultiplyAdd(DZ, DZ, Dist);
+			VectorStore(Dist, OutDistances + j);
+		}
+	}
+
+	// Rolling two row DTW shared by the scalar and vectorized paths, ComputeRow fills the distances of input sample i to every gesture sample
+	template<typename RowFunc>
+	static float RunRollingDTW(int32 InputCount, int32 GestureCount, int32 MaxSlope, float AbandonCost, RowFunc&& ComputeRow)
+	{
+		// Only the previous and current rows of the lookup table are ever read, so we roll two rows instead of
+		// allocating the full table. This also keeps it safe to run from multiple workers at once.
+		const int32 RowCount = InputCount + 1;
+		const int32 ColumnCount = GestureCount + 1;
+
+		TArray<float, TInlineAllocator<128>> Rows[2];
+		TArray<int32, TInlineAllocator<128>> SlopeIRows[2];
+		TArray<int32, TInlineAllocator<128>> SlopeJRows[2];
+		TArray<float, TInlineAllocator<128>> RowDistances;
+		RowDistances.SetNumUninitialized(Align(GestureCount, 4));
+
+		for (int32 r = 0; r < 2; ++r)
+		{
+			Rows[r].Init(MAX_FLT, ColumnCount);
+			SlopeIRows[r].SetNumZeroed(ColumnCount);
+			SlopeJRows[r].SetNumZeroed(ColumnCount);
+		}
+
+		// tab[0, 0] = 0, the rest of row 0 and column 0 stay at MAX_FLT
+		Rows[0][0] = 0.f;
+
+		// Find best between seq2 and an ending (postfix) of seq1.
+		float bestMatch = FLT_MAX;
+
+		// Dynamic computation of the DTW matrix.
+		for (int32 i = 1; i < RowCount; i++)
+		{
+			const TArray<float, TInlineAllocator<128>>& LookupPrev = Rows[(i - 1) & 1];
+			const TArray<int32, TInlineAllocator<128>>& SlopeJPrev = SlopeJRows[(i - 1) & 1];
+			TArray<float, TInlineAllocator<128>>& Lookup = Rows[i & 1];
+			TArray<int32, TInlineAllocator<128>>& SlopeI = SlopeIRows[i & 1];
+			TArray<int32, TInlineAllocator<128>>& SlopeJ = SlopeJRows[i & 1];
+
+			ComputeRow(i - 1, RowDistances.GetData());
+			float RowMin = MAX_FLT;
+
+			Lookup[0] = MAX_FLT;
+			SlopeI[0] = 0;
+			SlopeJ[0] = 0;
+
+			for (int32 j = 1; j < ColumnCount; j++)
+			{
+				if (
+					Lookup[j - 1] < LookupPrev[j - 1] &&
+					Lookup[j - 1] < LookupPrev[j] &&
+					SlopeI[j - 1] < MaxSlope)
+				{
+					Lookup[j] = RowDistances[j - 1] + Lookup[j - 1];
+					SlopeI[j] = SlopeJ[j - 1] + 1;
+					SlopeJ[j] = 0;
+				}
+				else if (
+					LookupPrev[j] < LookupPrev[j - 1] &&
+					LookupPrev[j] < Lookup[j - 1] &&
+					SlopeJPrev[j] < MaxSlope)
+				{
+					Lookup[j] = RowDistances[j - 1] + LookupPrev[j];
+					SlopeI[j] = 0;
+					SlopeJ[j] = SlopeJPrev[j] + 1;
+				}
+				else
+				{
+					Lookup[j] = RowDistances[j - 1] + LookupPrev[j - 1];
+					SlopeI[j] = 0;
+					SlopeJ[j] = 0;
+				}
+
+				RowMin = FMath::Min(RowMin, Lookup[j]);
+			}
+
+			if (Lookup[ColumnCount - 1] < bestMatch)
+				bestMatch = Lookup[ColumnCount - 1];
 
-	// #TODO: Skip copying the array and reversing it in the future, we only ever use the reversed value.
-	// So pre-reverse it and keep it stored like that on init. When we do the initial sample we can check off of the first index instead of last then
+			// Costs only ever grow along a path, so once every cell in this row is past the best we could accept we can stop
+			if (RowMin >= FMath::Min(bestMatch, AbandonCost))
+			{
+				break;
+			}
+		}
 
+		return bestMatch < AbandonCost ? bestMatch : MAX_FLT;
+	}
+}
+
+float UVRGestureComponent::dtw(const FVRGesture& seq1, const FVRGesture& seq2, bool bMirrorGesture, float Scaler, float AbandonCost) const
+{
 	// Should also be able to get SizeSquared for values and compared to squared thresholds instead of doing the full SQRT calc.
 
 	// Getting number of average samples recorded over of a gesture (top down) may be able to achieve a basic % completed check
 	// to see how far into detecting a gesture we are, this would require ignoring the last position threshold though....
 
-	int RowCount = seq1.Samples.Num() + 1;
-	int ColumnCount = seq2.Samples.Num() + 1;
+	return VRGestureKernels::RunRollingDTW(seq1.Samples.Num(), seq2.Samples.Num(), maxSlope, AbandonCost, [&](int32 InputIndex, float* OutDistances)
+	{
+		const FVector InputSample = seq1.Samples[InputIndex] * Scaler;
+		for (int32 j = 0; j < seq2.Samples.Num(); ++j)
+		{
+			OutDistances[j] = GetGestureDistance(InputSample, seq2.Samples[j], bMirrorGesture);
+		}
+	});
+}
 
-	TArray<float> LookupTable;
-	LookupTable.AddZeroed(ColumnCount * RowCount);
+float UVRGestureComponent::dtwPacked(const TArray<FVector3f>& PreparedInput, const FVRGesture& seq2, float AbandonCost) const
+{
+	const float* X = seq2.PackedX.GetData();
+	const float* Y = seq2.PackedY.GetData();
+	const float* Z = seq2.PackedZ.GetData();
+	const int32 PaddedCount = seq2.PackedX.Num();
 
-	TArray<int> SlopeI;
-	SlopeI.AddZeroed(ColumnCount * RowCount);
-	TArray<int> SlopeJ;
-	SlopeJ.AddZeroed(ColumnCount * RowCount);
+	return VRGestureKernels::RunRollingDTW(PreparedInput.Num(), seq2.Samples.Num(), maxSlope, AbandonCost, [&](int32 InputIndex, float* OutDistances)
+	{
+		VRGestureKernels::ComputeDistanceRow(PreparedInput[InputIndex], X, Y, Z, PaddedCount, OutDistances);
+	});
+}
 
-	for (int i = 1; i < (ColumnCount * RowCount); i++)
+void UVRGestureComponent::PrepareInputVariants(const FVRGesture& inputGesture, float Scaler)
+{
+	for (int32 Variant = 0; Variant < 4; ++Variant)
 	{
-		LookupTable[i] = MAX_FLT;
+		const float VariantScaler = (Variant & 1) ? Scaler : 1.f;
+		const float MirrorScaler = (Variant & 2) ? -1.f : 1.f;
+
+		TArray<FVector3f>& Prepared = PreparedInput[Variant];
+		Prepared.SetNumUninitialized(inputGesture.Samples.Num(), EAllowShrinking::No);
+
+		for (int32 i = 0; i < inputGesture.Samples.Num(); ++i)
+		{
+			const FVector& Sample = inputGesture.Samples[i];
+			Prepared[i] = FVector3f(Sample.X * VariantScaler, Sample.Y * VariantScaler * MirrorScaler, Sample.Z * VariantScaler);
+		}
 	}
-	// Don't need to do this, it is already handled by add zeroed
-	//tab[0, 0] = 0;
+}
 
-	int icol = 0, icolneg = 0;
+void UVRGestureComponent::BenchmarkDTW(const UGesturesDatabase* GestureDB, int32 Iterations)
+{
+	if (!GestureDB || GestureDB->Gestures.Num() < 1)
+		return;
 
-	// Dynamic computation of the DTW matrix.
-	for (int i = 1; i < RowCount; i++)
+	const UVRGestureComponent* DTWComponent = GetDefault<UVRGestureComponent>();
+	Iterations = FMath::Max(Iterations, 1);
+
+	// Work on a copy so that we can build the cached data without touching the asset
+	TArray<FVRGesture> Gestures = GestureDB->Gestures;
+	TArray<TArray<FVector3f>> PreparedInputs;
+	PreparedInputs.SetNum(Gestures.Num());
+
+	for (int32 i = 0; i < Gestures.Num(); ++i)
 	{
-		for (int j = 1; j < ColumnCount; j++)
+		Gestures[i].RebuildCachedData();
+
+		for (const FVector& Sample : Gestures[i].Samples)
 		{
-			icol = i * ColumnCount;
-			icolneg = icol - ColumnCount;// (i - 1) * ColumnCount;
+			PreparedInputs[i].Add(FVector3f(Sample));
+		}
+	}
 
-			if (
-				LookupTable[icol + (j - 1)] < LookupTable[icolneg + (j - 1)] &&
-				LookupTable[icol + (j - 1)] < LookupTable[icolneg + j] &&
-				SlopeI[icol + (j - 1)] < maxSlope)
-			{
-				LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icol + j - 1];
-				SlopeI[icol + j] = SlopeJ[icol + j - 1] + 1;
-				SlopeJ[icol + j] = 0;
-			}
-			else if (
-				LookupTable[icolneg + j] < LookupTable[icolneg + j - 1] &&
-				LookupTable[icolneg + j] < LookupTable[icol + j - 1] &&
-				SlopeJ[icolneg + j] < maxSlope)
+	TArray<float> ScalarResults;
+	TArray<float> VectorResults;
+	ScalarResults.Reserve(Gestures.Num() * Gestures.Num());
+	VectorResults.Reserve(Gestures.Num() * Gestures.Num());
+
+	// Every recorded gesture is used as the input against every gesture in the database
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		ScalarResults.Reset();
+		for (int32 a = 0; a < Gestures.Num(); ++a)
+		{
+			for (int32 b = 0; b < Gestures.Num(); ++b)
 			{
-				LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icolneg + j];
-				SlopeI[icol + j] = 0;
-				SlopeJ[icol + j] = SlopeJ[icolneg + j] + 1;
+				ScalarResults.Add(DTWComponent->dtw(Gestures[a], Gestures[b]));
 			}
-			else
+		}
+	}
+	const double ScalarTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		VectorResults.Reset();
+		for (int32 a = 0; a < Gestures.Num(); ++a)
+		{
+			for (int32 b = 0; b < Gestures.Num(); ++b)
 			{
-				LookupTable[icol + j] = GetGestureDistance(seq1.Samples[i - 1] * Scaler, seq2.Samples[j - 1], bMirrorGesture) + LookupTable[icolneg + j - 1];
-				SlopeI[icol + j] = 0;
-				SlopeJ[icol + j] = 0;
+				VectorResults.Add(DTWComponent->dtwPacked(PreparedInputs[a], Gestures[b]));
 			}
 		}
 	}
+	const double VectorTime = FPlatformTime::Seconds() - StartTime;
 
-	// Find best between seq2 and an ending (postfix) of seq1.
-	float bestMatch = FLT_MAX;
-
-	for (int i = 1; i < seq1.Samples.Num() + 1/* - seq2.Minimum_Gesture_Length*/; i++)
+	// The packed path runs in single precision, so report how far off it got
+	float MaxRelativeError = 0.f;
+	for (int32 i = 0; i < ScalarResults.Num(); ++i)
 	{
-		if (LookupTable[(i*ColumnCount) + seq2.Samples.Num()] < bestMatch)
-		bestMatch = LookupTable[(i*ColumnCount) + seq2.Samples.Num()];
+		if (ScalarResults[i] < MAX_FLT && VectorResults[i] < MAX_FLT)
+		{
+			MaxRelativeError = FMath::Max(MaxRelativeError, FMath::Abs(ScalarResults[i] - VectorResults[i]) / FMath::Max(ScalarResults[i], UE_KINDA_SMALL_NUMBER));
+		}
+		else if (ScalarResults[i] != VectorResults[i])
+		{
+			MaxRelativeError = MAX_FLT;
+		}
 	}
 
-	return bestMatch;
+	UE_LOGF(LogVRGestureComponent, Log, "BenchmarkDTW %ls: %d gestures x %d iterations, scalar %.3f ms, vectorized %.3f ms (%.2fx), max relative difference %f",
+		*GestureDB->GetName(), Gestures.Num(), Iterations, ScalarTime * 1000.0, VectorTime * 1000.0, VectorTime > 0.0 ? ScalarTime / VectorTime : 0.0, MaxRelativeError);
 }
 
+#if !UE_BUILD_SHIPPING
+namespace VRGestureCvars
+{
+	static FAutoConsoleCommand BenchmarkDTWCommand(
+		TEXT("vr.Gestures.BenchmarkDTW"),
+		TEXT("Runs the scalar and vectorized gesture DTW against every loaded gesture database and logs the timings.\n")
+		TEXT("Optional argument: number of iterations (default 100)"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+			for (TObjectIterator<UGesturesDatabase> It; It; ++It)
+			{
+				UVRGestureComponent::BenchmarkDTW(*It, Iterations);
+			}
+		}));
+}
+#endif
+
 void UVRGestureComponent::DrawDebugGesture(UObject* WorldContextObject, FTransform &StartTransform, FVRGesture GestureToDraw, FColor const& Color, bool bPersistentLines, uint8 DepthPriority, float LifeTime, float Thickness)
 {
 #if ENABLE_DRAW_DEBUG
@@ -784,6 +1389,7 @@ FVRGesture UVRGestureComponent::EndRecording()
 void UVRGestureComponent::ClearRecording()
 {
 	GestureLog.Samples.Reset(RecordingBufferSize);
+	bStreamingStateDirty = true;
 }
 
 void UVRGestureComponent::SaveRecording(FVRGesture &Recording, FString RecordingName, bool bScaleRecordingToDatabase)
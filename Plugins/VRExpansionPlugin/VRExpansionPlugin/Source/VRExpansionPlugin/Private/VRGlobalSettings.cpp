@@ -31,6 +31,7 @@ UVRGlobalSettings::UVRGlobalSettings(const FObjectInitializer& ObjectInitializer
 
 		bUseCollisionModificationForCollisionIgnore = false;
 		CollisionIgnoreSubsystemUpdateRate = 1.f;
+		bUseIncrementalCollisionIgnoreUpdates = false;
 
 		bUseChaosTranslationScalers = false;
 		bSetEngineChaosScalers = false;
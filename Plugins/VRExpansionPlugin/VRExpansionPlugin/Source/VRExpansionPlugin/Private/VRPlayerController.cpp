@@ -8,8 +8,164 @@
 #include "VRPathFollowingComponent.h"
 //#include "VRBPDatatypes.h"
 #include "Engine/Player.h"
+#include "Grippables/GrippableActor.h"
+#include "Grippables/GrippableStaticMeshActor.h"
+#include "Grippables/GrippableSkeletalMeshActor.h"
+#include "HAL/IConsoleManager.h"
 //#include "Runtime/Engine/Private/EnginePrivate.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Auth Movements Batched"), STAT_ClientAuthMovementsBatched, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Client Auth Movement Batch RPCs"), STAT_ClientAuthMovementBatchRPCs, STATGROUP_Game);
+
+  // CVars
+namespace ClientAuthMovementBatchingCvars
+{
+	static int32 BatchClientAuthMovements = 1;
+	FAutoConsoleVariableRef CVarBatchClientAuthMovements(
+		TEXT("vr.ClientAuthMovementBatching"),
+		BatchClientAuthMovements,
+		TEXT("If 1 then client auth throwing movements are batched per connection into a single RPC on the owning AVRBasePlayerController.\n")
+		TEXT("Objects not owned by an AVRBasePlayerController always send their own RPC."),
+		ECVF_Default);
+
+	static float SendInterval = 0.0f;
+	FAutoConsoleVariableRef CVarClientAuthMovementSendInterval(
+		TEXT("vr.ClientAuthMovementBatching.SendInterval"),
+		SendInterval,
+		TEXT("Min seconds between batched client auth movement sends, 0 sends every frame that has pending movements.\n")
+		TEXT("Movements queued for the same object within the window replace each other so only the latest is sent."),
+		ECVF_Default);
+
+	static int32 MaxMovementsPerRPC = 32;
+	FAutoConsoleVariableRef CVarMaxClientAuthMovementsPerRPC(
+		TEXT("vr.ClientAuthMovementBatching.MaxMovementsPerRPC"),
+		MaxMovementsPerRPC,
+		TEXT("Max movements packed into one batched RPC, larger batches are split to keep the bunches a reasonable size."),
+		ECVF_Default);
+}
+
+static AActor* GetTopOwningActor(AActor* InActor)
+{
+	AActor* TopOwner = InActor;
+	while (TopOwner && TopOwner->GetOwner())
+	{
+		TopOwner = TopOwner->GetOwner();
+	}
+
+	return TopOwner;
+}
+
+void AVRBasePlayerController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (PendingClientAuthMovements.Num() > 0)
+	{
+		TimeSinceClientAuthMovementSend += DeltaSeconds;
+		if (TimeSinceClientAuthMovementSend >= ClientAuthMovementBatchingCvars::SendInterval)
+		{
+			FlushClientAuthMovements();
+		}
+	}
+}
+
+bool AVRBasePlayerController::QueueClientAuthMovement(AActor* MovingActor, const FRepMovementVR& NewMovement, uint16 Sequence)
+{
+	if (ClientAuthMovementBatchingCvars::BatchClientAuthMovements < 1 || !MovingActor)
+		return false;
+
+	AVRBasePlayerController* OwningController = Cast<AVRBasePlayerController>(GetTopOwningActor(MovingActor));
+	if (!OwningController || !OwningController->IsLocalController() || OwningController->HasAuthority())
+		return false;
+
+	FVRClientAuthMovementBatchEntry& Entry = OwningController->PendingClientAuthMovements.FindOrAdd(MovingActor);
+	Entry.MovingActor = MovingActor;
+	Entry.Sequence = Sequence;
+	Entry.Movement = NewMovement;
+	return true;
+}
+
+bool AVRBasePlayerController::RemoveQueuedClientAuthMovement(AActor* MovingActor, FRepMovementVR& OutMovement)
+{
+	if (!MovingActor)
+		return false;
+
+	AVRBasePlayerController* OwningController = Cast<AVRBasePlayerController>(GetTopOwningActor(MovingActor));
+	if (!OwningController)
+		return false;
+
+	FVRClientAuthMovementBatchEntry RemovedEntry;
+	if (!OwningController->PendingClientAuthMovements.RemoveAndCopyValue(MovingActor, RemovedEntry))
+		return false;
+
+	OutMovement = RemovedEntry.Movement;
+	return true;
+}
+
+void AVRBasePlayerController::FlushClientAuthMovements()
+{
+	TimeSinceClientAuthMovementSend = 0.0f;
+
+	const int32 MaxPerRPC = FMath::Max(ClientAuthMovementBatchingCvars::MaxMovementsPerRPC, 1);
+	ClientAuthMovementSendBuffer.Reset();
+
+	for (TPair<TWeakObjectPtr<AActor>, FVRClientAuthMovementBatchEntry>& PendingPair : PendingClientAuthMovements)
+	{
+		if (!PendingPair.Key.IsValid())
+			continue;
+
+		ClientAuthMovementSendBuffer.Add(PendingPair.Value);
+
+		if (ClientAuthMovementSendBuffer.Num() >= MaxPerRPC)
+		{
+			INC_DWORD_STAT_BY(STAT_ClientAuthMovementsBatched, ClientAuthMovementSendBuffer.Num());
+			INC_DWORD_STAT(STAT_ClientAuthMovementBatchRPCs);
+			Server_ReceiveClientAuthMovements(ClientAuthMovementSendBuffer);
+			ClientAuthMovementSendBuffer.Reset();
+		}
+	}
+
+	if (ClientAuthMovementSendBuffer.Num() > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_ClientAuthMovementsBatched, ClientAuthMovementSendBuffer.Num());
+		INC_DWORD_STAT(STAT_ClientAuthMovementBatchRPCs);
+		Server_ReceiveClientAuthMovements(ClientAuthMovementSendBuffer);
+		ClientAuthMovementSendBuffer.Reset();
+	}
+
+	PendingClientAuthMovements.Reset();
+}
+
+bool AVRBasePlayerController::Server_ReceiveClientAuthMovements_Validate(const TArray<FVRClientAuthMovementBatchEntry>& Movements)
+{
+	return true;
+}
+
+void AVRBasePlayerController::Server_ReceiveClientAuthMovements_Implementation(const TArray<FVRClientAuthMovementBatchEntry>& Movements)
+{
+	for (const FVRClientAuthMovementBatchEntry& Entry : Movements)
+	{
+		AActor* MovingActor = Entry.MovingActor;
+
+		// Only take movements for objects that this connection actually owns
+		if (!IsValid(MovingActor) || GetTopOwningActor(MovingActor) != this)
+			continue;
+
+		if (AGrippableStaticMeshActor* GrippableStaticMesh = Cast<AGrippableStaticMeshActor>(MovingActor))
+		{
+			GrippableStaticMesh->ApplyBatchedClientAuthMovement(Entry.Movement, Entry.Sequence, this);
+		}
+		else if (AGrippableActor* GrippableActor = Cast<AGrippableActor>(MovingActor))
+		{
+			GrippableActor->ApplyBatchedClientAuthMovement(Entry.Movement, Entry.Sequence, this);
+		}
+		else if (AGrippableSkeletalMeshActor* GrippableSkeletalMesh = Cast<AGrippableSkeletalMeshActor>(MovingActor))
+		{
+			GrippableSkeletalMesh->ApplyBatchedClientAuthMovement(Entry.Movement, Entry.Sequence, this);
+		}
+	}
+}
+
 
 AVRPlayerController::AVRPlayerController(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
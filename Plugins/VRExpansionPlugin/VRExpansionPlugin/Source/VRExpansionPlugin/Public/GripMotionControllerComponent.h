@@ -6,6 +6,9 @@
 //#include "Engine/Engine.h"
 //#include "Engine/EngineBaseTypes.h"
 #include "SceneViewExtension.h"
+#include "UObject/ObjectKey.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "VRBPDatatypes.h"
 #include "MotionControllerComponent.h"
 #include "VRGripInterface.h"
@@ -38,6 +41,17 @@ DECLARE_LOG_CATEGORY_EXTERN(LogVRMotionController, Log, All);
 //For UE4 Profiler ~ Stat Group
 DECLARE_STATS_GROUP(TEXT("TICKGrip"), STATGROUP_TickGrip, STATCAT_Advanced);
 
+// Insights channel for the grip pipeline, enable it with -trace=cpu,VRGrip (or Trace.Enable VRGrip)
+UE_TRACE_CHANNEL_EXTERN(VRGripChannel, VREXPANSIONPLUGIN_API);
+
+// Cycle stat that also shows up as a named scope on the VRGrip trace channel
+#define VRGRIP_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, VRGripChannel)
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("GripReplication ~ Grip Array OnRep"), STAT_GripArrayReplication, STATGROUP_TickGrip, VREXPANSIONPLUGIN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("GripReplication ~ Grips Replicated"), STAT_GripsReplicated, STATGROUP_TickGrip, VREXPANSIONPLUGIN_API);
+
 /** Delegate for notification when the controllers tracking changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRGripControllerOnTrackingEventSignature, const ETrackingStatus &, NewTrackingStatus);
 
@@ -87,7 +101,7 @@ public:
 
 	/** A utility method that calls CacheSceneInfo on ParentComponent and all of its descendants */
 	void GatherLateUpdatePrimitives(USceneComponent* ParentComponent);
-	void ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent* MotionController, TArray<FBPActorGripInformation> & GripArray);
+	void ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent* MotionController, const TArray<FBPActorGripInformation> & GripArray);
 
 	/** Generates a LateUpdatePrimitiveInfo for the given component if it has a SceneProxy and appends it to the current LateUpdatePrimitives array */
 	void CacheSceneInfo(USceneComponent* Component);
@@ -113,6 +127,134 @@ public:
 	FLateUpdateState UpdateStates[2];
 	int32 LateUpdateGameWriteIndex;
 	int32 LateUpdateRenderReadIndex;
+
+	/** Components under a gather root, kept between frames and only re-gathered when something under it is attached or detached */
+	struct FLateUpdateGatherCache
+	{
+		FLateUpdateGatherCache()
+			: LastGatherSetup(0)
+			, LastUsedSetup(0)
+		{}
+
+		/** The root followed by all of its descendants */
+		TArray<TWeakObjectPtr<USceneComponent>> Components;
+		/** Hash of the attach children of each component when gathered, a mismatch means the hierarchy changed */
+		TArray<uint32> AttachChildHashes;
+		uint64 LastGatherSetup;
+		uint64 LastUsedSetup;
+	};
+
+	/** Returns true if the cached hierarchy still matches the components */
+	bool IsGatherCacheValid(const FLateUpdateGatherCache& GatherCache) const;
+
+	/** Order dependent hash of the components attach children, catches swaps that keep the same child count */
+	static uint32 GetAttachChildrenHash(const USceneComponent* Component);
+
+	TMap<TObjectKey<USceneComponent>, FLateUpdateGatherCache> GatherCaches;
+	uint64 SetupCount;
+};
+
+/**
+* Lazily rebuilt GripID / object -> index tables for one of the grip arrays so that grip lookups don't have to walk it.
+* The owning controller marks it dirty when the array changes, found entries are still checked against the array and rebuild it if stale.
+*/
+struct VREXPANSIONPLUGIN_API FVRGripLookupTable
+{
+public:
+	FVRGripLookupTable() :
+		CachedNum(INDEX_NONE)
+	{}
+
+	FORCEINLINE void MarkDirty() { CachedNum = INDEX_NONE; }
+
+	// Same matching rules as the FBPActorGripInformation == operators, returns the first match in the array
+	FBPActorGripInformation* FindByKey(TArray<FBPActorGripInformation>& Grips, uint8 GripID);
+	FBPActorGripInformation* FindByKey(TArray<FBPActorGripInformation>& Grips, const FBPActorGripInformation& Grip) { return FindByKey(Grips, Grip.GripID); }
+	FBPActorGripInformation* FindByKey(TArray<FBPActorGripInformation>& Grips, const UObject* Object);
+
+	// Physics grips are only ever looked up by their GripID
+	FBPActorPhysicsHandleInformation* FindByKey(TArray<FBPActorPhysicsHandleInformation>& PhysicsGrips, uint8 GripID);
+	int32 IndexOfByKey(const TArray<FBPActorPhysicsHandleInformation>& PhysicsGrips, uint8 GripID);
+
+private:
+	template<typename GripType>
+	int32 FindIndexByID(const TArray<GripType>& Grips, uint8 GripID);
+
+	void Rebuild(const TArray<FBPActorGripInformation>& Grips);
+	void Rebuild(const TArray<FBPActorPhysicsHandleInformation>& PhysicsGrips);
+
+	TMap<uint8, int32> IDToIndex;
+	TMap<const UObject*, int32> ObjectToIndex;
+
+	// Array count at the last rebuild, INDEX_NONE when dirty
+	int32 CachedNum;
+};
+
+/**
+* A grips scripts, so that the per frame grip paths don't have to go through the grip interface to get them.
+* Script settings and active state are not cached, they are all blueprint writable and are checked when the scripts are used.
+*/
+struct VREXPANSIONPLUGIN_API FVRGripScriptCache
+{
+public:
+	FVRGripScriptCache() :
+		ScriptOwner(nullptr),
+		bHasScripts(false)
+	{}
+
+	// Object the scripts were pulled from
+	const UObject* ScriptOwner;
+
+	// Return value of GetGripScripts
+	bool bHasScripts;
+
+	// All of the scripts in their original order
+	TArray<UVRGripScriptBase*> Scripts;
+};
+
+/**
+* A grip whose world transform is calculated off of the game thread by the batched grip update (UVRGripUpdateSubsystem).
+* Filled in on the game thread, ran in parallel, then matched back up by GripID and GrippedObject when the grip is applied.
+*/
+struct VREXPANSIONPLUGIN_API FVRBatchedGripJob
+{
+public:
+	FVRBatchedGripJob() :
+		Grip(nullptr),
+		GripID(INVALID_VRGRIP_ID),
+		GrippedObject(nullptr),
+		Actor(nullptr),
+		Root(nullptr),
+		bRootHasInterface(false),
+		bActorHasInterface(false),
+		bUseDefaultScript(false),
+		WorldTransform(FTransform::Identity),
+		bHasValidTransform(false),
+		bForceADrop(false),
+		bIsComplete(false)
+	{}
+
+	// Only valid until the grip arrays are next modified, do not use outside of the parallel phase
+	FBPActorGripInformation* Grip;
+	uint8 GripID;
+	const UObject* GrippedObject;
+
+	// Held so that the script arrays outlive a re-sort of the cache
+	TSharedPtr<FVRGripScriptCache> ScriptCache;
+	AActor* Actor;
+	UPrimitiveComponent* Root;
+	bool bRootHasInterface;
+	bool bActorHasInterface;
+
+	// Script states are captured when gathering so that the parallel phase doesn't read them
+	bool bUseDefaultScript;
+	TArray<UVRGripScriptBase*, TInlineAllocator<2>> ActiveTransformScripts;
+
+	// Results
+	FTransform WorldTransform;
+	bool bHasValidTransform;
+	bool bForceADrop;
+	bool bIsComplete;
 };
 
 /**
@@ -324,7 +466,7 @@ public:
 	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	virtual void InitializeComponent() override;
 	virtual void OnUnregister() override;
-	//virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
 	virtual void Deactivate() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void BeginDestroy() override;
@@ -495,19 +637,32 @@ public:
 	}
 
 	// When possible I suggest that you use GetAllGrips/GetGrippedObjects instead of directly referencing this
+	// Delta replicated, only grips that changed since the last update are sent
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_GrippedObjects)
-	TArray<FBPActorGripInformation> GrippedObjects;
+	FBPGripArray GrippedObjects;
 
 	// If modifying members in gripped objects directly or a specific grip you need to call this function if you are using Push Networking
 	void DIRTY_GRIPPED_OBJECTS();
 
 	// When possible I suggest that you use GetAllGrips/GetGrippedObjects instead of directly referencing this
+	// Delta replicated, only grips that changed since the last update are sent
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_LocallyGrippedObjects)
-	TArray<FBPActorGripInformation> LocallyGrippedObjects;
+	FBPGripArray LocallyGrippedObjects;
 
 	// If modifying members in locally gripped objects directly or a specific grip you need to call this function if you are using Push Networking
 	void DIRTY_LOCALLY_GRIPPED_OBJECTS();
 
+	// Indexed lookups into the grip arrays, Key can be a GripID, a grip, or the gripped object
+	// The DIRTY_ functions above also invalidate the lookup tables, so call them when adding or removing grips
+	template<typename KeyType>
+	FORCEINLINE FBPActorGripInformation* FindGrippedObjectByKey(const KeyType& Key) { return GrippedObjectsLookup.FindByKey(GrippedObjects.Grips, Key); }
+
+	template<typename KeyType>
+	FORCEINLINE FBPActorGripInformation* FindLocallyGrippedObjectByKey(const KeyType& Key) { return LocallyGrippedObjectsLookup.FindByKey(LocallyGrippedObjects.Grips, Key); }
+
+	FVRGripLookupTable GrippedObjectsLookup;
+	FVRGripLookupTable LocallyGrippedObjectsLookup;
+
 
 	// Local Grip TransactionalBuffer to store server sided grips that need to be emplaced into the local buffer
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GripMotionController", ReplicatedUsing = OnRep_LocalTransaction)
@@ -594,6 +749,8 @@ public:
 	// Handles variable state changes and specific actions on a grip replication
 	inline bool HandleGripReplication(FBPActorGripInformation & Grip, FBPActorGripInformation * OldGripInfo = nullptr)
 	{
+		INC_DWORD_STAT(STAT_GripsReplicated);
+
 		if (Grip.ValueCache.bWasInitiallyRepped && Grip.GripID != Grip.ValueCache.CachedGripID)
 		{
 			// There appears to be a bug with TArray replication where if you replace an index with another value of that
@@ -786,28 +943,26 @@ public:
 		CheckTransactionBuffer();
 	}
 
+	// Individual grips are handled in the OnReplicatedGrip functions below as they arrive, this is called after the full update
 	UFUNCTION()
-	virtual void OnRep_GrippedObjects(TArray<FBPActorGripInformation> OriginalArrayState) // Original array state is useless without full serialize, it just hold last delta
+	virtual void OnRep_GrippedObjects()
 	{
 		// Need to think about how best to handle the simulating flag here, don't handle for now
-		// Check for removed gripped actors
-		// This might actually be better left as an RPC multicast
-
-		for (int i = GrippedObjects.Num() - 1; i >= 0; --i)
-		{
-			HandleGripReplication(GrippedObjects[i], OriginalArrayState.FindByKey(GrippedObjects[i].GripID));
-		}
+		// Removed grips are handled by the drop RPCs, the array removal only cleans up the entry
+		GrippedObjectsLookup.MarkDirty();
 	}
 
 	UFUNCTION()
-	virtual void OnRep_LocallyGrippedObjects(TArray<FBPActorGripInformation> OriginalArrayState)
+	virtual void OnRep_LocallyGrippedObjects()
 	{
-		for (int i = LocallyGrippedObjects.Num() - 1; i >= 0; --i)
-		{
-			HandleGripReplication(LocallyGrippedObjects[i], OriginalArrayState.FindByKey(LocallyGrippedObjects[i].GripID));
-		}
+		LocallyGrippedObjectsLookup.MarkDirty();
 	}
 
+	// Fast array callbacks from the replicated grip arrays, only called for the grips that changed
+	virtual void OnReplicatedGripAdded(const FBPGripArray& InGripArray, FBPActorGripInformation& Grip);
+	virtual void OnReplicatedGripChanged(const FBPGripArray& InGripArray, FBPActorGripInformation& Grip);
+	virtual void OnReplicatedGripRemoved(const FBPGripArray& InGripArray, FBPActorGripInformation& Grip);
+
 	UPROPERTY(BlueprintReadWrite, Category = "GripMotionController")
 	TArray<TObjectPtr<UPrimitiveComponent>> AdditionalLateUpdateComponents;
 
@@ -844,6 +999,11 @@ public:
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case, also used for remotes to lerp position
 	float ControllerNetUpdateCount;
 
+	// Scales the send rate between a minimum and ControllerNetUpdateRate by how fast the controller is moving
+	// Best paired with snapshot interpolation on the receiving end as the time between updates will vary
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GripMotionController|Networking")
+		FBPVRAdaptiveNetUpdateSettings AdaptiveNetUpdateSettings;
+
 	protected:
 	// Whether to smooth (lerp) between ticks for the replicated motion, DOES NOTHING if update rate is larger than FPS!
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "GripMotionController|Networking")
@@ -866,9 +1026,24 @@ public:
 		float NetworkMaxSmoothUpdateDistance = 50.f;
 
 	// Max distance to allow smoothing before snapping entirely to the new position
-	UPROPERTY(EditAnywhere, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bUseExponentialSmoothing"))
+	UPROPERTY(EditAnywhere, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bUseExponentialSmoothing || bUseSnapshotInterpolation"))
 		float NetworkNoSmoothUpdateDistance = 100.f;
 
+	// If true then received poses are buffered and played back SnapshotInterpolationDelay behind, overrides the lerp / exponential smoothing
+	// Covers late and lost packets so lower ControllerNetUpdateRates don't stutter, at the cost of the added delay
+	UPROPERTY(EditAnywhere, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bSmoothReplicatedMotion"))
+		bool bUseSnapshotInterpolation = false;
+
+	// How far behind the newest received pose to render, should be a bit over one send interval
+	UPROPERTY(EditAnywhere, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0", UIMin = "0"))
+		float SnapshotInterpolationDelay = 0.05f;
+
+	// Max time to extrapolate past the newest pose if the buffer runs dry before holding position
+	UPROPERTY(EditAnywhere, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0", UIMin = "0"))
+		float SnapshotMaxExtrapolationTime = 0.1f;
+
+	FVRTrackedPoseSnapshotBuffer PoseSnapshotBuffer;
+
 	protected:
 
 	// Whether to replicate even if no tracking (FPS or test characters)
@@ -1266,6 +1441,40 @@ public:
 
 	// Gets the world transform of a grip, modified by secondary grips, returns if it has a valid transform, if not then this tick will be skipped for the object
 	bool GetGripWorldTransform(TArray<UVRGripScriptBase*>& GripScripts, float DeltaTime,FTransform & WorldTransform, const FTransform &ParentTransform, FBPActorGripInformation &Grip, AActor * actor, UPrimitiveComponent * root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool &bForceADrop);
+	bool GetGripWorldTransform(const FVRGripScriptCache& GripScripts, float DeltaTime, FTransform& WorldTransform, const FTransform& ParentTransform, FBPActorGripInformation& Grip, AActor* actor, UPrimitiveComponent* root, bool bRootHasInterface, bool bActorHasInterface, bool bIsForTeleport, bool& bForceADrop);
+
+	// The game thread only part of GetGripWorldTransform that runs after the grip scripts (global lerp to hand and validation)
+	bool FinalizeGripWorldTransform(float DeltaTime, FTransform& WorldTransform, FBPActorGripInformation& Grip, bool bHasValidTransform);
+
+	// Grips that the batched grip update is calculating the world transform for this frame
+	TArray<FVRBatchedGripJob> BatchedGripJobs;
+
+	// The pivot transform that the batched jobs were calculated with
+	FTransform BatchedGripParentTransform;
+
+	// Defers TickGrip to the UVRGripUpdateSubsystem if batching is enabled, returns false if we should tick our grips ourselves
+	bool QueueBatchedGripUpdate(float DeltaTime);
+
+	// Fills BatchedGripJobs with the grips whose transform logic can run in parallel (game thread)
+	void GatherBatchedGripJobs(float DeltaTime);
+
+	// Runs the transform logic of BatchedGripJobs, safe to call off of the game thread
+	void RunBatchedGripJobs();
+
+	// Returns the completed batched job for this grip if there is one
+	const FVRBatchedGripJob* FindBatchedGripJob(const FBPActorGripInformation& Grip) const;
+
+	// Delta time that BatchedGripJobs were gathered with
+	float BatchedGripDeltaTime;
+
+	// Cached grip scripts per GripID, shared so that callers can hold onto one while scripts grip / drop objects
+	TMap<uint8, TSharedPtr<FVRGripScriptCache>> GripScriptCaches;
+
+	// Scratch list that the owners current scripts are pulled into to check the cache against
+	TArray<UVRGripScriptBase*> GripScriptScratch;
+
+	// Returns the cached scripts of ScriptOwner (the object implementing the grip interface) for this grip, rebuilding them if the owners script list changed
+	TSharedPtr<FVRGripScriptCache> GetGripScriptCache(const FBPActorGripInformation& Grip, UObject* ScriptOwner);
 
 	// Calculate component to world without the protected tag, doesn't set it, just returns it
 	inline FTransform CalcControllerComponentToWorld(FRotator Orientation, FVector Position)
@@ -1397,6 +1606,7 @@ public:
 	bool GetPhysicsJointLength(const FBPActorGripInformation &GrippedActor, UPrimitiveComponent * rootComp, FVector & LocOut);
 
 	TArray<FBPActorPhysicsHandleInformation> PhysicsGrips;
+	FVRGripLookupTable PhysicsGripsLookup;
 	FBPActorPhysicsHandleInformation * GetPhysicsGrip(const FBPActorGripInformation & GripInfo);
 	FBPActorPhysicsHandleInformation * GetPhysicsGrip(const uint8 GripID);
 	bool GetPhysicsGripIndex(const FBPActorGripInformation & GripInfo, int & index);
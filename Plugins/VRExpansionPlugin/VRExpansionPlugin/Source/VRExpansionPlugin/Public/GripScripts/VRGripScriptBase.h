@@ -83,6 +83,11 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditDefaultsOnly, Category = "GSSettings")
 	EGSTransformOverrideType WorldTransformOverrideType;
 
+	// If the world transform logic of this script can be run off of the game thread by the batched grip update (vr.BatchedGripUpdates)
+	// Only set this if GetWorldTransform is pure math on the grip and its passed in values, blueprint scripts are never run in parallel
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category = "GSSettings")
+		bool bCanRunWorldTransformInParallel;
+
 	// Returns if the script wants auto drop to be ignored
 	FORCEINLINE bool Wants_DenyAutoDrop()
 	{
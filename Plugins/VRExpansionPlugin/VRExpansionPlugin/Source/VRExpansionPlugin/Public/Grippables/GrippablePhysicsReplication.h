@@ -13,6 +13,7 @@
 #include "Chaos/PhysicsObject.h"
 #include "Chaos/SimCallbackObject.h"
 #include "Physics/NetworkPhysicsSettingsComponent.h"
+#include "Misc/BucketUpdateSubsystem.h"
 
 
 #include "GrippablePhysicsReplication.generated.h"
@@ -124,6 +125,24 @@ public:
 
 #pragma endregion // FPhysicsReplicationAsync
 
+// A legacy flow target that needs an update this frame, gathered so that they can be prioritized against the full update budget
+struct FVRPhysicsReplicationCandidate
+{
+	UPrimitiveComponent* PrimComp;
+	FBodyInstance* BI;
+	FReplicatedPhysicsTarget* PhysicsTarget;
+	float OwnerPing;
+	float Priority;
+
+	FVRPhysicsReplicationCandidate(UPrimitiveComponent* InPrimComp, FBodyInstance* InBI, FReplicatedPhysicsTarget* InPhysicsTarget, float InOwnerPing) :
+		PrimComp(InPrimComp),
+		BI(InBI),
+		PhysicsTarget(InPhysicsTarget),
+		OwnerPing(InOwnerPing),
+		Priority(0.0f)
+	{}
+};
+
 class FPhysicsReplicationVR : public FPhysicsReplication
 {
 public:
@@ -145,7 +164,7 @@ public:
 
 
 
-	void SetReplicatedTargetVR(Chaos::FConstPhysicsObjectHandle PhysicsObject, const FRigidBodyState& ReplicatedTarget, int32 ServerFrame, EPhysicsReplicationMode ReplicationMode = EPhysicsReplicationMode::Default);
+	void SetReplicatedTargetVR(Chaos::FConstPhysicsObjectHandle PhysicsObject, const FRigidBodyState& ReplicatedTarget, int32 ServerFrame, EPhysicsReplicationMode ReplicationMode = EPhysicsReplicationMode::Default, float OwnerPing = 0.0f);
 
 	virtual void RemoveReplicatedTarget(UPrimitiveComponent* Component) override;
 
@@ -157,11 +176,23 @@ public:
 
 	TMap<TWeakObjectPtr<UPrimitiveComponent>, FReplicatedPhysicsTarget> ComponentToTargetsVR_DEPRECATED; // This collection is keeping the legacy flow working until fully deprecated in a future release
 	TArray<FReplicatedPhysicsTarget> ReplicatedTargetsQueueVR;
+	TArray<float> ReplicatedTargetsQueueOwnerPingVR; // Owner ping in ms of each entry in ReplicatedTargetsQueueVR
 	FPhysicsReplicationAsyncVR* PhysicsReplicationAsyncVR;
 	FPhysicsReplicationAsyncInput* AsyncInputVR;	//async data being written into before we push into callback
 	TWeakObjectPtr<UNetworkPhysicsSettingsComponent> SettingsCurrent;
 	TArray<TWeakObjectPtr<UPrimitiveComponent>> PendingDeleteFromComponentsToTargetsVR;
 
+	// Full update budget for the legacy flow
+	TArray<FVRPhysicsReplicationCandidate> UpdateCandidatesVR;
+	TArray<FVector> ViewLocationsVR;
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, double> LastFullUpdateTimeVR;
+
+	/** Returns the ping in ms of the player that owns this actor, 0 if it is server owned */
+	static float GetOwnerPingVR(AActor* OwningActor);
+
+	/** Scores the candidates and sorts them so that the most important ones are first */
+	void PrioritizeUpdateCandidates(UWorld* World, double CurrentTime);
+
 	bool NetworkPhysicsTickOffsetAssignedVR = false;
 	int32 NetworkPhysicsTickOffsetVR = 0;
 
@@ -217,6 +248,29 @@ struct TStructOpsTypeTraits<FRepMovementVR> : public TStructOpsTypeTraitsBase2<F
 	};
 };
 
+// A single objects movement in a batched client auth movement RPC
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRClientAuthMovementBatchEntry
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY()
+		TObjectPtr<AActor> MovingActor;
+
+	// Per object sequence so that the server can drop states older than one it already applied
+	UPROPERTY()
+		uint16 Sequence;
+
+	UPROPERTY()
+		FRepMovementVR Movement;
+
+	FVRClientAuthMovementBatchEntry() :
+		MovingActor(nullptr),
+		Sequence(0)
+	{}
+};
+
 USTRUCT(BlueprintType)
 struct VREXPANSIONPLUGIN_API FVRClientAuthReplicationData
 {
@@ -232,17 +286,35 @@ public:
 		int32 UpdateRate;
 
 	FTimerHandle ResetReplicationHandle;
+	FBucketUpdateHandle BucketUpdateHandle;
 	FTransform LastActorTransform;
 	float TimeAtInitialThrow;
 	bool bIsCurrentlyClientAuth;
 
+	// Batched movement sequence, the last one sent on the client and the last one applied on the server
+	uint16 MovementSequence;
+	TWeakObjectPtr<const AActor> MovementSequenceSender;
+
 	FVRClientAuthReplicationData() :
 		bUseClientAuthThrowing(false),
 		UpdateRate(30),
 		LastActorTransform(FTransform::Identity),
 		TimeAtInitialThrow(0.0f),
-		bIsCurrentlyClientAuth(false)
+		bIsCurrentlyClientAuth(false),
+		MovementSequence(0)
+	{
+
+	}
+
+	// Returns true if this batched movement is newer than the last one applied from the sender and stores it
+	// A new sender starts fresh as its sequence is unrelated to the last ones
+	bool ConsumeMovementSequence(uint16 Sequence, const AActor* Sender)
 	{
+		if (MovementSequenceSender.Get() == Sender && (int16)(Sequence - MovementSequence) <= 0)
+			return false;
 
+		MovementSequence = Sequence;
+		MovementSequenceSender = Sender;
+		return true;
 	}
 };
\ No newline at end of file
@@ -142,6 +142,9 @@ public:
 	UFUNCTION(UnReliable, Server, WithValidation, Category = "Networking")
 		void Server_GetClientAuthReplication(const FRepMovementVR & newMovement);
 
+	// Applies a movement received through the batched player controller RPC, states older than the last applied one are dropped
+	void ApplyBatchedClientAuthMovement(const FRepMovementVR& newMovement, uint16 Sequence, const AActor* Sender);
+
 	// Returns if this object is currently client auth throwing
 	UFUNCTION(BlueprintPure, Category = "Networking")
 		FORCEINLINE bool IsCurrentlyClientAuthThrowing()
@@ -237,18 +237,21 @@ public:
 
 	/**
 	* Gets all hand socket components in the entire level (this is a slow operation, DO NOT run this on tick)
+	* Only returns sockets that are registered to a game, PIE, or editor world
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data")
 		static void GetAllHandSocketComponents(TArray<UHandSocketComponent*>& OutHandSockets);
 
 	/**
-	* Gets all hand socket components within a set range of a world location (this is a slow operation, DO NOT run this on tick)
+	* Gets all hand socket components within a set range of a world location
+	* Uses the per world hand socket registry so only nearby sockets are tested
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data")
 		static bool GetAllHandSocketComponentsInRange(FVector SearchFromWorldLocation, float SearchRange, TArray<UHandSocketComponent*>& OutHandSockets);
 
 	/**
-	* Gets the closest hand socket component within a set range of a world location (this is a slow operation, DO NOT run this on tick)
+	* Gets the closest hand socket component within a set range of a world location
+	* Uses the per world hand socket registry so only nearby sockets are tested
 	* Must check the output for validity
 	*/
 	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data")
@@ -399,6 +402,8 @@ public:
 #endif
 	virtual void Serialize(FArchive& Ar) override;
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
 	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 
 	// ------------------------------------------------
@@ -436,6 +441,21 @@ public:
 		void SetReplicateMovement(bool NewReplicateMovement);
 		inline bool GetReplicateMovement() { return bReplicateMovement; };
 
+	private:
+
+		// Hand socket registry tracking, the registry indexes us by location for the range queries
+		void RegisterWithHandSocketRegistry();
+		void UnregisterFromHandSocketRegistry();
+		void OnOwnerRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+		bool bRegisteredWithHandSocketRegistry = false;
+
+		// Locked sockets are absolute and don't get transform updates when the actor moves, so we listen to the root instead
+		TWeakObjectPtr<USceneComponent> RegistryTrackedRoot;
+		FDelegateHandle RootTransformUpdatedHandle;
+
+	public:
+
 	/** mesh component to indicate hand placement */
 #if WITH_EDITORONLY_DATA
 
@@ -15,6 +15,34 @@
 DECLARE_DELEGATE_RetVal(bool, FBucketUpdateTickSignature);
 DECLARE_DYNAMIC_DELEGATE(FDynamicBucketUpdateTickSignature);
 
+// Handle to a native bucket update callback, used to remove it without searching the buckets
+struct VREXPANSIONPLUGIN_API FBucketUpdateHandle
+{
+	uint64 ID;
+	uint32 UpdateHTZ;
+
+	FBucketUpdateHandle() :
+		ID(0),
+		UpdateHTZ(0)
+	{}
+
+	bool IsValid() const
+	{
+		return ID != 0;
+	}
+
+	void Invalidate()
+	{
+		ID = 0;
+		UpdateHTZ = 0;
+	}
+
+	bool operator==(const FBucketUpdateHandle& Other) const
+	{
+		return ID == Other.ID;
+	}
+};
+
 USTRUCT()
 struct VREXPANSIONPLUGIN_API FUpdateBucketDrop
 {
@@ -25,6 +53,9 @@ public:
 	
 	FName FunctionName;
 
+	// Unique ID of this entry, what handles refer to
+	uint64 HandleID;
+
 	bool ExecuteBoundCallback();
 	bool IsBoundToObjectFunction(UObject * Obj, FName & FuncName);
 	bool IsBoundToObjectDelegate(FDynamicBucketUpdateTickSignature & DynEvent);
@@ -32,6 +63,7 @@ public:
 	FUpdateBucketDrop();
 	FUpdateBucketDrop(FDynamicBucketUpdateTickSignature & DynCallback);
 	FUpdateBucketDrop(UObject * Obj, FName FuncName);
+	FUpdateBucketDrop(FBucketUpdateTickSignature && Callback);
 };
 
 
@@ -45,17 +77,45 @@ public:
 	float nUpdateRate;
 	float nUpdateCount;
 
+	// Spreading state, the next callback to run and the fractional callbacks owed from previous frames
+	int32 SpreadIndex;
+	float SpreadAccumulator;
+
 	TArray<FUpdateBucketDrop> Callbacks;
 
-	bool Update(float DeltaTime);
+	// Index of each callback by its HandleID
+	TMap<uint64, int32> HandleToIndex;
 
-	FUpdateBucket() {}
+	// If bSpreadUpdates is true then the callbacks are run in slices every frame instead of all at once when the rate elapses
+	// MaxCallbacksPerFrame caps the slice size when spreading, 0 is unlimited
+	bool Update(float DeltaTime, bool bSpreadUpdates = false, int32 MaxCallbacksPerFrame = 0);
+
+	void AddCallback(FUpdateBucketDrop && NewDrop, uint64 HandleID);
+
+	// Swap removes a callback, order in the bucket isn't guaranteed
+	void RemoveCallbackAt(int32 Index);
+
+	bool RemoveCallbackByHandle(uint64 HandleID);
+
+	FUpdateBucket() :
+		nUpdateRate(0.0f),
+		nUpdateCount(0.0f),
+		SpreadIndex(0),
+		SpreadAccumulator(0.0f)
+	{}
 
 	FUpdateBucket(uint32 UpdateHTZ) :
 		nUpdateRate(1.0f / UpdateHTZ),
-		nUpdateCount(0.0f)
+		nUpdateCount(0.0f),
+		SpreadIndex(0),
+		SpreadAccumulator(0.0f)
 	{
 	}
+
+private:
+
+	void UpdateAll(float DeltaTime);
+	void UpdateSpread(float DeltaTime, int32 MaxCallbacksPerFrame);
 };
 
 USTRUCT()
@@ -68,10 +128,17 @@ public:
 	bool bNeedsUpdate;
 	TMap<uint32, FUpdateBucket> ReplicationBuckets;
 
+	// Last handed out HandleID, 0 is invalid
+	uint64 LastHandleID;
+
+	// Scratch storage reused between updates
+	TArray<uint32> BucketsToRemove;
+
 	void UpdateBuckets(float DeltaTime);
 
 	bool AddBucketObject(uint32 UpdateHTZ, UObject* InObject, FName FunctionName);
 	bool AddBucketObject(uint32 UpdateHTZ, FDynamicBucketUpdateTickSignature &Delegate);
+	FBucketUpdateHandle AddBucketCallback(uint32 UpdateHTZ, FBucketUpdateTickSignature &&Callback);
 
 	/*
 	template<typename classType>
@@ -82,17 +149,24 @@ public:
 
 	bool RemoveBucketObject(UObject * ObjectToRemove, FName FunctionName);
 	bool RemoveBucketObject(FDynamicBucketUpdateTickSignature &DynEvent);
+	bool RemoveBucketCallback(const FBucketUpdateHandle &Handle);
 	bool RemoveObjectFromAllBuckets(UObject * ObjectToRemove);
 
 	bool IsObjectInBucket(UObject * ObjectToRemove);
 	bool IsObjectFunctionInBucket(UObject * ObjectToRemove, FName FunctionName);
 	bool IsObjectDelegateInBucket(FDynamicBucketUpdateTickSignature &DynEvent);
+	bool IsHandleInBucket(const FBucketUpdateHandle &Handle) const;
 
 	FUpdateBucketContainer()
 	{
 		bNeedsUpdate = false;
+		LastHandleID = 0;
 	};
 
+private:
+
+	FUpdateBucket& FindOrAddBucket(uint32 UpdateHTZ);
+
 };
 
 UCLASS()
@@ -128,6 +202,42 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Object to Bucket Updates by Event", ScriptName = "AddBucketObjectEvent"), Category = "BucketUpdateSubsystem")
 		bool K2_AddObjectEventToBucket(UPARAM(DisplayName = "Event") FDynamicBucketUpdateTickSignature Delegate, int32 UpdateHTZ = 100);
 
+	// Native callback registration, these skip the reflection call of the UFUNCTION path
+	// The callback returns true to stay in the bucket and false to be removed
+	// Returns a handle that removes the callback in constant time with RemoveFromBucket
+	FBucketUpdateHandle AddCallbackToBucket(int32 UpdateHTZ, FBucketUpdateTickSignature&& Callback);
+
+	template<typename UserClass>
+	FBucketUpdateHandle AddUObjectToBucket(int32 UpdateHTZ, UserClass* InObject, bool (UserClass::*InFunc)())
+	{
+		return AddCallbackToBucket(UpdateHTZ, FBucketUpdateTickSignature::CreateUObject(InObject, InFunc));
+	}
+
+	template<typename UserClass>
+	FBucketUpdateHandle AddRawToBucket(int32 UpdateHTZ, UserClass* InObject, bool (UserClass::*InFunc)())
+	{
+		return AddCallbackToBucket(UpdateHTZ, FBucketUpdateTickSignature::CreateRaw(InObject, InFunc));
+	}
+
+	template<typename FunctorType>
+	FBucketUpdateHandle AddLambdaToBucket(int32 UpdateHTZ, FunctorType&& InFunctor)
+	{
+		return AddCallbackToBucket(UpdateHTZ, FBucketUpdateTickSignature::CreateLambda(Forward<FunctorType>(InFunctor)));
+	}
+
+	// Lambda that is automatically skipped and removed once InObject is no longer valid
+	template<typename UserClass, typename FunctorType>
+	FBucketUpdateHandle AddWeakLambdaToBucket(int32 UpdateHTZ, UserClass* InObject, FunctorType&& InFunctor)
+	{
+		return AddCallbackToBucket(UpdateHTZ, FBucketUpdateTickSignature::CreateWeakLambda(InObject, Forward<FunctorType>(InFunctor)));
+	}
+
+	// Removes a native callback and invalidates the handle, safe to call with stale handles
+	bool RemoveFromBucket(FBucketUpdateHandle& Handle);
+
+	// Returns if the native callback for this handle is still in a bucket
+	bool IsHandleInBucket(const FBucketUpdateHandle& Handle) const;
+
 	// Remove the entry in the bucket updates with the passed in UFUNCTION name
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Remove Object From Bucket Updates By Function", ScriptName = "RemoveObjectFromBucketByFunction"), Category = "BucketUpdateSubsystem")
 		bool RemoveObjectFromBucketByFunctionName(UObject* InObject = nullptr, FName FunctionName = NAME_None);
@@ -24,6 +24,8 @@
 
 
 DECLARE_LOG_CATEGORY_EXTERN(VRE_CollisionIgnoreLog, Log, All);
+//For UE4 Profiler ~ Stat Group
+DECLARE_STATS_GROUP(TEXT("CollisionIgnore"), STATGROUP_CollisionIgnore, STATCAT_Advanced);
 
 
 USTRUCT()
@@ -53,6 +55,12 @@ struct FChaosParticlePair
 			(ParticleHandle1 == Other.ParticleHandle1 || ParticleHandle1 == Other.ParticleHandle0)
 			);
 	}
+
+	// Order independent so that (A, B) and (B, A) land in the same bucket, matches operator==
+	friend uint32 GetTypeHash(const FChaosParticlePair& InKey)
+	{
+		return GetTypeHash(InKey.ParticleHandle0) ^ GetTypeHash(InKey.ParticleHandle1);
+	}
 };
 
 /*
@@ -63,20 +71,42 @@ struct FSimCallbackInputVR : public Chaos::FSimCallbackInput
 	virtual ~FSimCallbackInputVR() {}
 	void Reset() 
 	{
-		ParticlePairs.Empty();
+		ParticlePairs.Reset();
+		PairsToAdd.Reset();
+		PairsToRemove.Reset();
+		BaseVersion = 0;
+		Version = 0;
+		bIsFullRebuild = false;
+		bHasChanges = false;
 	}
 
-	TArray<FChaosParticlePair> ParticlePairs;
+	// Full pair set, only used when bIsFullRebuild is set
+	TSet<FChaosParticlePair> ParticlePairs;
+
+	// Incremental deltas applied on top of the physics threads persistent set when BaseVersion matches its current version
+	TArray<FChaosParticlePair> PairsToAdd;
+	TArray<FChaosParticlePair> PairsToRemove;
+
+	uint32 BaseVersion = 0;
+	uint32 Version = 0;
+	bool bIsFullRebuild = false;
+	bool bHasChanges = false;
 
-	bool bIsInitialized;
+	bool bIsInitialized = false;
 };
 
-struct FSimCallbackNoOutputVR : public Chaos::FSimCallbackOutput
+struct FSimCallbackOutputVR : public Chaos::FSimCallbackOutput
 {
-	void Reset() {}
+	void Reset() 
+	{
+		bRequiresFullRebuild = false;
+	}
+
+	// Set when the physics thread missed an incremental update and needs the full pair set re-sent
+	bool bRequiresFullRebuild = false;
 };
 
-class FCollisionIgnoreSubsystemAsyncCallback : public Chaos::TSimCallbackObject<FSimCallbackInputVR, FSimCallbackNoOutputVR, Chaos::ESimCallbackOptions::ContactModification>
+class FCollisionIgnoreSubsystemAsyncCallback : public Chaos::TSimCallbackObject<FSimCallbackInputVR, FSimCallbackOutputVR, Chaos::ESimCallbackOptions::ContactModification>
 {
 
 private:
@@ -95,6 +125,12 @@ private:
 	*/
 	virtual void OnContactModification_Internal(Chaos::FCollisionContactModifier& Modifier) override;
 
+	// Applies any new full or incremental input to the persistent pair set
+	void ApplyInput_Internal(const FSimCallbackInputVR& Input);
+
+	// Persistent pair set owned by the physics thread, built up from the game thread inputs
+	TSet<FChaosParticlePair> ParticlePairs_Internal;
+	uint32 AppliedVersion_Internal = 0;
 };
 
 
@@ -150,9 +186,14 @@ public:
 	UPROPERTY()
 	FName BoneName2;
 
+	// Physics thread particles for this pair, cached at creation so removals don't need to touch a possibly destroyed actor handle
+	FChaosParticlePair ParticlePair;
+
 	// Flip our elements to retain a default ordering in an array
 	void FlipElements()
 	{
+		Swap(ParticlePair.ParticleHandle0, ParticlePair.ParticleHandle1);
+
 		FPhysicsActorHandle tH = Actor1;
 		Actor1 = Actor2;
 		Actor2 = tH;
@@ -240,8 +281,27 @@ public:
 	bool IsComponentIgnoringCollision(UPrimitiveComponent* Prim1);
 	bool AreComponentsIgnoringCollisions(UPrimitiveComponent* Prim1, UPrimitiveComponent* Prim2);
 	bool HasCollisionIgnorePairs();
+
+	// Called when a tracked primitive has its physics state destroyed, used to invalidate pairs in incremental mode instead of polling
+	UFUNCTION()
+		void OnTrackedPrimitivePhysicsStateChanged(UPrimitiveComponent* ChangedComponent, EComponentPhysicsStateChange StateChange);
+
 private:
 
+	// Pushes a single added or removed pair to the sim callback input when using incremental updates
+	void PushPairDelta(const FChaosParticlePair& ParticlePair, bool bWasAdded);
+
+	// Drains the callback outputs and re-sends the full pair set if the physics thread requested it
+	void ProcessCallbackOutputs();
+
+	void BindPhysicsStateChanged(UPrimitiveComponent* Prim);
+	void UnbindPhysicsStateChangedIfUntracked(UPrimitiveComponent* Prim);
+
+	bool IsUsingIncrementalUpdates() const;
+
 	FTimerHandle UpdateHandle;
 
+	// Version of the last input sent to the physics thread
+	uint32 InputVersion = 0;
+
 };
@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "HandSocketRegistrySubsystem.generated.h"
+
+class UHandSocketComponent;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogVRHandSocketRegistry, Log, All);
+//For UE4 Profiler ~ Stat Group
+DECLARE_STATS_GROUP(TEXT("HandSocketRegistry"), STATGROUP_HandSocketRegistry, STATCAT_Advanced);
+
+// A single hand socket stored in a grid cell, location is cached so that queries don't touch the component
+// The registry isn't visible to the GC so the socket is held weakly and resolved when queried
+struct FHandSocketRegistryCellEntry
+{
+	TWeakObjectPtr<UHandSocketComponent> HandSocket;
+	FVector Location;
+
+	FHandSocketRegistryCellEntry() :
+		HandSocket(nullptr),
+		Location(FVector::ZeroVector)
+	{}
+
+	FHandSocketRegistryCellEntry(UHandSocketComponent* InHandSocket, const FVector& InLocation) :
+		HandSocket(InHandSocket),
+		Location(InLocation)
+	{}
+
+	// Matches even if the socket is already being destroyed (unregistering) and no longer resolves
+	bool IsFor(UHandSocketComponent* InHandSocket) const
+	{
+		return HandSocket.HasSameIndexAndSerialNumber(TWeakObjectPtr<UHandSocketComponent>(InHandSocket));
+	}
+};
+
+/**
+* Per world index of the registered hand sockets.
+* Sockets are bucketed into a uniform grid by their world location so that range queries only
+* need to walk the cells that overlap the search sphere instead of every hand socket in the process.
+* Hand socket components register themselves in OnRegister and remove themselves in OnUnregister,
+* their cell is updated whenever their transform updates.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UHandSocketRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UHandSocketRegistrySubsystem() :
+		Super()
+	{
+		CellSize = 200.0f;
+	}
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Adds the hand socket to the index, if it is already registered its location is refreshed instead
+	void RegisterHandSocket(UHandSocketComponent* HandSocket);
+
+	// Removes the hand socket from the index
+	void UnregisterHandSocket(UHandSocketComponent* HandSocket);
+
+	// Updates the cached location of the hand socket, moves it to a new cell if it crossed a cell boundary
+	void UpdateHandSocket(UHandSocketComponent* HandSocket);
+
+	bool IsHandSocketRegistered(const UHandSocketComponent* HandSocket) const
+	{
+		return SocketCells.Contains(TObjectKey<UHandSocketComponent>(HandSocket));
+	}
+
+	int32 GetNumRegisteredHandSockets() const
+	{
+		return SocketCells.Num();
+	}
+
+	// Appends all registered hand sockets
+	void GetAllHandSockets(TArray<UHandSocketComponent*>& OutHandSockets) const;
+
+	// Appends all registered hand sockets within SearchRange of the location, returns true if any were found
+	bool GetHandSocketsInRange(const FVector& SearchFromWorldLocation, float SearchRange, TArray<UHandSocketComponent*>& OutHandSockets) const;
+
+	// Returns the closest registered hand socket within SearchRange of the location and its squared distance
+	UHandSocketComponent* GetClosestHandSocketInRange(const FVector& SearchFromWorldLocation, float SearchRange, float& OutDistSq) const;
+
+	// The location that the hand socket is indexed and queried by
+	static FVector GetHandSocketQueryLocation(const UHandSocketComponent* HandSocket);
+
+private:
+
+	FIntVector GetCellForLocation(const FVector& Location) const;
+
+	// Calls the functor for every cell entry that could be within SearchRange of the location
+	template<typename FuncType>
+	void ForEachEntryInRange(const FVector& SearchFromWorldLocation, float SearchRange, FuncType&& Func) const;
+
+	void RemoveFromCell(UHandSocketComponent* HandSocket, const FIntVector& Cell);
+
+	// Edge length of the grid cells in world units, read from vr.HandSocketRegistry.CellSize on initialize
+	float CellSize;
+
+	// Grid cells keyed by their integer cell coordinates
+	TMap<FIntVector, TArray<FHandSocketRegistryCellEntry>> Cells;
+
+	// The cell that each registered socket currently lives in
+	TMap<TObjectKey<UHandSocketComponent>, FIntVector> SocketCells;
+};
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+
+#include "VRGripUpdateSubsystem.generated.h"
+
+class UGripMotionControllerComponent;
+class UVRGripUpdateSubsystem;
+
+//For UE4 Profiler ~ Stat Group
+DECLARE_STATS_GROUP(TEXT("VRGripUpdate"), STATGROUP_VRGripUpdate, STATCAT_Advanced);
+
+/**
+* Tick function that runs the batched grip update after all of the registered controllers have ticked
+**/
+USTRUCT()
+struct FVRGripUpdateTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+		UVRGripUpdateSubsystem* Target;
+
+	virtual void ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRGripUpdateTickFunction> : public TStructOpsTypeTraitsBase2<FVRGripUpdateTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// A controller that deferred its grip processing to the batched update this frame
+struct FVRQueuedGripUpdate
+{
+	TWeakObjectPtr<UGripMotionControllerComponent> Controller;
+	float DeltaTime;
+
+	FVRQueuedGripUpdate() :
+		DeltaTime(0.0f)
+	{}
+
+	FVRQueuedGripUpdate(UGripMotionControllerComponent* InController, float InDeltaTime) :
+		Controller(InController),
+		DeltaTime(InDeltaTime)
+	{}
+};
+
+/**
+* Opt in (vr.BatchedGripUpdates) batched grip processing for every grip motion controller in the world.
+* Controllers queue themselves here instead of running TickGrip in their own tick, then once all of them have ticked this:
+*	1. Gathers the grips whose grip scripts are flagged bCanRunWorldTransformInParallel (game thread)
+*	2. Runs those scripts world transform logic for each controller in parallel on task graph workers
+*	3. Runs each controllers TickGrip in a stable order, which applies the transforms and updates physics handles serially
+* All of the grip transforms are computed before any are applied, so a grip script that depends on another grips applied
+* result this frame should not be flagged as parallel safe.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRGripUpdateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UVRGripUpdateSubsystem() :
+		Super()
+	{
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+	}
+
+	virtual void Deinitialize() override;
+
+	// If the batched grip update is turned on
+	static bool IsBatchingEnabled();
+
+	// Controllers register when they begin play so that the batched update can be made to tick after them
+	void RegisterController(UGripMotionControllerComponent* Controller);
+	void UnregisterController(UGripMotionControllerComponent* Controller);
+
+	// Defers the controllers TickGrip to the batched update, returns false if it should tick its grips itself
+	bool QueueGripUpdate(UGripMotionControllerComponent* Controller, float DeltaTime);
+
+	// Runs the queued grip updates
+	void UpdateQueuedGrips();
+
+private:
+
+	FVRGripUpdateTickFunction GripUpdateTickFunction;
+
+	TArray<TWeakObjectPtr<UGripMotionControllerComponent>> RegisteredControllers;
+	TArray<FVRQueuedGripUpdate> QueuedUpdates;
+};
@@ -4,6 +4,8 @@
 #include "Components/ActorComponent.h"
 #include "Containers/Queue.h"
 #include "Iris/Serialization/NetSerializer.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "VRRenderTargetManager.generated.h"
 
 class UVRRenderTargetManager;
@@ -16,9 +18,6 @@ class FRenderCommandFence;
 enum EPixelFormat : uint8;
 
 
-// #TODO: Dirty rects so don't have to send entire texture?
-
-
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
 struct VREXPANSIONPLUGIN_API FBPVRReplicatedTextureStore
 {
@@ -44,6 +43,23 @@ public:
 	UPROPERTY(Transient)
 		bool bIsZipped;
 
+	// Delta mode, if true then UnpackedData is a list of tile patches instead of the full image
+	// Layout is [NumTiles] [TileIndex * NumTiles] [565 pixels of each tile, clipped to the texture bounds]
+	// The delta info is sent along with InitTextureSend, it isn't part of the net serialization
+	UPROPERTY(Transient)
+		bool bIsDeltaPatch;
+
+	UPROPERTY(Transient)
+		uint32 TileSize;
+
+	// The texture version a client must already have for this patch to be valid
+	UPROPERTY(Transient)
+		uint32 BaseVersion;
+
+	// The texture version the client will be at after applying this
+	UPROPERTY(Transient)
+		uint32 Version;
+
 	//UPROPERTY()
 	//	bool bJPG;
 	//UPROPERTY(Transient)
@@ -54,6 +70,10 @@ public:
 		Width = 0;
 		Height = 0;
 		bIsZipped = false;
+		bIsDeltaPatch = false;
+		TileSize = 0;
+		BaseVersion = 0;
+		Version = 0;
 	}
 
 	void Reset()
@@ -64,6 +84,10 @@ public:
 		Height = 0;
 		PixelFormat = (EPixelFormat)0;
 		bIsZipped = false;
+		bIsDeltaPatch = false;
+		TileSize = 0;
+		BaseVersion = 0;
+		Version = 0;
 		//bJPG = false;
 	}
 
@@ -87,6 +111,9 @@ struct TStructOpsTypeTraits< FBPVRReplicatedTextureStore > : public TStructOpsTy
 	};
 };
 
+// A packed texture that is encoded once and then shared (read only) between every proxy that is sending it
+typedef TSharedPtr<const FBPVRReplicatedTextureStore, ESPMode::ThreadSafe> FBPVRSharedTextureStorePtr;
+
 
 USTRUCT()
 struct FRenderDataStore {
@@ -97,10 +124,71 @@ struct FRenderDataStore {
 	FIntPoint Size2D;
 	EPixelFormat PixelFormat;
 
+	// The area of the render target that was read back, full size unless this is a delta read
+	FIntRect ReadRect;
+
+	// Texture version at the time of the read and the per tile versions that went with it (delta mode only)
+	uint32 Version;
+	TArray<uint32> TileVersions;
+
+	// Clients synced at or after this version can be sent patches from this read
+	uint32 ReadBaseVersion;
+	bool bIsFullRead;
+
 	FRenderDataStore() {
+		Version = 0;
+		ReadBaseVersion = 0;
+		bIsFullRead = true;
 	}
 };
 
+// A finished read being converted / encoded on a worker thread, the results get sent out from the game thread
+struct FRenderTargetEncodeJob
+{
+	// Owned by the job
+	FRenderDataStore* ReadData = nullptr;
+
+	bool bIsDelta = false;
+	int32 TileSize = 0;
+	FIntPoint TileCount = FIntPoint::ZeroValue;
+
+	// What the dirty clients needed at the time the job was launched
+	bool bBuildKeyframe = false;
+	TArray<uint32> PatchBaseVersions;
+
+	// Outputs
+	FBPVRSharedTextureStorePtr Keyframe;
+	TMap<uint32, FBPVRSharedTextureStorePtr> Patches;
+
+	// Set when a newer read supersedes this one
+	std::atomic<bool> bCancelled = false;
+	UE::Tasks::TTask<void> Task;
+
+	~FRenderTargetEncodeJob()
+	{
+		delete ReadData;
+	}
+};
+
+// A received texture being unpacked / converted on a worker thread, uploaded to the render target from the game thread
+struct FRenderTargetDecodeJob
+{
+	FBPVRReplicatedTextureStore Store;
+
+	// Outputs, DestRect is the area of the texture the color data covers
+	TArray<FColor> ColorData;
+	FIntPoint TextureSize = FIntPoint::ZeroValue;
+	FIntRect DestRect;
+	bool bDecoded = false;
+
+	// Set when a full texture arrives and supersedes this one
+	std::atomic<bool> bCancelled = false;
+	UE::Tasks::TTask<void> Task;
+};
+
+typedef TSharedPtr<FRenderTargetEncodeJob, ESPMode::ThreadSafe> FRenderTargetEncodeJobPtr;
+typedef TSharedPtr<FRenderTargetDecodeJob, ESPMode::ThreadSafe> FRenderTargetDecodeJobPtr;
+
 UENUM(BlueprintType)
 enum class ERenderManagerOperationType : uint8
 {
@@ -193,14 +281,24 @@ public:
 	UFUNCTION()
 		void OnRep_Manager();
 
+	// Client side receive buffer for the texture being sent to us
 	UPROPERTY(Transient)
 	FBPVRReplicatedTextureStore TextureStore;
+
+	// Server side, the packed texture that we are sending, BlobNum is our cursor into it
+	FBPVRSharedTextureStorePtr OutgoingTextureStore;
+
+	// Reused for slicing blobs out of the outgoing texture so that we aren't allocating per blob
+	TArray<uint8> BlobScratch;
 	
 	UPROPERTY(Transient)
 		int32 BlobNum;
 
 	bool bWaitingForManager;
 
+	// Starts sending the shared texture to our owning client, replaces any send that was in progress
+	void SendTexture(const FBPVRSharedTextureStorePtr& InTextureStore);
+
 	void SendInitMessage();
 
 	UFUNCTION()
@@ -225,8 +323,15 @@ public:
 	UFUNCTION(Reliable, Server, WithValidation)
 		void SendLocalDrawOperations(const TArray<FRenderManagerOperation>& LocalRenderOperationStoreList);
 
+	// Texture version being sent to the owning client, synced to the manager once the client acks the final blob
+	uint32 PendingTextureVersion;
+
 	UFUNCTION(Reliable, Client)
-		void InitTextureSend(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/);
+		void InitTextureSend(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped, bool bIsDeltaPatch, int32 TileSize, int32 BaseVersion, int32 Version/*, bool bIsJPG*/);
+
+	// Sent by the client when it was given a delta patch that doesn't apply to the texture it has
+	UFUNCTION(Reliable, Server, WithValidation)
+		void RequestTextureKeyframe();
 
 	UFUNCTION(Reliable, Server, WithValidation)
 		void Ack_InitTextureSend(int32 TotalDataCount);
@@ -260,12 +365,17 @@ struct FClientRepData {
 	UPROPERTY()
 		bool bIsDirty;
 
+	// Last texture version the client confirmed receiving, 0 if it has never had a full keyframe
+	UPROPERTY()
+		uint32 SyncedTextureVersion;
+
 	FClientRepData() 
 	{
 		PC = nullptr;
 		ReplicationProxy = nullptr;
 		bIsRelevant = false;
 		bIsDirty = false;
+		SyncedTextureVersion = 0;
 	}
 };
 
@@ -325,6 +435,26 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager")
 		bool bInitiallyReplicateTexture;
 
+	// If true then clients that already have a copy of the texture are only sent the tiles that were drawn to since
+	// they last synced instead of the entire texture. Clients that have never synced still get a full keyframe.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager", meta = (EditCondition = "bInitiallyReplicateTexture"))
+		bool bUseDeltaTextureReplication;
+
+	// Size in pixels of the tiles that drawing is tracked in for delta replication
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager", meta = (EditCondition = "bUseDeltaTextureReplication", ClampMin = "32", UIMin = "32"))
+		int32 DeltaTileSize;
+
+	// Current texture version, bumped every time draw operations are applied on the server
+	uint32 TextureVersion;
+
+	// Texture version that each tile was last drawn to in
+	TArray<uint32> TileVersions;
+	FIntPoint TileCount;
+	int32 TrackedTileSize;
+
+	// Clients only, the texture version that we last received from the server
+	uint32 AppliedTextureVersion;
+
 	UPROPERTY(Transient)
 		bool bIsLoadingTextureBuffer;
 
@@ -378,6 +508,33 @@ public:
 	// Queues storing the render target image to our buffer
 	void QueueImageStore();
 
+	// Delta replication helpers
+	void InitTileTracking();
+	void MarkOperationDirty(const FRenderManagerOperation& Operation);
+	void MarkRegionDirty(const FBox2D& Region);
+	bool GetDirtyTileRect(uint32 SinceVersion, FIntRect& OutRect) const;
+	static void BuildTexturePatch(const FRenderDataStore& ReadData, int32 TrackedTileSize, FIntPoint TileCount, uint32 BaseVersion, FBPVRReplicatedTextureStore& OutPatch);
+
+	// Sends keyframes / patches from a finished encode to the dirty clients, returns true if some clients need a larger read
+	bool SendTextureUpdates(const FRenderTargetEncodeJob& Job);
+
+	// Async texture pipeline, render thread read -> worker thread convert / encode -> game thread publish
+	void LaunchEncodeJob(FRenderDataStore* ReadData);
+	static void EncodeTexturePayloads(FRenderTargetEncodeJob& Job);
+	void PublishEncodedTextures();
+
+	static bool DecodeTexturePayload(FRenderTargetDecodeJob& Job);
+	void PublishDecodedTextures();
+
+	// Clients only, the newest texture version we have applied or are in the middle of decoding
+	uint32 GetLatestTextureVersion() const;
+	void OnClientTextureSynced(ARenderTargetReplicationProxy* Proxy, uint32 Version);
+	void OnClientRequestedKeyframe(ARenderTargetReplicationProxy* Proxy);
+
+	// Uploads the color data to a transient texture and draws it to the render target
+	// If not opaque then pixels with zero alpha leave the render target untouched
+	void DrawColorDataToRenderTarget(const TArray<FColor>& ColorData, FIntPoint TextureSize, FVector2D DestPosition, FVector2D DestSize, bool bOpaque);
+
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -385,6 +542,13 @@ public:
 protected:
 	TQueue<FRenderDataStore *> RenderDataQueue;
 
+	// Bounded so that a slow worker can't pile up full texture copies
+	static constexpr int32 MaxPendingEncodeJobs = 2;
+	static constexpr int32 MaxPendingDecodeJobs = 4;
+
+	TArray<FRenderTargetEncodeJobPtr> EncodeJobs;
+	TArray<FRenderTargetDecodeJobPtr> DecodeJobs;
+
 };
 
 
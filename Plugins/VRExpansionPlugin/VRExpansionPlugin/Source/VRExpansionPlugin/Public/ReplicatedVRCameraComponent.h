@@ -33,7 +33,7 @@ public:
 	virtual void OnAttachmentChanged() override;
 
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
-	//virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
 
 	/** Whether or not this component has authority within the frame*/
 	bool bHasAuthority;
@@ -138,8 +138,23 @@ public:
 		float NetworkMaxSmoothUpdateDistance = 50.f;
 
 	// Max distance to allow smoothing before snapping entirely to the new position
-	UPROPERTY(EditAnywhere, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bUseExponentialSmoothing"))
+	UPROPERTY(EditAnywhere, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bUseExponentialSmoothing || bUseSnapshotInterpolation"))
 		float NetworkNoSmoothUpdateDistance = 100.f;
+
+	// If true then received poses are buffered and played back SnapshotInterpolationDelay behind, overrides the lerp / exponential smoothing
+	// Covers late and lost packets so lower NetUpdateRates don't stutter, at the cost of the added delay
+	UPROPERTY(EditAnywhere, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bSmoothReplicatedMotion"))
+		bool bUseSnapshotInterpolation = false;
+
+	// How far behind the newest received pose to render, should be a bit over one send interval
+	UPROPERTY(EditAnywhere, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0", UIMin = "0"))
+		float SnapshotInterpolationDelay = 0.05f;
+
+	// Max time to extrapolate past the newest pose if the buffer runs dry before holding position
+	UPROPERTY(EditAnywhere, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0", UIMin = "0"))
+		float SnapshotMaxExtrapolationTime = 0.1f;
+
+	FVRTrackedPoseSnapshotBuffer PoseSnapshotBuffer;
 	
 	UFUNCTION()
     virtual void OnRep_ReplicatedCameraTransform();
@@ -154,6 +169,11 @@ public:
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case.
 	float NetUpdateCount;
 
+	// Scales the send rate between a minimum and NetUpdateRate by how fast the HMD is moving
+	// Best paired with snapshot interpolation on the receiving end as the time between updates will vary
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ReplicatedCamera|Networking")
+		FBPVRAdaptiveNetUpdateSettings AdaptiveNetUpdateSettings;
+
 	float GetNetUpdateRate() { return NetUpdateRate; }
 	void SetNetUpdateRate(float NewNetUpdateRate);
 
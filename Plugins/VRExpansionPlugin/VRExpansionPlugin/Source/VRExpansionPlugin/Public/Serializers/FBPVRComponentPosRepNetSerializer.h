@@ -5,6 +5,9 @@
 
 #include "FBPVRComponentPosRepNetSerializer.generated.h"
 
+//For UE4 Profiler ~ Stat Group
+DECLARE_STATS_GROUP(TEXT("VRNetSerializers"), STATGROUP_VRNetSerializers, STATCAT_Advanced);
+
 USTRUCT()
 struct FBPVRComponentPosRepNetSerializerConfig : public FNetSerializerConfig
 {
@@ -14,4 +17,15 @@ struct FBPVRComponentPosRepNetSerializerConfig : public FNetSerializerConfig
 namespace UE::Net
 {
     UE_NET_DECLARE_SERIALIZER(FBPVRComponentPosRepNetSerializer, VREXPANSIONPLUGIN_API);
+
+    // Position is stored as fixed point integers instead of forwarding to the packed vector serializers so that
+    // we can write residuals against the acked state, rotation is stored as the already compressed axis values.
+    struct alignas(8) FBPVRComponentPosRepQuantizedData
+    {
+        int32 Position[3];
+        uint16 Rotation[3];
+
+        uint8 QuantizationLevel : 1;
+        uint8 RotationQuantizationLevel : 1;
+    };
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Iris/Serialization/NetSerializer.h"
+#include "VRBPDatatypes.h"
+
+#include "FVRTrackedPoseBundleNetSerializer.generated.h"
+
+USTRUCT()
+struct FVRTrackedPoseBundleNetSerializerConfig : public FNetSerializerConfig
+{
+    GENERATED_BODY()
+};
+
+namespace UE::Net
+{
+    UE_NET_DECLARE_SERIALIZER(FVRTrackedPoseBundleNetSerializer, VREXPANSIONPLUGIN_API);
+}
@@ -3,6 +3,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Engine/NetSerialization.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "PhysicsPublic.h"
 //#include "EngineMinimal.h"
 //#include "Components/PrimitiveComponent.h"
@@ -919,6 +920,129 @@ struct TStructOpsTypeTraits< FBPVRComponentPosRep > : public TStructOpsTypeTrait
 	};
 };
 
+// Settings for scaling a tracked devices send rate by how fast it is moving
+// Idle devices drop towards MinNetUpdateRate, anything moving at or above the full rate speeds sends at the components full rate
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FBPVRAdaptiveNetUpdateSettings
+{
+	GENERATED_BODY()
+public:
+
+	FBPVRAdaptiveNetUpdateSettings() :
+		bUseAdaptiveNetUpdateRate(false),
+		MinNetUpdateRate(5.0f),
+		FullRateLinearSpeed(100.0f),
+		FullRateAngularSpeed(180.0f)
+	{}
+
+	// If true the send rate scales with how fast the pose is changing
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdaptiveNetUpdate")
+		bool bUseAdaptiveNetUpdateRate;
+
+	// Send rate when the device is still
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdateRate", ClampMin = "0.1", UIMin = "0.1"))
+		float MinNetUpdateRate;
+
+	// Linear speed (cm/s) at which we send at the full rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdateRate", ClampMin = "0.1", UIMin = "0.1"))
+		float FullRateLinearSpeed;
+
+	// Angular speed (deg/s) on any axis at which we send at the full rate
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdaptiveNetUpdate", meta = (editcondition = "bUseAdaptiveNetUpdateRate", ClampMin = "0.1", UIMin = "0.1"))
+		float FullRateAngularSpeed;
+
+	// Returns the rate to send at given the change in pose since the last send and the time it took
+	float GetNetUpdateRate(float FullNetUpdateRate, const FVector& PositionDelta, const FRotator& RotationDelta, float TimeSinceLastSend) const;
+};
+
+//For UE4 Profiler ~ Stat Group
+DECLARE_STATS_GROUP(TEXT("VRNetSmoothing"), STATGROUP_VRNetSmoothing, STATCAT_Advanced);
+
+// A small jitter buffer of received tracked device poses for remote controllers / cameras
+// Poses are stamped on the senders average cadence (re-anchored to the arrival time if it drifts too far) and sampled
+// at a delay behind the newest one so that late or lost packets can be covered, if the buffer runs dry it extrapolates
+// from the last velocity instead.
+struct VREXPANSIONPLUGIN_API FVRTrackedPoseSnapshotBuffer
+{
+	struct FSnapshot
+	{
+		double Time;
+		FVector Position;
+		FQuat Rotation;
+	};
+
+	// At 100htz this is 160ms of history, far more than any sane delay
+	static constexpr int32 MaxSnapshots = 16;
+
+	// Smallest spacing used between snapshots, keeps the velocities sane when several poses land together
+	static constexpr double MinSnapshotInterval = 1.0 / 240.0;
+
+	FVRTrackedPoseSnapshotBuffer() :
+		LastArrivalTime(0.0),
+		AverageInterval(0.0),
+		Head(0),
+		Num(0),
+		NumSamples(0),
+		NumUnderruns(0)
+	{}
+
+	void Reset()
+	{
+		Head = 0;
+		Num = 0;
+	}
+
+	bool IsEmpty() const
+	{
+		return Num < 1;
+	}
+
+	// Adds a newly received pose, overwrites the oldest if the ring is full
+	// NominalInterval is the expected time between sends (1 / NetUpdateRate) and seeds the cadence estimate
+	void AddSnapshot(double ArrivalTime, float NominalInterval, const FVector& Position, const FRotator& Rotation);
+
+	// Time of the newest snapshot, only valid if the buffer isn't empty
+	double GetNewestTime() const
+	{
+		return GetSnapshot(Num - 1).Time;
+	}
+
+	// Samples the buffer at RenderTime, hermite interpolating between snapshots.
+	// Returns false if RenderTime was past the newest snapshot and the pose was extrapolated (an underrun).
+	bool Sample(double RenderTime, float MaxExtrapolationTime, FVector& OutPosition, FQuat& OutRotation);
+
+	// Fraction of the samples since the last reset of the counters that had to extrapolate
+	float GetUnderrunRate() const
+	{
+		return NumSamples > 0 ? (float)NumUnderruns / (float)NumSamples : 0.0f;
+	}
+
+	void ResetUnderrunCounters()
+	{
+		NumSamples = 0;
+		NumUnderruns = 0;
+	}
+
+private:
+
+	// Index 0 is the oldest snapshot
+	const FSnapshot& GetSnapshot(int32 Index) const
+	{
+		return Snapshots[(Head + Index) % MaxSnapshots];
+	}
+
+	FVector GetTangent(int32 Index) const;
+
+	FSnapshot Snapshots[MaxSnapshots];
+	double LastArrivalTime;
+	double AverageInterval;
+	int32 Head;
+	int32 Num;
+
+	uint32 NumSamples;
+	uint32 NumUnderruns;
+};
+
 UENUM(Blueprintable)
 enum class EGripCollisionType : uint8
 {
@@ -1282,6 +1406,21 @@ public:
 		bDisallowLerping(0),
 		bDisallowSettingPositionOnClientAuthDrop(0)
 	{}
+
+	FORCEINLINE bool operator==(const FBPAdvGripSettings &Other) const
+	{
+		return (GripPriority == Other.GripPriority &&
+			bSetOwnerOnGrip == Other.bSetOwnerOnGrip &&
+			bDisallowLerping == Other.bDisallowLerping &&
+			bDisallowSettingPositionOnClientAuthDrop == Other.bDisallowSettingPositionOnClientAuthDrop &&
+			PhysicsSettings == Other.PhysicsSettings
+			);
+	}
+
+	FORCEINLINE bool operator!=(const FBPAdvGripSettings &Other) const
+	{
+		return !(*this == Other);
+	}
 };
 
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
@@ -1403,7 +1542,7 @@ struct TStructOpsTypeTraits< FBPSecondaryGripInfo > : public TStructOpsTypeTrait
 #define INVALID_VRGRIP_ID 0
 
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
-struct VREXPANSIONPLUGIN_API FBPActorGripInformation
+struct VREXPANSIONPLUGIN_API FBPActorGripInformation : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 public:
@@ -1582,6 +1721,14 @@ public:
 		return *this;
 	}
 
+	// Returns true if any of the replicated members differ from Other, used to only mark changed grips dirty for delta replication
+	bool HasReplicatedChanges(const FBPActorGripInformation& Other) const;
+
+	// Fast array callbacks, these forward to the owning controller of the grip array
+	void PreReplicatedRemove(const struct FBPGripArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FBPGripArray& InArraySerializer);
+	void PostReplicatedChange(const struct FBPGripArray& InArraySerializer);
+
 
 	AActor* GetGrippedActor() const;
 
@@ -1663,6 +1810,102 @@ public:
 
 };
 
+// Replicated grip array, only grips that have actually changed are sent instead of the full array
+// Use the grip functions on the controller to add or remove grips, the server marks changed entries itself
+// on pre replication by diffing against what was last sent.
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FBPGripArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "GripArray")
+		TArray<FBPActorGripInformation> Grips;
+
+	// Controller that owns this array, receives the fast array callbacks
+	UGripMotionControllerComponent* Owner;
+
+	// Last replicated state of each grip by GripID, what was last sent on the server and last received on clients
+	// Reflected so that the objects they reference are kept alive for the grip callbacks that are passed them
+	UPROPERTY(NotReplicated, Transient)
+		TMap<uint8, FBPActorGripInformation> GripSnapshots;
+
+	FBPGripArray() :
+		Owner(nullptr)
+	{}
+
+	// Don't take the owner or snapshots from the source, archetype copies would otherwise point at the template
+	FBPGripArray(const FBPGripArray& Other) :
+		FFastArraySerializer(),
+		Grips(Other.Grips),
+		Owner(nullptr)
+	{}
+
+	FBPGripArray& operator=(const FBPGripArray& Other)
+	{
+		if (this != &Other)
+		{
+			Grips = Other.Grips;
+			MarkArrayDirty();
+		}
+
+		return *this;
+	}
+
+	// Compares the grips against the snapshots and marks only the changed ones for replication
+	// Returns true if anything needs to be sent
+	bool MarkChangedGripsDirty();
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FBPActorGripInformation, FBPGripArray>(Grips, DeltaParms, *this);
+	}
+
+	// TArray style accessors so existing code can use this like the old grip arrays
+	FORCEINLINE int32 Num() const { return Grips.Num(); }
+	FORCEINLINE FBPActorGripInformation& operator[](int32 Index) { return Grips[Index]; }
+	FORCEINLINE const FBPActorGripInformation& operator[](int32 Index) const { return Grips[Index]; }
+
+	FORCEINLINE auto begin() { return Grips.begin(); }
+	FORCEINLINE auto end() { return Grips.end(); }
+	FORCEINLINE auto begin() const { return Grips.begin(); }
+	FORCEINLINE auto end() const { return Grips.end(); }
+
+	int32 Add(const FBPActorGripInformation& NewGrip)
+	{
+		int32 Index = Grips.Add(NewGrip);
+
+		// Copies of other grips carry their replication ID, this is a new entry
+		Grips[Index].ReplicationID = INDEX_NONE;
+		Grips[Index].ReplicationKey = INDEX_NONE;
+		return Index;
+	}
+
+	FORCEINLINE void RemoveAt(int32 Index) { Grips.RemoveAt(Index); }
+	FORCEINLINE void Empty() { Grips.Empty(); }
+
+	template<typename KeyType>
+	FORCEINLINE bool Contains(const KeyType& Key) const { return Grips.Contains(Key); }
+
+	template<typename KeyType>
+	FORCEINLINE int32 Find(const KeyType& Key) const { return Grips.Find(Key); }
+
+	template<typename KeyType>
+	FORCEINLINE bool Find(const KeyType& Key, int32& Index) const { return Grips.Find(Key, Index); }
+
+	template<typename KeyType>
+	FORCEINLINE int32 IndexOfByKey(const KeyType& Key) const { return Grips.IndexOfByKey(Key); }
+};
+
+template<>
+struct TStructOpsTypeTraits< FBPGripArray > : public TStructOpsTypeTraitsBase2<FBPGripArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
+};
+
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
 struct VREXPANSIONPLUGIN_API FBPGripPair
 {
@@ -13,6 +13,7 @@
 #include "VRBaseCharacter.generated.h"
 
 class AVRPlayerController;
+class AVRBaseCharacter;
 class UGripMotionControllerComponent;
 class UParentRelativeAttachmentComponent;
 class AController;
@@ -211,6 +212,110 @@ struct TStructOpsTypeTraits< FVRReplicatedCapsuleHeight > : public TStructOpsTyp
 	};
 };
 
+// Bits for the tracked devices contained in an FVRTrackedPoseBundle
+namespace EVRTrackedPoseBundleFlags
+{
+	enum Type : uint8
+	{
+		None = 0x00,
+		Camera = 0x01,
+		LeftController = 0x02,
+		RightController = 0x04,
+		All = Camera | LeftController | RightController
+	};
+}
+
+// The HMD and controller poses that changed since the last send, packed into a single server RPC
+// Only the poses flagged in the PresenceMask are serialized, each one uses the FBPVRComponentPosRep quantization
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRTrackedPoseBundle
+{
+	GENERATED_USTRUCT_BODY()
+public:
+	UPROPERTY(Transient)
+		uint8 PresenceMask;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep CameraPose;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep LeftControllerPose;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep RightControllerPose;
+
+	FVRTrackedPoseBundle() :
+		PresenceMask(EVRTrackedPoseBundleFlags::None)
+	{}
+
+	FORCEINLINE bool HasPose(EVRTrackedPoseBundleFlags::Type Flag) const
+	{
+		return (PresenceMask & Flag) != 0;
+	}
+
+	/** Network serialization */
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+	{
+		bOutSuccess = true;
+
+		// 3 bits covers all of the devices
+		Ar.SerializeBits(&PresenceMask, 3);
+
+		bool bPoseSuccess = true;
+		if (HasPose(EVRTrackedPoseBundleFlags::Camera))
+		{
+			CameraPose.NetSerialize(Ar, Map, bPoseSuccess);
+			bOutSuccess &= bPoseSuccess;
+		}
+
+		if (HasPose(EVRTrackedPoseBundleFlags::LeftController))
+		{
+			LeftControllerPose.NetSerialize(Ar, Map, bPoseSuccess);
+			bOutSuccess &= bPoseSuccess;
+		}
+
+		if (HasPose(EVRTrackedPoseBundleFlags::RightController))
+		{
+			RightControllerPose.NetSerialize(Ar, Map, bPoseSuccess);
+			bOutSuccess &= bPoseSuccess;
+		}
+
+		return bOutSuccess;
+	}
+};
+template<>
+struct TStructOpsTypeTraits< FVRTrackedPoseBundle > : public TStructOpsTypeTraitsBase2<FVRTrackedPoseBundle>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+/**
+* Tick function that sends the bundled tracked poses once all of the tracked devices have updated for the frame
+**/
+USTRUCT()
+struct FVRTrackedPoseBundleTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+		AVRBaseCharacter* Target;
+
+	virtual void ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRTrackedPoseBundleTickFunction> : public TStructOpsTypeTraitsBase2<FVRTrackedPoseBundleTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
 UCLASS()
 class VREXPANSIONPLUGIN_API AVRBaseCharacter : public ACharacter
 {
@@ -274,7 +379,70 @@ public:
 	UFUNCTION(Unreliable, Server, WithValidation)
 		void Server_SendTransformRightController(FBPVRComponentPosRep NewTransform);
 
+	// If true the HMD and controller transforms are gathered up and sent in a single RPC per frame instead of one per device
+	// Saves the per RPC overhead on both the client uplink and the server. Only the owning clients value matters, the server accepts either RPC
+	UPROPERTY(Category = "VRBaseCharacter|Networking", EditAnywhere, BlueprintReadWrite)
+		bool bBundleTrackedPoseRPCs;
+
+	UFUNCTION(Unreliable, Server, WithValidation)
+		void Server_SendTrackedPoseBundle(FVRTrackedPoseBundle PoseBundle);
+
+	// These are what the tracked components call through their OverrideSendTransform pointer
+	// They queue into the bundle when bundling is enabled, otherwise they call the matching Server_SendTransform* RPC
+	void SendTransformCamera(FBPVRComponentPosRep NewTransform);
+	void SendTransformLeftController(FBPVRComponentPosRep NewTransform);
+	void SendTransformRightController(FBPVRComponentPosRep NewTransform);
+
+	// Adds the pose to this frames bundle, newer poses for the same device overwrite older ones
+	void QueueTrackedPose(EVRTrackedPoseBundleFlags::Type Device, const FBPVRComponentPosRep& NewTransform);
+
+	// Sends the pending bundle if there is anything in it, called from the bundle tick function
+	void FlushTrackedPoseBundle();
+
+	FVRTrackedPoseBundleTickFunction TrackedPoseBundleTickFunction;
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+
+protected:
+	FVRTrackedPoseBundle PendingPoseBundle;
+public:
+
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget, UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+
+	// Server side, if true the tracked device poses (HMD / controllers) replicate out less often when this character is far away from
+	// or behind every other player, the rate is driven by whichever viewer needs it the most
+	UPROPERTY(Category = "VRBaseCharacter|Networking", EditAnywhere, BlueprintReadWrite)
+		bool bThrottleTrackedPoseReplication;
+
+	// Viewers within this distance get every update
+	UPROPERTY(Category = "VRBaseCharacter|Networking", EditAnywhere, BlueprintReadWrite, meta = (editcondition = "bThrottleTrackedPoseReplication", ClampMin = "0", UIMin = "0"))
+		float TrackedPoseFullRateDistance;
+
+	// Viewers at or beyond this distance get TrackedPoseMinReplicationRate
+	UPROPERTY(Category = "VRBaseCharacter|Networking", EditAnywhere, BlueprintReadWrite, meta = (editcondition = "bThrottleTrackedPoseReplication", ClampMin = "0", UIMin = "0"))
+		float TrackedPoseMinRateDistance;
+
+	// Lowest rate the tracked poses will replicate out at
+	UPROPERTY(Category = "VRBaseCharacter|Networking", EditAnywhere, BlueprintReadWrite, meta = (editcondition = "bThrottleTrackedPoseReplication", ClampMin = "0.1", UIMin = "0.1"))
+		float TrackedPoseMinReplicationRate;
+
+	// Viewers facing away from us have their distance scaled by this
+	UPROPERTY(Category = "VRBaseCharacter|Networking", EditAnywhere, BlueprintReadWrite, meta = (editcondition = "bThrottleTrackedPoseReplication", ClampMin = "1", UIMin = "1"))
+		float TrackedPoseOutOfViewDistanceScale;
+
+	// 0 means a viewer at this location needs the full rate, 1 means the min rate
+	float GetTrackedPoseThrottleAlpha(const FVector& ViewLocation, const FVector& ViewDirection) const;
+
+	// Whether the tracked device components should replicate their poses this net update
+	bool ShouldReplicateTrackedPoses() const
+	{
+		return bReplicateTrackedPosesThisUpdate;
+	}
+
+protected:
+	bool bReplicateTrackedPosesThisUpdate;
+	double LastTrackedPoseReplicationTime;
+public:
 
 protected:
 	// If true will replicate the capsule height on to clients, allows for dynamic capsule height changes in multiplayer
@@ -192,6 +192,12 @@ public:
 	UFUNCTION(BlueprintPure, Category = "VRGrip", meta = (bIgnoreSelf = "true", DisplayName = "GetGripSlotInRangeByTypeName_Component"))
 	static void GetGripSlotInRangeByTypeName_Component(FName SlotType, USceneComponent * Component, FVector WorldLocation, float MaxRange, bool & bHadSlotInRange, FTransform & SlotWorldTransform, FName & SlotName, UGripMotionControllerComponent* QueryController = nullptr);
 
+	// The slot lookups cache which sockets / hand sockets match each slot type per component, the cache is rebuilt automatically
+	// when the mesh or attached hand sockets change. Call this if you modify the sockets on a mesh asset at runtime.
+	// Passing in no component clears the entire cache.
+	UFUNCTION(BlueprintCallable, Category = "VRGrip", meta = (bIgnoreSelf = "true", DisplayName = "InvalidateGripSlotCache"))
+	static void InvalidateGripSlotCache(USceneComponent * Component = nullptr);
+
 	/* Returns true if the values are equal (A == B) */
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Equal VR Grip", CompactNodeTitle = "==", Keywords = "== equal"), Category = "VRExpansionFunctions")
 	static bool EqualEqual_FBPActorGripInformation(const FBPActorGripInformation &A, const FBPActorGripInformation &B);
@@ -13,6 +13,7 @@
 #include "TimerManager.h"
 #include "VRGestureComponent.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogVRGestureComponent, Log, All);
 DECLARE_STATS_GROUP(TEXT("TICKGesture"), STATGROUP_TickGesture, STATCAT_Advanced);
 
 class USplineMeshComponent;
@@ -113,12 +114,72 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGesture")
 		FVRGestureSettings GestureSettings;
 
+	// Lower bound envelope of the samples, each entry bounds EnvelopeSegmentLength samples in order
+	// Not serialized, it is rebuilt whenever the gesture size is calculated or the database is loaded
+	// EnvelopeSamplesHash is the samples content hash it was built from, edits that keep the count still invalidate it
+	TArray<FBox> EnvelopeSegments;
+	int32 EnvelopeSampleCount;
+	uint32 EnvelopeSamplesHash;
+
+	static constexpr int32 EnvelopeSegmentLength = 4;
+
+	// Structure of arrays copy of the samples for the vectorized distance kernel, padded with zeros to a multiple of 4
+	// Not serialized, rebuilt alongside the envelope and validated against the same samples hash
+	TArray<float> PackedX;
+	TArray<float> PackedY;
+	TArray<float> PackedZ;
+	int32 PackedSampleCount;
+	uint32 PackedSamplesHash;
+
 	FVRGesture()
 	{
 		GestureType = 0;
 		GestureSize = FBox();
+		EnvelopeSampleCount = 0;
+		EnvelopeSamplesHash = 0;
+		PackedSampleCount = 0;
+		PackedSamplesHash = 0;
+	}
+
+	// Rebuilds the envelope and packed samples from the current samples
+	void RebuildCachedData()
+	{
+		CalculateEnvelope();
+		CalculatePackedSamples();
+	}
+
+	bool HasValidCachedData() const
+	{
+		return HasValidEnvelope() && HasValidPackedSamples();
+	}
+
+	// Content hash of the samples, used to tell if the cached data is stale
+	uint32 GetSamplesHash() const
+	{
+		return FCrc::MemCrc32(Samples.GetData(), Samples.Num() * sizeof(FVector));
+	}
+
+	// Rebuilds the envelope segments from the current samples
+	void CalculateEnvelope();
+
+	bool HasValidEnvelope() const
+	{
+		return EnvelopeSampleCount == Samples.Num() && EnvelopeSegments.Num() > 0 && EnvelopeSamplesHash == GetSamplesHash();
 	}
 
+	// Rebuilds the structure of arrays samples from the current samples
+	void CalculatePackedSamples();
+
+	bool HasValidPackedSamples() const
+	{
+		return PackedSampleCount == Samples.Num() && PackedX.Num() >= Samples.Num() && PackedSamplesHash == GetSamplesHash();
+	}
+
+	// Returns a lower bound of the DTW cost of this gesture against any input contained within InputBounds (already scaled)
+	// Every gesture sample has to be matched to at least one input sample, so the distance of each segment to the input bounds
+	// times the samples in it can never be more than the real cost.
+	float GetEnvelopeLowerBound(const FBox& InputBounds, bool bMirrorGesture = false) const;
+
 	void CalculateSizeOfGesture(bool bAllowResizing = false, float TargetExtentSize = 1.f)
 	{
 		FVector NewSample;
@@ -147,6 +208,8 @@ public:
 			GestureSize.Min *= Scaler;
 			GestureSize.Max *= Scaler;
 		}
+
+		RebuildCachedData();
 	}
 };
 
@@ -171,6 +234,12 @@ public:
 		TargetGestureScale = 100.0f;
 	}
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	// Recalculate size of gestures and re-scale them to the TargetGestureScale (if bScaleToDatabase is true)
 	UFUNCTION(BlueprintCallable, Category = "VRGestures")
 		void RecalculateGestures(bool bScaleToDatabase = true);
@@ -214,6 +283,39 @@ public:
 	~FVRGestureSplineDraw();
 };
 
+// Rolling DTW column for a single database gesture, sized to the gesture length + 1
+// Costs are accumulated with the gesture walked from its first to its last sample
+struct VREXPANSIONPLUGIN_API FVRGestureDTWColumn
+{
+	TArray<float> Cost;
+	TArray<int32> StartIndex;
+	TArray<int32> SlopeI;
+	TArray<int32> SlopeJ;
+
+	void Init(int32 GestureLength);
+	void Reset();
+};
+
+// Streaming DTW state for a single database gesture, only the last and current columns are ever kept
+struct VREXPANSIONPLUGIN_API FVRGestureStreamingState
+{
+	FVRGestureDTWColumn Columns[2];
+	FVRGestureDTWColumn MirroredColumns[2];
+	int32 CurrentColumn;
+	int32 GestureLength;
+	bool bHasMirroredState;
+
+	void Init(int32 InGestureLength, bool bInHasMirroredState);
+	void Reset();
+
+	FVRGestureStreamingState()
+	{
+		CurrentColumn = 0;
+		GestureLength = 0;
+		bHasMirroredState = false;
+	}
+};
+
 /** Delegate for notification when the lever state changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FiveParams(FVRGestureDetectedSignature, uint8, GestureType, FString, DetectedGestureName, int, DetectedGestureIndex, UGesturesDatabase *, GestureDataBase, FVector, OriginalUnscaledGestureSize);
 
@@ -302,6 +404,27 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
 	int maxSlope;
 
+	// If true detection keeps a rolling DTW column per database gesture and only updates it with each new sample
+	// instead of re-running the full DTW for every gesture on every detection tick.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
+		bool bUseStreamingRecognition;
+
+	// When streaming, the percentage the input scale can drift before the rolling columns are rebuilt from the sample buffer
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures", meta = (ClampMin = "0.0", ClampMax = "1.0", UIMin = "0.0", UIMax = "1.0", editcondition = "bUseStreamingRecognition"))
+		float StreamingRescaleTolerance;
+
+	// If true (and not streaming) database gestures are evaluated across task graph workers, the best match is still picked in database order
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
+		bool bUseParallelRecognition;
+
+	// Minimum number of database gestures before parallel evaluation is used, small databases are cheaper to run serially
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures", meta = (ClampMin = "1", UIMin = "1", editcondition = "bUseParallelRecognition"))
+		int ParallelRecognitionMinGestures;
+
+	// If true the full DTW computes the distances for an entire row at a time with SIMD against the packed gesture samples
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
+		bool bUseVectorizedDTW;
+
 	UPROPERTY(BlueprintReadOnly, Category = "VRGestures")
 	EVRGestureState CurrentState;
 
@@ -309,7 +432,7 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "VRGestures")
 	FVRGesture GestureLog;
 
-	inline float GetGestureDistance(FVector Seq1, FVector Seq2, bool bMirrorGesture = false)
+	inline float GetGestureDistance(FVector Seq1, FVector Seq2, bool bMirrorGesture = false) const
 	{
 		if (bMirrorGesture)
 		{
@@ -368,11 +491,66 @@ public:
 	// Recognize gesture in the given sequence.
 	// It will always assume that the gesture ends on the last observation of that sequence.
 	// If the distance between the last observations of each sequence is too great, or if the overall DTW distance between the two sequences is too great, no gesture will be recognized.
-	void RecognizeGesture(FVRGesture inputGesture);
+	void RecognizeGesture(const FVRGesture& inputGesture);
 
+	// Same as RecognizeGesture but only advances the rolling DTW columns by the newest sample in GestureLog
+	void RecognizeGestureStreaming();
 
 	// Compute the min DTW distance between seq2 and all possible endings of seq1.
-	float dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture = false, float Scaler = 1.f);
+	// Rows are abandoned once every path through them costs at least AbandonCost, in which case MAX_FLT is returned.
+	float dtw(const FVRGesture& seq1, const FVRGesture& seq2, bool bMirrorGesture = false, float Scaler = 1.f, float AbandonCost = MAX_FLT) const;
+
+	// Same as dtw but against pre-scaled (and pre-mirrored) input samples and the packed gesture samples
+	// Mirroring is symmetric so mirroring the input instead of the gesture gives the same distances
+	float dtwPacked(const TArray<FVector3f>& PreparedInput, const FVRGesture& seq2, float AbandonCost = MAX_FLT) const;
+
+	// Fills PreparedInput with the scaled / mirrored variants of the input samples
+	void PrepareInputVariants(const FVRGesture& inputGesture, float Scaler);
+
+	// Runs both the scalar and vectorized DTW of every gesture in the database against every other one and logs the timings
+	static void BenchmarkDTW(const UGesturesDatabase* GestureDB, int32 Iterations);
+
+	// Returns the normalized DTW distance of the example gesture if it is a match under AbandonDistance, MAX_FLT otherwise
+	float EvaluateGesture(const FVRGesture& inputGesture, const FVRGesture& exampleGesture, float Scaler, float AbandonDistance = MAX_FLT) const;
+
+	// Marks the streaming state to be rebuilt from the sample buffer on the next detection tick
+	void ResetStreamingRecognition() { bStreamingStateDirty = true; }
+
+private:
+
+	// Advances a rolling DTW column pair by one input sample, returns the cost of matching the full gesture ending on this sample
+	float StepStreamingDTW(FVRGestureDTWColumn (&Columns)[2], int32 CurrentColumn, const TArray<FVector>& GestureSamples, const FVector& ScaledSample, bool bMirrorGesture, int32 SampleIndex, int32 OldestValidIndex) const;
+
+	// Re-inits the streaming states to the current database and replays the sample buffer into them
+	void RebuildStreamingStates(float Scaler);
+
+	// Advances all of the streaming states by a single sample
+	void StepStreamingStates(const FVector& Sample, float Scaler, int32 SampleIndex, int32 OldestValidIndex);
+
+	bool IsPrimaryMirrored(const FVRGesture& Gesture) const
+	{
+		return (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == Gesture.GestureSettings.MirrorMode);
+	}
+
+	// Per database gesture rolling DTW state
+	TArray<FVRGestureStreamingState> StreamingStates;
+
+	// Last costs per database gesture of the full gesture ending on the newest sample
+	TArray<float> StreamingCosts;
+	TArray<float> StreamingMirroredCosts;
+
+	// Per gesture results for parallel recognition, reduced in order on the game thread
+	TArray<float> ParallelGestureResults;
+
+	// Input samples pre-scaled and mirrored for the vectorized DTW, indexed by (bScaled ? 1 : 0) | (bMirrored ? 2 : 0)
+	TArray<FVector3f> PreparedInput[4];
+
+	// Running index of samples fed into the streaming states
+	int32 StreamingSampleIndex;
+	float StreamingScaler;
+	EVRGestureMirrorMode StreamingMirroringHand;
+	TWeakObjectPtr<UGesturesDatabase> StreamingDB;
+	bool bStreamingStateDirty;
 
 };
 
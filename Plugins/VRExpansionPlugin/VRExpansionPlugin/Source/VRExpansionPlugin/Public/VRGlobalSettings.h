@@ -100,6 +100,11 @@ public:
 	UPROPERTY(config, BlueprintReadWrite, EditAnywhere, Category = "ChaosPhysics|CollisionIgnore")
 		float CollisionIgnoreSubsystemUpdateRate;
 
+	// If true we clean up pairs when their components physics state is destroyed instead of polling them on the update rate
+	// When using contact modification only the added / removed pairs are sent to the physics thread instead of the full set
+	UPROPERTY(config, BlueprintReadWrite, EditAnywhere, Category = "ChaosPhysics|CollisionIgnore")
+		bool bUseIncrementalCollisionIgnoreUpdates;
+
 	// Whether we should use the physx to chaos translation scalers or not
 	// This should be off on native chaos projects that have been set with the correct stiffness and damping settings already
 	UPROPERTY(config, BlueprintReadWrite, EditAnywhere, Category = "ChaosPhysics")
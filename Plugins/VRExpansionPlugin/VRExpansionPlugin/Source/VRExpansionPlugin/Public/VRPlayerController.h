@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/LocalPlayer.h"
+#include "Grippables/GrippablePhysicsReplication.h"
 #include "VRPlayerController.generated.h"
 
 // A base player controller specifically for handling OnCameraManagerCreated.
@@ -29,6 +30,35 @@ public:
 		}
 	}
 
+	virtual void Tick(float DeltaSeconds) override;
+
+	// Client auth movement batching, all of the client auth physics objects owned by this connection
+	// send their movements together in a single RPC per send window instead of one RPC each.
+
+	// Queues a client auth movement for the owning player controller of MovingActor to send
+	// Returns false if batching isn't available (disabled or not owned by one of our controllers) and it should be sent directly
+	static bool QueueClientAuthMovement(AActor* MovingActor, const FRepMovementVR& NewMovement, uint16 Sequence);
+
+	// Removes a movement for MovingActor that is still waiting to be sent, returns true and fills OutMovement if there was one
+	// Used when ending client auth so that the final movement can be sent on the actors own channel ahead of the end RPC
+	static bool RemoveQueuedClientAuthMovement(AActor* MovingActor, FRepMovementVR& OutMovement);
+
+	// Sends all of the queued client auth movements
+	void FlushClientAuthMovements();
+
+	UFUNCTION(Unreliable, Server, WithValidation)
+		void Server_ReceiveClientAuthMovements(const TArray<FVRClientAuthMovementBatchEntry>& Movements);
+
+protected:
+
+	// Latest queued movement per actor, a newer one replaces one that hasn't been sent yet
+	TMap<TWeakObjectPtr<AActor>, FVRClientAuthMovementBatchEntry> PendingClientAuthMovements;
+
+	// Reused between sends
+	TArray<FVRClientAuthMovementBatchEntry> ClientAuthMovementSendBuffer;
+
+	float TimeSinceClientAuthMovementSend = 0.0f;
+
 };
 
 